@@ -17,10 +17,12 @@ CPP_SRCS += \
 ../src/expressions/logic_expression.cpp \
 ../src/expressions/open_expression.cpp \
 ../src/expressions/put_byte_expression.cpp \
+../src/expressions/read_bytes_expression.cpp \
 ../src/expressions/unary_expression.cpp \
 ../src/expressions/using_expression.cpp \
 ../src/expressions/variable_expression.cpp \
-../src/expressions/with_expression.cpp 
+../src/expressions/with_expression.cpp \
+../src/expressions/write_bytes_expression.cpp 
 
 OBJS += \
 ./src/expressions/arithmetic_expression.o \
@@ -36,10 +38,12 @@ OBJS += \
 ./src/expressions/logic_expression.o \
 ./src/expressions/open_expression.o \
 ./src/expressions/put_byte_expression.o \
+./src/expressions/read_bytes_expression.o \
 ./src/expressions/unary_expression.o \
 ./src/expressions/using_expression.o \
 ./src/expressions/variable_expression.o \
-./src/expressions/with_expression.o 
+./src/expressions/with_expression.o \
+./src/expressions/write_bytes_expression.o 
 
 CPP_DEPS += \
 ./src/expressions/arithmetic_expression.d \
@@ -55,10 +59,12 @@ CPP_DEPS += \
 ./src/expressions/logic_expression.d \
 ./src/expressions/open_expression.d \
 ./src/expressions/put_byte_expression.d \
+./src/expressions/read_bytes_expression.d \
 ./src/expressions/unary_expression.d \
 ./src/expressions/using_expression.d \
 ./src/expressions/variable_expression.d \
-./src/expressions/with_expression.d 
+./src/expressions/with_expression.d \
+./src/expressions/write_bytes_expression.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -6,19 +6,31 @@
 CPP_SRCS += \
 ../src/array.cpp \
 ../src/assert.cpp \
+../src/bindings.cpp \
 ../src/builtins.cpp \
+../src/bytecode_compiler.cpp \
+../src/call_stack.cpp \
 ../src/defaults.cpp \
 ../src/driver.cpp \
+../src/effect_analysis.cpp \
 ../src/error.cpp \
 ../src/execution_context.cpp \
 ../src/execution_context_list.cpp \
 ../src/function.cpp \
 ../src/function_variant.cpp \
 ../src/indent.cpp \
+../src/import_cache.cpp \
+../src/interpreter.cpp \
+../src/mapped_file.cpp \
 ../src/match.cpp \
 ../src/member_instantiation.cpp \
 ../src/newt.cpp \
+../src/optimizer.cpp \
+../src/parallel.cpp \
+../src/profiler.cpp \
+../src/program.cpp \
 ../src/record.cpp \
+../src/run_statistics.cpp \
 ../src/sum.cpp \
 ../src/symbol.cpp \
 ../src/symbol_context.cpp \
@@ -27,24 +39,37 @@ CPP_SRCS += \
 ../src/type_table.cpp \
 ../src/unit.cpp \
 ../src/utils.cpp \
-../src/version.cpp 
+../src/version.cpp \
+../src/virtual_machine.cpp 
 
 OBJS += \
 ./src/array.o \
 ./src/assert.o \
+./src/bindings.o \
 ./src/builtins.o \
+./src/bytecode_compiler.o \
+./src/call_stack.o \
 ./src/defaults.o \
 ./src/driver.o \
+./src/effect_analysis.o \
 ./src/error.o \
 ./src/execution_context.o \
 ./src/execution_context_list.o \
 ./src/function.o \
 ./src/function_variant.o \
 ./src/indent.o \
+./src/import_cache.o \
+./src/interpreter.o \
+./src/mapped_file.o \
 ./src/match.o \
 ./src/member_instantiation.o \
 ./src/newt.o \
+./src/optimizer.o \
+./src/parallel.o \
+./src/profiler.o \
+./src/program.o \
 ./src/record.o \
+./src/run_statistics.o \
 ./src/sum.o \
 ./src/symbol.o \
 ./src/symbol_context.o \
@@ -53,24 +78,37 @@ OBJS += \
 ./src/type_table.o \
 ./src/unit.o \
 ./src/utils.o \
-./src/version.o 
+./src/version.o \
+./src/virtual_machine.o 
 
 CPP_DEPS += \
 ./src/array.d \
 ./src/assert.d \
+./src/bindings.d \
 ./src/builtins.d \
+./src/bytecode_compiler.d \
+./src/call_stack.d \
 ./src/defaults.d \
 ./src/driver.d \
+./src/effect_analysis.d \
 ./src/error.d \
 ./src/execution_context.d \
 ./src/execution_context_list.d \
 ./src/function.d \
 ./src/function_variant.d \
 ./src/indent.d \
+./src/import_cache.d \
+./src/interpreter.d \
+./src/mapped_file.d \
 ./src/match.d \
 ./src/member_instantiation.d \
 ./src/newt.d \
+./src/optimizer.d \
+./src/parallel.d \
+./src/profiler.d \
+./src/program.d \
 ./src/record.d \
+./src/run_statistics.d \
 ./src/sum.d \
 ./src/symbol.d \
 ./src/symbol_context.d \
@@ -79,7 +117,8 @@ CPP_DEPS += \
 ./src/type_table.d \
 ./src/unit.d \
 ./src/utils.d \
-./src/version.d 
+./src/version.d \
+./src/virtual_machine.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -0,0 +1,69 @@
+#!/bin/sh
+# Run each benchmark workload several times and report wall time, peak
+# memory use and allocation counts, as reported by newt --stats.
+#
+# usage: run.sh <newt> <runs> <json output> [workload ...]
+#
+# Wall times are summarized as median and 95th percentile; peak RSS and
+# allocation counts are medians. Results are printed as a table and written
+# to the JSON output file so they can be compared between builds.
+
+NEWT=$1
+RUNS=$2
+OUTPUT=$3
+shift 3
+
+BENCH_PATH=$(dirname "$0")
+if [ $# -eq 0 ]; then
+	set -- "$BENCH_PATH"/*.nwt
+fi
+
+mkdir -p "$BENCH_PATH/output"
+SAMPLES="$BENCH_PATH/output/samples"
+
+# print the nearest-rank percentile of the numbers on stdin
+percentile() {
+	sort -n | awk -v p="$1" '{ v[NR] = $1 } END {
+		i = int((p * NR + 99) / 100); if (i < 1) i = 1; print v[i] }'
+}
+
+printf '%-16s %12s %12s %12s %12s\n' workload median_ms p95_ms max_rss_kb \
+	allocations
+printf '{\n  "runs": %s,\n  "benchmarks": [' "$RUNS" >"$OUTPUT"
+
+status=0
+separator=''
+for workload in "$@"; do
+	name=$(basename "$workload" .nwt)
+	: >"$SAMPLES"
+	run=0
+	while [ $run -lt "$RUNS" ]; do
+		stats=$("$NEWT" --stats --include-paths ../tests/includes "$workload" \
+			2>&1 >/dev/null | sed -n 's/^stats: //p')
+		if [ -z "$stats" ]; then
+			echo "$name: run failed" >&2
+			status=1
+			break
+		fi
+		echo "$stats" | sed 's/[a-z_]*=//g' >>"$SAMPLES"
+		run=$((run + 1))
+	done
+	if [ $run -lt "$RUNS" ]; then
+		continue
+	fi
+
+	median=$(cut -d' ' -f1 "$SAMPLES" | percentile 50)
+	p95=$(cut -d' ' -f1 "$SAMPLES" | percentile 95)
+	rss=$(cut -d' ' -f2 "$SAMPLES" | percentile 50)
+	allocations=$(cut -d' ' -f3 "$SAMPLES" | percentile 50)
+
+	printf '%-16s %12s %12s %12s %12s\n' "$name" "$median" "$p95" "$rss" \
+		"$allocations"
+	printf '%s\n    { "name": "%s", "wall_ms": { "median": %s, "p95": %s }, "max_rss_kb": %s, "allocations": %s }' \
+		"$separator" "$name" "$median" "$p95" "$rss" "$allocations" >>"$OUTPUT"
+	separator=','
+done
+
+printf '\n  ]\n}\n' >>"$OUTPUT"
+rm -f "$SAMPLES"
+exit $status
@@ -49,12 +49,64 @@ const string Array::ToString(const TypeTable& type_table,
 	return os.str();
 }
 
-const shared_ptr<const vector<shared_ptr<const void>>> Array::GetStorage(
+const Array::storage Array::GrowStorage(const int size,
+		const TypeTable& type_table) const {
+	auto element_type_specifier = GetElementTypeSpecifier();
+	auto count = size - GetSize();
+
+	auto element_type_result = element_type_specifier->GetType(type_table,
+			RESOLVE);
+	if (ErrorList::IsTerminator(element_type_result->GetErrors())) {
+		auto as_record = dynamic_pointer_cast<const RecordType>(
+				element_type_result->GetData<TypeDefinition>());
+		if (as_record
+				&& (as_record->GetModifiers() & Modifier::MUTABLE)
+						== Modifier::MUTABLE) {
+			// mutable records are modified in-place, so each element needs its own instance
+			auto result = GetElements();
+			for (int i = 0; i < count; i++) {
+				result = result.WithAppended(
+						Value(element_type_specifier->DefaultValue(type_table)));
+			}
+			return result;
+		}
+	}
+
+	//fill with default values
+	return GetElements().WithAppended(count,
+			ToElement(element_type_specifier->DefaultValue(type_table)));
+}
+
+const Array::storage Array::GetElements() const {
+	if (!m_mapping) {
+		return m_value;
+	}
+
+	vector<Value> elements;
+	elements.reserve(m_mapping_size);
+	auto data = m_mapping->GetData() + m_mapping_offset;
+	for (size_t i = 0; i < m_mapping_size; i++) {
+		elements.push_back(Value(data[i]));
+	}
+
+	return storage().WithAppended(elements.begin(), elements.end());
+}
+
+const Array::storage Array::GetStorage(
 		const_shared_ptr<TypeSpecifier> element_specifier,
 		const int initial_size, const TypeTable& type_table) {
-	auto storage = new vector<shared_ptr<const void>>(initial_size, element_specifier->DefaultValue(
-					type_table));
-	auto result = const_shared_ptr<const vector<shared_ptr<const void>>>(storage);
-	return result;
+	return storage(initial_size,
+			ToElement(element_specifier,
+					element_specifier->DefaultValue(type_table)));
 }
 
+const Value Array::ToElement(const_shared_ptr<TypeSpecifier> element_specifier,
+		const_shared_ptr<void> value) {
+	auto as_primitive = dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+			element_specifier);
+	if (as_primitive) {
+		return Value::FromPointer(value, as_primitive->GetBasicType());
+	}
+
+	return Value(value);
+}
@@ -22,6 +22,7 @@
 
 #include <vector>
 #include <sstream>
+#include <persistent_vector.h>
 #include <type.h>
 #include <type_table.h>
 #include <error.h>
@@ -31,6 +32,8 @@
 #include <specifiers/record_type_specifier.h>
 #include <specifiers/type_specifier.h>
 #include <symbol.h>
+#include <value.h>
+#include <mapped_file.h>
 
 class Array {
 public:
@@ -45,42 +48,72 @@ public:
 
 	template<class T> const std::shared_ptr<const T> GetValue(const int index,
 			const TypeTable& type_table) const {
+		return static_pointer_cast<const T>(
+				GetTaggedValue(index, type_table).ToPointer());
+	}
+
+	/**
+	 * Get the value at the given index without boxing it.
+	 */
+	const Value GetTaggedValue(const int index,
+			const TypeTable& type_table) const {
 		if (0 <= index && index < GetSize()) {
-			const shared_ptr<const T> result = static_pointer_cast<const T>(
-					m_value->at(index));
-			return result;
+			if (m_mapping) {
+				return Value(m_mapping->GetData()[m_mapping_offset + index]);
+			}
+			return m_value.At(index);
 		} else {
-			return static_pointer_cast<const T>(
-					GetElementTypeSpecifier()->DefaultValue(type_table));
+			return Value(GetElementTypeSpecifier()->DefaultValue(type_table));
 		}
 	}
 
 	template<class T> const_shared_ptr<Array> WithValue(const int index,
 			shared_ptr<const T> value, const TypeTable& type_table) const {
-		auto new_vector = new vector<shared_ptr<const void>>(*m_value);
+		return WithValue(index, ToElement(value), type_table);
+	}
 
+	const_shared_ptr<Array> WithValue(const int index, const Value& value,
+			const TypeTable& type_table) const {
 		if (index < GetSize()) {
-			new_vector->at(index) = value;
+			return make_shared<Array>(
+					Array(GetElementTypeSpecifier(),
+							GetElements().WithValue(index, value)));
 		} else {
-			size_t old_size = new_vector->size();
-			new_vector->resize(index);
-
-			//fill with default values
-			for (size_t i = old_size; i < new_vector->size(); i++) {
-				const_shared_ptr<void> default_value =
-						GetElementTypeSpecifier()->DefaultValue(type_table);
-				new_vector->at(i) = default_value;
-			}
-
-			new_vector->insert(new_vector->end(), value);
+			auto new_value = GrowStorage(index, type_table).WithAppended(
+					value);
+			return make_shared<Array>(
+					Array(GetElementTypeSpecifier(), new_value));
 		}
+	}
+
+	/**
+	 * Append the element values in [first, last), which must already be in
+	 * stored form (see ToElement).
+	 */
+	template<class InputIterator> const_shared_ptr<Array> WithAppended(
+			InputIterator first, const InputIterator last) const {
+		return make_shared<Array>(
+				Array(GetElementTypeSpecifier(),
+						GetElements().WithAppended(first, last)));
+	}
 
-		const shared_ptr<const vector<shared_ptr<const void>>> wrapper = shared_ptr<const vector<shared_ptr<const void>>>(new_vector);
-		return make_shared<Array>(Array(GetElementTypeSpecifier(), wrapper));
+	/**
+	 * Get a byte array that views part of a mapped file without copying it.
+	 * The array keeps the mapping alive; writing to it copies the viewed bytes
+	 * into ordinary storage first.
+	 */
+	static const_shared_ptr<Array> FromMapping(
+			const_shared_ptr<MappedFile> mapping, const size_t offset,
+			const size_t size) {
+		return make_shared<Array>(Array(mapping, offset, size));
 	}
 
 	const int GetSize() const {
-		int size = m_value->size();
+		if (m_mapping) {
+			return m_mapping_size;
+		}
+
+		int size = m_value.GetSize();
 		return size;
 	}
 
@@ -93,20 +126,60 @@ public:
 	}
 
 private:
+	typedef PersistentVector<Value> storage;
+
 	Array(const_shared_ptr<TypeSpecifier> element_specifier,
-			const shared_ptr<const vector<shared_ptr<const void>>> value) :
+			const storage value) :
 			m_type_specifier(
-			const_shared_ptr<ArrayTypeSpecifier>(
-					new ArrayTypeSpecifier(element_specifier))), m_value(
-			value) {
-			}
+					const_shared_ptr<ArrayTypeSpecifier>(
+							new ArrayTypeSpecifier(element_specifier))), m_value(
+					value), m_mapping(nullptr), m_mapping_offset(0), m_mapping_size(
+					0) {
+	}
+
+	Array(const_shared_ptr<MappedFile> mapping, const size_t offset,
+			const size_t size) :
+			m_type_specifier(
+					const_shared_ptr<ArrayTypeSpecifier>(
+							new ArrayTypeSpecifier(
+									PrimitiveTypeSpecifier::GetByte()))), m_value(), m_mapping(
+					mapping), m_mapping_offset(offset), m_mapping_size(size) {
+	}
 
-			static const shared_ptr<const vector<shared_ptr<const void>>> GetStorage(
+	/**
+	 * Get this array's elements as storage, copying them out of the mapping
+	 * if the array is a mapped view.
+	 */
+	const storage GetElements() const;
+
+	/**
+	 * Convert an element value to its stored form. Elements of primitive type
+	 * are stored inline.
+	 */
+	const Value ToElement(const_shared_ptr<void> value) const {
+		return ToElement(GetElementTypeSpecifier(), value);
+	}
+
+	static const Value ToElement(
+			const_shared_ptr<TypeSpecifier> element_specifier,
+			const_shared_ptr<void> value);
+
+	/**
+	 * Get a copy of this array's storage, padded with default values up to the specified size.
+	 */
+	const storage GrowStorage(const int size,
+			const TypeTable& type_table) const;
+
+	static const storage GetStorage(
 			const_shared_ptr<TypeSpecifier> element_specifier,
 			const int initial_size, const TypeTable& type_table);
 
-			const_shared_ptr<ArrayTypeSpecifier> m_type_specifier;
-			const shared_ptr<const vector<shared_ptr<const void>>> m_value;
-		};
+	const_shared_ptr<ArrayTypeSpecifier> m_type_specifier;
+	const storage m_value;
+
+	const_shared_ptr<MappedFile> m_mapping;
+	const size_t m_mapping_offset;
+	const size_t m_mapping_size;
+};
 
 #endif /* ARRAY_H_ */
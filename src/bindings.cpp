@@ -0,0 +1,42 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bindings.h>
+#include <symbol.h>
+
+void Bindings::Set(const string& name, const bool value) {
+	m_values[name] = make_shared<Symbol>(make_shared<bool>(value));
+}
+
+void Bindings::Set(const string& name, const int value) {
+	m_values[name] = make_shared<Symbol>(make_shared<int>(value));
+}
+
+void Bindings::Set(const string& name, const double value) {
+	m_values[name] = make_shared<Symbol>(make_shared<double>(value));
+}
+
+void Bindings::Set(const string& name, const string& value) {
+	m_values[name] = make_shared<Symbol>(make_shared<string>(value));
+}
+
+void Bindings::Set(const string& name, const char* value) {
+	// without this overload, a string literal would be bound as a bool
+	Set(name, string(value));
+}
@@ -0,0 +1,57 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_H_
+#define BINDINGS_H_
+
+#include <map>
+#include <string>
+#include <defaults.h>
+
+class Symbol;
+
+using namespace std;
+
+/**
+ * Values for the inputs of an embedded program.
+ *
+ * Inputs are top-level variables provided by the host rather than declared by
+ * the script. The bindings given when a program is compiled declare them, with
+ * the types of the values given; the bindings given when it is executed
+ * assign them new values of the same types.
+ */
+class Bindings {
+public:
+	typedef map<string, plain_shared_ptr<Symbol>> binding_map;
+
+	void Set(const string& name, const bool value);
+	void Set(const string& name, const int value);
+	void Set(const string& name, const double value);
+	void Set(const string& name, const string& value);
+	void Set(const string& name, const char* value);
+
+	const binding_map& GetValues() const {
+		return m_values;
+	}
+
+private:
+	binding_map m_values;
+};
+
+#endif /* BINDINGS_H_ */
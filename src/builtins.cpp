@@ -23,15 +23,26 @@
 #include <unit_type.h>
 #include <type_alias_declaration_statement.h>
 #include <maybe_type_specifier.h>
+#include <array_type_specifier.h>
+#include <primitive_type_specifier.h>
+#include <record_type_specifier.h>
+#include <sum_type_specifier.h>
+#include <constant_expression.h>
+#include <statement_block.h>
+#include <primitive_declaration_statement.h>
+#include <complex_instantiation_statement.h>
+#include <maybe_declaration_statement.h>
+#include <record_declaration_statement.h>
+#include <sum_declaration_statement.h>
+#include <unit_declaration_statement.h>
+#include <utils.h>
+#include <sum.h>
 
-const_shared_ptr<std::string> Builtins::ERROR_TYPE_NAME = make_shared<
-		std::string>("error");
+const_shared_ptr<std::string> Builtins::ERROR_TYPE_NAME = Intern("error");
 
-const_shared_ptr<std::string> Builtins::ERROR_CODE_NAME = make_shared<
-		std::string>("id");
+const_shared_ptr<std::string> Builtins::ERROR_CODE_NAME = Intern("id");
 
-const_shared_ptr<std::string> Builtins::ERROR_MESSAGE_NAME = make_shared<
-		std::string>("message");
+const_shared_ptr<std::string> Builtins::ERROR_MESSAGE_NAME = Intern("message");
 
 const_shared_ptr<ComplexTypeSpecifier> Builtins::get_error_type_specifier() {
 	static const_shared_ptr<ComplexTypeSpecifier> instance = make_shared<
@@ -45,14 +56,12 @@ const_shared_ptr<MaybeTypeSpecifier> Builtins::get_error_maybe_type_specifier()
 			GetDefaultLocation());
 	return instance;
 }
-const_shared_ptr<std::string> Builtins::ERROR_LIST_TYPE_NAME = make_shared<
-		std::string>("error_list");
+const_shared_ptr<std::string> Builtins::ERROR_LIST_TYPE_NAME =
+		Intern("error_list");
 
-const_shared_ptr<std::string> Builtins::ERROR_LIST_DATA_NAME = make_shared<
-		std::string>("data");
+const_shared_ptr<std::string> Builtins::ERROR_LIST_DATA_NAME = Intern("data");
 
-const_shared_ptr<std::string> Builtins::ERROR_LIST_NEXT_NAME = make_shared<
-		std::string>("next");
+const_shared_ptr<std::string> Builtins::ERROR_LIST_NEXT_NAME = Intern("next");
 
 const_shared_ptr<ComplexTypeSpecifier> Builtins::get_error_list_type_specifier() {
 	static const_shared_ptr<ComplexTypeSpecifier> instance = make_shared<
@@ -67,46 +76,45 @@ const_shared_ptr<MaybeTypeSpecifier> Builtins::get_error_list_maybe_type_specifi
 	return instance;
 }
 
-const_shared_ptr<std::string> Builtins::STREAM_MODE_TYPE_NAME = make_shared<
-		std::string>("stream_mode");
-const_shared_ptr<std::string> Builtins::STREAM_MODE_IN_NAME = make_shared<
-		std::string>("read");
-const_shared_ptr<std::string> Builtins::STREAM_MODE_OUT_NAME = make_shared<
-		std::string>("write");
-const_shared_ptr<std::string> Builtins::STREAM_MODE_BINARY_NAME = make_shared<
-		std::string>("binary");
-const_shared_ptr<std::string> Builtins::STREAM_MODE_ATE_NAME = make_shared<
-		std::string>("ate");
-const_shared_ptr<std::string> Builtins::STREAM_MODE_APP_NAME = make_shared<
-		std::string>("app");
-const_shared_ptr<std::string> Builtins::STREAM_MODE_TRUNC_NAME = make_shared<
-		std::string>("trunc");
+const_shared_ptr<std::string> Builtins::STREAM_MODE_TYPE_NAME =
+		Intern("stream_mode");
+const_shared_ptr<std::string> Builtins::STREAM_MODE_IN_NAME = Intern("read");
+const_shared_ptr<std::string> Builtins::STREAM_MODE_OUT_NAME = Intern("write");
+const_shared_ptr<std::string> Builtins::STREAM_MODE_BINARY_NAME =
+		Intern("binary");
+const_shared_ptr<std::string> Builtins::STREAM_MODE_ATE_NAME = Intern("ate");
+const_shared_ptr<std::string> Builtins::STREAM_MODE_APP_NAME = Intern("app");
+const_shared_ptr<std::string> Builtins::STREAM_MODE_TRUNC_NAME =
+		Intern("trunc");
+const_shared_ptr<std::string> Builtins::STREAM_MODE_MAP_NAME = Intern("map");
 const_shared_ptr<ComplexTypeSpecifier> Builtins::get_stream_mode_type_specifier() {
 	static const_shared_ptr<ComplexTypeSpecifier> instance = make_shared<
 			ComplexTypeSpecifier>(Builtins::STREAM_MODE_TYPE_NAME);
 	return instance;
 }
 
-const_shared_ptr<std::string> Builtins::BYTE_RESULT_TYPE_NAME = make_shared<
-		std::string>("byte_result");
+const_shared_ptr<std::string> Builtins::BYTE_RESULT_TYPE_NAME =
+		Intern("byte_result");
 
-const_shared_ptr<std::string> Builtins::BYTE_RESULT_DATA_NAME = make_shared<
-		std::string>("data");
+const_shared_ptr<std::string> Builtins::BYTE_RESULT_DATA_NAME = Intern("data");
 
-const_shared_ptr<std::string> Builtins::BYTE_RESULT_ERRORS_NAME = make_shared<
-		std::string>("errors");
+const_shared_ptr<std::string> Builtins::BYTE_RESULT_ERRORS_NAME =
+		Intern("errors");
 const_shared_ptr<ComplexTypeSpecifier> Builtins::get_byte_result_type_specifier() {
 	static const_shared_ptr<ComplexTypeSpecifier> instance = make_shared<
 			ComplexTypeSpecifier>(Builtins::BYTE_RESULT_TYPE_NAME);
 	return instance;
 }
 
-const_shared_ptr<std::string> Builtins::INT_RESULT_TYPE_NAME = make_shared<
-		std::string>("int_result");
-const_shared_ptr<std::string> Builtins::INT_RESULT_DATA_NAME = make_shared<
-		std::string>("data");
-const_shared_ptr<std::string> Builtins::INT_RESULT_ERRORS_NAME = make_shared<
-		std::string>("errors");
+const_shared_ptr<std::string> Builtins::INT_RESULT_TYPE_NAME =
+		Intern("int_result");
+const_shared_ptr<std::string> Builtins::INT_RESULT_DATA_NAME = Intern("data");
+const_shared_ptr<std::string> Builtins::INT_RESULT_ERRORS_NAME =
+		Intern("errors");
+const size_t Builtins::INT_RESULT_DATA_TAG_ID = Sum::InternTag(
+		*INT_RESULT_DATA_NAME);
+const size_t Builtins::INT_RESULT_ERRORS_TAG_ID = Sum::InternTag(
+		*INT_RESULT_ERRORS_NAME);
 const_shared_ptr<ComplexTypeSpecifier> Builtins::get_int_result_type_specifier() {
 	static const_shared_ptr<ComplexTypeSpecifier> instance = make_shared<
 			ComplexTypeSpecifier>(Builtins::INT_RESULT_TYPE_NAME);
@@ -114,13 +122,19 @@ const_shared_ptr<ComplexTypeSpecifier> Builtins::get_int_result_type_specifier()
 }
 
 const_shared_ptr<std::string> Builtins::BYTE_READ_RESULT_TYPE_NAME =
-		make_shared<std::string>("byte_read_result");
+		Intern("byte_read_result");
 const_shared_ptr<std::string> Builtins::BYTE_READ_RESULT_DATA_NAME =
-		make_shared<std::string>("data");
-const_shared_ptr<std::string> Builtins::BYTE_READ_RESULT_EOF_NAME = make_shared<
-		std::string>("eof");
+		Intern("data");
+const_shared_ptr<std::string> Builtins::BYTE_READ_RESULT_EOF_NAME =
+		Intern("eof");
 const_shared_ptr<std::string> Builtins::BYTE_READ_RESULT_ERRORS_NAME =
-		make_shared<std::string>("errors");
+		Intern("errors");
+const size_t Builtins::BYTE_READ_RESULT_DATA_TAG_ID = Sum::InternTag(
+		*BYTE_READ_RESULT_DATA_NAME);
+const size_t Builtins::BYTE_READ_RESULT_EOF_TAG_ID = Sum::InternTag(
+		*BYTE_READ_RESULT_EOF_NAME);
+const size_t Builtins::BYTE_READ_RESULT_ERRORS_TAG_ID = Sum::InternTag(
+		*BYTE_READ_RESULT_ERRORS_NAME);
 const_shared_ptr<ComplexTypeSpecifier> Builtins::get_byte_read_result_type_specifier() {
 	static const_shared_ptr<ComplexTypeSpecifier> instance = make_shared<
 			ComplexTypeSpecifier>(Builtins::BYTE_READ_RESULT_TYPE_NAME);
@@ -134,48 +148,173 @@ const_shared_ptr<ComplexTypeSpecifier> Builtins::get_byte_read_result_eof_type_s
 	return instance;
 }
 
+const_shared_ptr<std::string> Builtins::BYTES_READ_RESULT_TYPE_NAME =
+		Intern("bytes_read_result");
+const_shared_ptr<std::string> Builtins::BYTES_READ_RESULT_DATA_NAME =
+		Intern("data");
+const_shared_ptr<std::string> Builtins::BYTES_READ_RESULT_EOF_NAME =
+		Intern("eof");
+const_shared_ptr<std::string> Builtins::BYTES_READ_RESULT_ERRORS_NAME =
+		Intern("errors");
+const size_t Builtins::BYTES_READ_RESULT_DATA_TAG_ID = Sum::InternTag(
+		*BYTES_READ_RESULT_DATA_NAME);
+const size_t Builtins::BYTES_READ_RESULT_EOF_TAG_ID = Sum::InternTag(
+		*BYTES_READ_RESULT_EOF_NAME);
+const size_t Builtins::BYTES_READ_RESULT_ERRORS_TAG_ID = Sum::InternTag(
+		*BYTES_READ_RESULT_ERRORS_NAME);
+const_shared_ptr<ComplexTypeSpecifier> Builtins::get_bytes_read_result_type_specifier() {
+	static const_shared_ptr<ComplexTypeSpecifier> instance = make_shared<
+			ComplexTypeSpecifier>(Builtins::BYTES_READ_RESULT_TYPE_NAME);
+	return instance;
+}
+const_shared_ptr<ComplexTypeSpecifier> Builtins::get_bytes_read_result_eof_type_specifier() {
+	static const_shared_ptr<ComplexTypeSpecifier> instance = make_shared<
+			ComplexTypeSpecifier>(Builtins::BYTES_READ_RESULT_EOF_NAME,
+			get_bytes_read_result_type_specifier(),
+			NamespaceQualifierList::GetTerminator());
+	return instance;
+}
+
 volatile_shared_ptr<file_handle_map> Builtins::get_file_handle_map() {
 	static volatile_shared_ptr<file_handle_map> instance = make_shared<
 			file_handle_map>();
 	return instance;
 }
 
-const_shared_ptr<string> Builtins::get_builtin_definition() {
-	ostringstream ss;
-	ss << *Builtins::LANGUAGE_VERSION_NAME << ":string = \""
-			<< *LANGUAGE_VERSION_STRING << "\"" << endl;
-	ss << *Builtins::ERROR_TYPE_NAME << " { " << *Builtins::ERROR_CODE_NAME
-			<< ":int, " << *Builtins::ERROR_MESSAGE_NAME << ":string }" << endl;
-	ss << *Builtins::ERROR_LIST_TYPE_NAME << " { "
-			<< *Builtins::ERROR_LIST_NEXT_NAME << ":"
-			<< *Builtins::ERROR_LIST_TYPE_NAME << "?, "
-			<< *Builtins::ERROR_LIST_DATA_NAME << ":"
-			<< *Builtins::ERROR_TYPE_NAME << " }" << endl;
-	ss << *Builtins::STREAM_MODE_TYPE_NAME << " { "
-			<< *Builtins::STREAM_MODE_IN_NAME << ":bool, "
-			<< *Builtins::STREAM_MODE_OUT_NAME << ":bool, "
-			<< *Builtins::STREAM_MODE_BINARY_NAME << ":bool, "
-			<< *Builtins::STREAM_MODE_ATE_NAME << ":bool, "
-			<< *Builtins::STREAM_MODE_APP_NAME << ":bool, "
-			<< *Builtins::STREAM_MODE_TRUNC_NAME << ":bool }" << endl;
-	ss << *Builtins::BYTE_RESULT_TYPE_NAME << " { "
-			<< *Builtins::BYTE_RESULT_DATA_NAME << ":byte | "
-			<< *Builtins::BYTE_RESULT_ERRORS_NAME << ":"
-			<< *Builtins::ERROR_LIST_TYPE_NAME << " }" << endl;
-	ss << *Builtins::BYTE_READ_RESULT_TYPE_NAME << "{ "
-			<< *Builtins::BYTE_READ_RESULT_EOF_NAME << " | "
-			<< *Builtins::BYTE_READ_RESULT_DATA_NAME << ":byte |"
-			<< *Builtins::BYTE_READ_RESULT_ERRORS_NAME << ":"
-			<< *Builtins::ERROR_LIST_TYPE_NAME << " }" << endl;
-	ss << *Builtins::INT_RESULT_TYPE_NAME << " { "
-			<< *Builtins::INT_RESULT_DATA_NAME << ":int | "
-			<< *Builtins::INT_RESULT_ERRORS_NAME << ":"
-			<< *Builtins::ERROR_LIST_TYPE_NAME << " }" << endl;
-	ss << *Builtins::PATH_SEPARATOR_NAME << ":string = \""
-			<< get_path_separator() << "\"" << endl;
-
-	auto result = make_shared<string>(ss.str());
-	return result;
+volatile_shared_ptr<mapped_file_map> Builtins::get_mapped_file_map() {
+	static volatile_shared_ptr<mapped_file_map> instance = make_shared<
+			mapped_file_map>();
+	return instance;
+}
+
+const int Builtins::get_free_file_handle() {
+	auto streams = get_file_handle_map();
+	auto mapped_files = get_mapped_file_map();
+	int handle = 0;
+	while (streams->find(handle) != streams->end()
+			|| mapped_files->find(handle) != mapped_files->end()) {
+		handle++;
+	}
+	return handle;
+}
+
+const_shared_ptr<StatementBlock> Builtins::get_builtin_statement_block() {
+	auto location = GetDefaultLocation();
+
+	// declaration lists are built back to front
+	auto error_members = DeclarationList::From(
+			make_shared<PrimitiveDeclarationStatement>(location,
+					PrimitiveTypeSpecifier::GetString(), location,
+					ERROR_MESSAGE_NAME, location),
+			DeclarationList::GetTerminator());
+	error_members = DeclarationList::From(
+			make_shared<PrimitiveDeclarationStatement>(location,
+					PrimitiveTypeSpecifier::GetInt(), location,
+					ERROR_CODE_NAME, location), error_members);
+
+	auto error_list_members = DeclarationList::From(
+			make_shared<ComplexInstantiationStatement>(location,
+					get_error_type_specifier(), location, ERROR_LIST_DATA_NAME,
+					location), DeclarationList::GetTerminator());
+	error_list_members = DeclarationList::From(
+			make_shared<MaybeDeclarationStatement>(location,
+					get_error_list_maybe_type_specifier(), location,
+					ERROR_LIST_NEXT_NAME, location), error_list_members);
+
+	const_shared_ptr<string> stream_mode_names[] = { STREAM_MODE_MAP_NAME,
+			STREAM_MODE_TRUNC_NAME, STREAM_MODE_APP_NAME, STREAM_MODE_ATE_NAME,
+			STREAM_MODE_BINARY_NAME, STREAM_MODE_OUT_NAME, STREAM_MODE_IN_NAME };
+	auto stream_mode_members = DeclarationList::GetTerminator();
+	for (auto & name : stream_mode_names) {
+		stream_mode_members = DeclarationList::From(
+				make_shared<PrimitiveDeclarationStatement>(location,
+						PrimitiveTypeSpecifier::GetBoolean(), location, name,
+						location), stream_mode_members);
+	}
+
+	const_shared_ptr<Statement> statements[] =
+			{
+					make_shared<PrimitiveDeclarationStatement>(location,
+							PrimitiveTypeSpecifier::GetString(), location,
+							LANGUAGE_VERSION_NAME, location,
+							make_shared<ConstantExpression>(location,
+									LANGUAGE_VERSION_STRING)),
+					make_shared<RecordDeclarationStatement>(location,
+							make_shared<RecordTypeSpecifier>(ERROR_TYPE_NAME,
+									location), ERROR_TYPE_NAME, location,
+							error_members, location,
+							ModifierList::GetTerminator(), location),
+					make_shared<RecordDeclarationStatement>(location,
+							make_shared<RecordTypeSpecifier>(
+									ERROR_LIST_TYPE_NAME, location),
+							ERROR_LIST_TYPE_NAME, location, error_list_members,
+							location, ModifierList::GetTerminator(), location),
+					make_shared<RecordDeclarationStatement>(location,
+							make_shared<RecordTypeSpecifier>(
+									STREAM_MODE_TYPE_NAME, location),
+							STREAM_MODE_TYPE_NAME, location,
+							stream_mode_members, location,
+							ModifierList::GetTerminator(), location),
+					get_result_declaration(BYTE_RESULT_TYPE_NAME,
+							BYTE_RESULT_DATA_NAME,
+							PrimitiveTypeSpecifier::GetByte(),
+							BYTE_RESULT_ERRORS_NAME),
+					get_result_declaration(BYTE_READ_RESULT_TYPE_NAME,
+							BYTE_READ_RESULT_DATA_NAME,
+							PrimitiveTypeSpecifier::GetByte(),
+							BYTE_READ_RESULT_ERRORS_NAME,
+							BYTE_READ_RESULT_EOF_NAME),
+					get_result_declaration(BYTES_READ_RESULT_TYPE_NAME,
+							BYTES_READ_RESULT_DATA_NAME,
+							make_shared<ArrayTypeSpecifier>(
+									PrimitiveTypeSpecifier::GetByte()),
+							BYTES_READ_RESULT_ERRORS_NAME,
+							BYTES_READ_RESULT_EOF_NAME),
+					get_result_declaration(INT_RESULT_TYPE_NAME,
+							INT_RESULT_DATA_NAME,
+							PrimitiveTypeSpecifier::GetInt(),
+							INT_RESULT_ERRORS_NAME),
+					make_shared<PrimitiveDeclarationStatement>(location,
+							PrimitiveTypeSpecifier::GetString(), location,
+							PATH_SEPARATOR_NAME, location,
+							make_shared<ConstantExpression>(location,
+									make_shared<string>(1,
+											get_path_separator()))) };
+
+	auto statement_list = StatementList::GetTerminator();
+	for (auto i = std::end(statements); i != std::begin(statements);) {
+		statement_list = StatementList::From(*--i, statement_list);
+	}
+
+	return make_shared<StatementBlock>(statement_list, location);
+}
+
+const_shared_ptr<DeclarationStatement> Builtins::get_result_declaration(
+		const_shared_ptr<std::string> type_name,
+		const_shared_ptr<std::string> data_name,
+		const_shared_ptr<TypeSpecifier> data_type_specifier,
+		const_shared_ptr<std::string> errors_name,
+		const_shared_ptr<std::string> eof_name) {
+	auto location = GetDefaultLocation();
+
+	auto variants = DeclarationList::From(
+			make_shared<TypeAliasDeclarationStatement>(location,
+					get_error_list_type_specifier(), location, errors_name,
+					location), DeclarationList::GetTerminator());
+	variants = DeclarationList::From(
+			make_shared<TypeAliasDeclarationStatement>(location,
+					data_type_specifier, location, data_name, location),
+			variants);
+	if (eof_name) {
+		variants = DeclarationList::From(
+				make_shared<UnitDeclarationStatement>(location,
+						make_shared<ComplexTypeSpecifier>(eof_name), location,
+						eof_name, location), variants);
+	}
+
+	return make_shared<SumDeclarationStatement>(location,
+			make_shared<SumTypeSpecifier>(type_name), type_name, location,
+			variants, location);
 }
 
 char Builtins::get_path_separator() {
@@ -190,11 +329,11 @@ char Builtins::get_path_separator() {
 	return path_separator;
 }
 
-const_shared_ptr<std::string> Builtins::PATH_SEPARATOR_NAME = make_shared<
-		std::string>("path_separator");
+const_shared_ptr<std::string> Builtins::PATH_SEPARATOR_NAME =
+		Intern("path_separator");
 
-const_shared_ptr<std::string> Builtins::LANGUAGE_VERSION_NAME = make_shared<
-		std::string>("language_version");
+const_shared_ptr<std::string> Builtins::LANGUAGE_VERSION_NAME =
+		Intern("language_version");
 
 #ifndef LANGUAGE_VERSION
 #define LANGUAGE_VERSION none
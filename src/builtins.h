@@ -25,13 +25,26 @@
 #include "error.h"
 #include "symbol_table.h"
 #include "type_table.h"
+#include "mapped_file.h"
 
 class UnitType;
 class SumType;
 class MaybeTypeSpecifier;
+class StatementBlock;
+class DeclarationStatement;
 
 typedef map<const int, volatile_shared_ptr<fstream>> file_handle_map;
 
+/**
+ * A file opened with the stream_mode map flag: the mapping, and the offset
+ * that the next read starts from.
+ */
+struct mapped_file_handle {
+	plain_shared_ptr<MappedFile> file;
+	size_t position;
+};
+typedef map<const int, volatile_shared_ptr<mapped_file_handle>> mapped_file_map;
+
 // ref: https://stackoverflow.com/a/5256500/577298
 #define STRINGIZE_NX(A) #A
 #define STRINGIZE(A) STRINGIZE_NX(A)
@@ -39,9 +52,11 @@ typedef map<const int, volatile_shared_ptr<fstream>> file_handle_map;
 class Builtins {
 public:
 	/**
-	 * Get a string representation of builtins, such as errors
+	 * Get the declarations of builtins, such as errors. These are built
+	 * directly rather than parsed from source, so that startup does not pay
+	 * for a parse.
 	 */
-	static const_shared_ptr<string> get_builtin_definition();
+	static const_shared_ptr<StatementBlock> get_builtin_statement_block();
 
 	static const_shared_ptr<std::string> ERROR_TYPE_NAME;
 	static const_shared_ptr<std::string> ERROR_CODE_NAME;
@@ -62,6 +77,7 @@ public:
 	static const_shared_ptr<std::string> STREAM_MODE_ATE_NAME;
 	static const_shared_ptr<std::string> STREAM_MODE_APP_NAME;
 	static const_shared_ptr<std::string> STREAM_MODE_TRUNC_NAME;
+	static const_shared_ptr<std::string> STREAM_MODE_MAP_NAME;
 	static const_shared_ptr<ComplexTypeSpecifier> get_stream_mode_type_specifier();
 
 	static const_shared_ptr<std::string> BYTE_RESULT_TYPE_NAME;
@@ -72,15 +88,30 @@ public:
 	static const_shared_ptr<std::string> INT_RESULT_TYPE_NAME;
 	static const_shared_ptr<std::string> INT_RESULT_DATA_NAME;
 	static const_shared_ptr<std::string> INT_RESULT_ERRORS_NAME;
+	static const size_t INT_RESULT_DATA_TAG_ID;
+	static const size_t INT_RESULT_ERRORS_TAG_ID;
 	static const_shared_ptr<ComplexTypeSpecifier> get_int_result_type_specifier();
 
 	static const_shared_ptr<std::string> BYTE_READ_RESULT_TYPE_NAME;
 	static const_shared_ptr<std::string> BYTE_READ_RESULT_DATA_NAME;
 	static const_shared_ptr<std::string> BYTE_READ_RESULT_EOF_NAME;
 	static const_shared_ptr<std::string> BYTE_READ_RESULT_ERRORS_NAME;
+	static const size_t BYTE_READ_RESULT_DATA_TAG_ID;
+	static const size_t BYTE_READ_RESULT_EOF_TAG_ID;
+	static const size_t BYTE_READ_RESULT_ERRORS_TAG_ID;
 	static const_shared_ptr<ComplexTypeSpecifier> get_byte_read_result_type_specifier();
 	static const_shared_ptr<ComplexTypeSpecifier> get_byte_read_result_eof_type_specifier();
 
+	static const_shared_ptr<std::string> BYTES_READ_RESULT_TYPE_NAME;
+	static const_shared_ptr<std::string> BYTES_READ_RESULT_DATA_NAME;
+	static const_shared_ptr<std::string> BYTES_READ_RESULT_EOF_NAME;
+	static const_shared_ptr<std::string> BYTES_READ_RESULT_ERRORS_NAME;
+	static const size_t BYTES_READ_RESULT_DATA_TAG_ID;
+	static const size_t BYTES_READ_RESULT_EOF_TAG_ID;
+	static const size_t BYTES_READ_RESULT_ERRORS_TAG_ID;
+	static const_shared_ptr<ComplexTypeSpecifier> get_bytes_read_result_type_specifier();
+	static const_shared_ptr<ComplexTypeSpecifier> get_bytes_read_result_eof_type_specifier();
+
 	static char get_path_separator();
 	static const_shared_ptr<std::string> PATH_SEPARATOR_NAME;
 
@@ -88,7 +119,21 @@ public:
 	static const_shared_ptr<std::string> LANGUAGE_VERSION_STRING;
 
 	static volatile_shared_ptr<file_handle_map> get_file_handle_map();
+	static volatile_shared_ptr<mapped_file_map> get_mapped_file_map();
 
+	/**
+	 * Get the lowest file handle that is not in use by either a stream or a
+	 * mapped file.
+	 */
+	static const int get_free_file_handle();
+
+private:
+	static const_shared_ptr<DeclarationStatement> get_result_declaration(
+			const_shared_ptr<std::string> type_name,
+			const_shared_ptr<std::string> data_name,
+			const_shared_ptr<TypeSpecifier> data_type_specifier,
+			const_shared_ptr<std::string> errors_name,
+			const_shared_ptr<std::string> eof_name = nullptr);
 };
 
 #endif /* BUILTINS_H_ */
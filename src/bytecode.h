@@ -0,0 +1,169 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BYTECODE_H_
+#define BYTECODE_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <type.h>
+#include <error.h>
+
+using namespace std;
+
+/**
+ * A single virtual machine register. The compiler tracks the type of each
+ * register statically, so no type tag is stored alongside the value.
+ */
+union Register {
+	bool as_bool;
+	int as_int;
+	double as_double;
+};
+
+enum OpCode {
+	LOAD_CONSTANT, // a <- constants[b]
+	MOVE, // a <- b
+
+	BOOL_TO_INT, // a <- (int) b
+	BOOL_TO_DOUBLE, // a <- (double) b
+	INT_TO_BOOL, // a <- b != 0
+	INT_TO_DOUBLE, // a <- (double) b
+	DOUBLE_TO_BOOL, // a <- b != 0.0
+
+	INT_ADD, // a <- b + c
+	INT_SUBTRACT,
+	INT_MULTIPLY,
+	INT_DIVIDE,
+	INT_MOD,
+	INT_NEGATE, // a <- -b
+	DOUBLE_ADD,
+	DOUBLE_SUBTRACT,
+	DOUBLE_MULTIPLY,
+	DOUBLE_DIVIDE,
+	DOUBLE_NEGATE,
+
+	BOOL_EQUAL, // a <- b == c
+	BOOL_NOT_EQUAL,
+	BOOL_AND,
+	BOOL_OR,
+	BOOL_NOT, // a <- !b
+	INT_EQUAL,
+	INT_NOT_EQUAL,
+	INT_LESS_THAN,
+	INT_LESS_THAN_EQUAL,
+	INT_GREATER_THAN,
+	INT_GREATER_THAN_EQUAL,
+	DOUBLE_EQUAL,
+	DOUBLE_NOT_EQUAL,
+	DOUBLE_LESS_THAN,
+	DOUBLE_LESS_THAN_EQUAL,
+	DOUBLE_GREATER_THAN,
+	DOUBLE_GREATER_THAN_EQUAL,
+
+	JUMP, // pc <- a
+	JUMP_IF_FALSE, // if (!a) pc <- b
+	JUMP_IF_TRUE, // if (a) pc <- b
+
+	PRINT_BOOL, // print a
+	PRINT_INT,
+	PRINT_DOUBLE,
+	PRINT_STRING, // print strings[a]
+
+	HALT
+};
+
+struct Instruction {
+	OpCode op;
+	int a;
+	int b;
+	int c;
+};
+
+/**
+ * A variable that lives outside of the compiled code. Its value is loaded into
+ * a register on entry and, if the compiled code assigns it, stored back on exit.
+ */
+struct Binding {
+	string name;
+	BasicType type;
+	int target;
+	bool written;
+};
+
+/**
+ * Where to report a runtime error raised by a given instruction, and where to
+ * resume execution afterwards. A negative handler aborts execution with the error.
+ */
+struct ErrorSite {
+	Error::ErrorCode code;
+	yy::position position;
+	int handler;
+};
+
+/**
+ * Register-based bytecode for a compiled statement.
+ */
+class Bytecode {
+public:
+	Bytecode(const vector<Instruction>& instructions,
+			const vector<Register>& constants, const vector<string>& strings,
+			const vector<Binding>& bindings,
+			const map<size_t, ErrorSite>& error_sites,
+			const size_t register_count) :
+			m_instructions(instructions), m_constants(constants), m_strings(
+					strings), m_bindings(bindings), m_error_sites(error_sites), m_register_count(
+					register_count) {
+	}
+
+	const vector<Instruction>& GetInstructions() const {
+		return m_instructions;
+	}
+
+	const vector<Register>& GetConstants() const {
+		return m_constants;
+	}
+
+	const vector<string>& GetStrings() const {
+		return m_strings;
+	}
+
+	const vector<Binding>& GetBindings() const {
+		return m_bindings;
+	}
+
+	const ErrorSite& GetErrorSite(const size_t pc) const {
+		return m_error_sites.at(pc);
+	}
+
+	const size_t GetRegisterCount() const {
+		return m_register_count;
+	}
+
+private:
+	const vector<Instruction> m_instructions;
+	const vector<Register> m_constants;
+	const vector<string> m_strings;
+	const vector<Binding> m_bindings;
+	const map<size_t, ErrorSite> m_error_sites;
+	const size_t m_register_count;
+};
+
+#endif /* BYTECODE_H_ */
@@ -0,0 +1,719 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bytecode_compiler.h>
+#include <execution_context.h>
+#include <statement_block.h>
+#include <for_statement.h>
+#include <while_statement.h>
+#include <if_statement.h>
+#include <print_statement.h>
+#include <assignment_statement.h>
+#include <primitive_declaration_statement.h>
+#include <inferred_declaration_statement.h>
+#include <constant_expression.h>
+#include <variable_expression.h>
+#include <unary_expression.h>
+#include <binary_expression.h>
+#include <basic_variable.h>
+#include <primitive_type_specifier.h>
+#include <optimizer.h>
+
+BytecodeCompiler::BytecodeCompiler(const shared_ptr<ExecutionContext> context) :
+		m_context(context), m_register_count(0) {
+	// a negative handler means "abort"
+	m_handlers.push_back(-1);
+}
+
+const_shared_ptr<Bytecode> BytecodeCompiler::Compile(
+		const ForStatement& statement,
+		const shared_ptr<ExecutionContext> context) {
+	BytecodeCompiler compiler(context);
+	if (compiler.CompileFor(statement)) {
+		return compiler.Finish();
+	}
+
+	return nullptr;
+}
+
+const_shared_ptr<Bytecode> BytecodeCompiler::Compile(
+		const WhileStatement& statement,
+		const shared_ptr<ExecutionContext> context) {
+	BytecodeCompiler compiler(context);
+	if (compiler.CompileWhile(statement)) {
+		return compiler.Finish();
+	}
+
+	return nullptr;
+}
+
+const_shared_ptr<Bytecode> BytecodeCompiler::Finish() {
+	Emit(HALT);
+
+	// resolve jump targets
+	for (auto & instruction : m_instructions) {
+		switch (instruction.op) {
+		case JUMP:
+			instruction.a = m_labels[instruction.a];
+			break;
+		case JUMP_IF_FALSE:
+		case JUMP_IF_TRUE:
+			instruction.b = m_labels[instruction.b];
+			break;
+		default:
+			break;
+		}
+	}
+
+	for (auto & entry : m_error_sites) {
+		auto & site = entry.second;
+		if (site.handler >= 0) {
+			site.handler = m_labels[site.handler];
+		}
+	}
+
+	return make_shared<Bytecode>(m_instructions, m_constants, m_strings,
+			m_bindings, m_error_sites, m_register_count);
+}
+
+const bool BytecodeCompiler::CompileStatements(
+		const StatementListRef statements) {
+	auto subject = statements;
+	while (!StatementList::IsTerminator(subject)) {
+		if (!CompileStatement(subject->GetData())) {
+			return false;
+		}
+		subject = subject->GetNext();
+	}
+
+	return true;
+}
+
+const bool BytecodeCompiler::CompileStatement(
+		const_shared_ptr<Statement> statement) {
+	auto as_print = dynamic_pointer_cast<const PrintStatement>(statement);
+	if (as_print) {
+		auto expression = as_print->GetExpression();
+		auto as_constant = dynamic_pointer_cast<const ConstantExpression>(
+				expression);
+		auto type_specifier =
+				as_constant ?
+						dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+								as_constant->GetTypeSpecifier(m_context).GetData()) :
+						nullptr;
+		if (type_specifier) {
+			if (type_specifier->GetBasicType() == STRING) {
+				auto value = as_constant->Evaluate(m_context, m_context);
+				m_strings.push_back(*(value->GetData<string>()));
+				Emit(PRINT_STRING, m_strings.size() - 1);
+				return true;
+			}
+		}
+
+		Operand operand;
+		if (!CompileExpression(expression, operand)) {
+			return false;
+		}
+
+		switch (operand.type) {
+		case BOOLEAN:
+			Emit(PRINT_BOOL, operand.target);
+			return true;
+		case INT:
+			Emit(PRINT_INT, operand.target);
+			return true;
+		case DOUBLE:
+			Emit(PRINT_DOUBLE, operand.target);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	auto as_assignment = dynamic_pointer_cast<const AssignmentStatement>(
+			statement);
+	if (as_assignment) {
+		auto as_basic = dynamic_pointer_cast<const BasicVariable>(
+				as_assignment->GetVariable());
+		if (!as_basic
+				|| !NamespaceQualifierList::IsTerminator(as_basic->GetSpace())) {
+			return false;
+		}
+
+		return CompileAssignment(*as_basic->GetName(),
+				as_assignment->GetOpType(), as_assignment->GetExpression());
+	}
+
+	auto as_primitive_declaration = dynamic_pointer_cast<
+			const PrimitiveDeclarationStatement>(statement);
+	if (as_primitive_declaration) {
+		auto name = *as_primitive_declaration->GetName();
+		auto initializer = as_primitive_declaration->GetInitializerExpression();
+		if (!initializer) {
+			// declared on scope entry
+			return m_scopes.back().locals.count(name) == 1;
+		}
+
+		auto type_specifier = dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+				as_primitive_declaration->GetTypeSpecifier());
+		if (!type_specifier) {
+			return false;
+		}
+
+		Operand value;
+		Operand converted;
+		if (!CompileExpression(initializer, value)
+				|| !Convert(value, type_specifier->GetBasicType(), converted)) {
+			return false;
+		}
+
+		Operand local = { AddRegister(), converted.type };
+		Emit(MOVE, local.target, converted.target);
+		m_scopes.back().pending.erase(name);
+		m_scopes.back().locals[name] = local;
+		return true;
+	}
+
+	auto as_inferred_declaration = dynamic_pointer_cast<
+			const InferredDeclarationStatement>(statement);
+	if (as_inferred_declaration) {
+		auto name = *as_inferred_declaration->GetName();
+		Operand value;
+		if (!CompileExpression(
+				as_inferred_declaration->GetInitializerExpression(), value)) {
+			return false;
+		}
+
+		Operand local = { AddRegister(), value.type };
+		Emit(MOVE, local.target, value.target);
+		m_scopes.back().pending.erase(name);
+		m_scopes.back().locals[name] = local;
+		return true;
+	}
+
+	auto as_if = dynamic_pointer_cast<const IfStatement>(statement);
+	if (as_if) {
+		return CompileIf(*as_if);
+	}
+
+	auto as_while = dynamic_pointer_cast<const WhileStatement>(statement);
+	if (as_while) {
+		return CompileWhile(*as_while);
+	}
+
+	auto as_for = dynamic_pointer_cast<const ForStatement>(statement);
+	if (as_for) {
+		return CompileFor(*as_for);
+	}
+
+	return false;
+}
+
+const bool BytecodeCompiler::CompileFor(const ForStatement& statement) {
+	// the initializer, condition, update and body all share a single context
+	auto initial = statement.GetInitial();
+	auto block = statement.GetStatementBlock();
+	auto statements =
+			block ? block->GetStatements() : StatementList::GetTerminator();
+	if (initial) {
+		statements = StatementList::From(initial, statements);
+	}
+	EnterScope(statements);
+
+	if (initial && !CompileStatement(initial)) {
+		return false;
+	}
+
+	auto body = AddLabel();
+	auto condition = AddLabel();
+	Emit(JUMP, condition);
+
+	BindLabel(body);
+	if (block && !CompileStatements(block->GetStatements())) {
+		return false;
+	}
+
+	if (!CompileStatement(statement.GetLoopAssignment())) {
+		return false;
+	}
+
+	BindLabel(condition);
+	Operand test;
+	if (!CompileCondition(statement.GetLoopExpression(), test)) {
+		return false;
+	}
+	Emit(JUMP_IF_TRUE, test.target, body);
+
+	ExitScope();
+	return true;
+}
+
+const bool BytecodeCompiler::CompileWhile(const WhileStatement& statement) {
+	auto block = statement.GetBlock();
+	EnterScope(block->GetStatements());
+
+	auto body = AddLabel();
+	auto condition = AddLabel();
+	if (statement.GetMode() == WhileStatement::WHILE) {
+		Emit(JUMP, condition);
+	}
+
+	// errors raised in the body are discarded, and execution resumes with the loop condition
+	BindLabel(body);
+	m_handlers.push_back(condition);
+	if (!CompileStatements(block->GetStatements())) {
+		return false;
+	}
+	m_handlers.pop_back();
+
+	// the loop condition is evaluated in the enclosing context
+	ExitScope();
+
+	BindLabel(condition);
+	Operand test;
+	if (!CompileCondition(statement.GetExpression(), test)) {
+		return false;
+	}
+	Emit(JUMP_IF_TRUE, test.target, body);
+
+	return true;
+}
+
+const bool BytecodeCompiler::CompileIf(const IfStatement& statement) {
+	Operand test;
+	if (!CompileCondition(statement.GetExpression(), test)) {
+		return false;
+	}
+
+	auto else_label = AddLabel();
+	auto end = AddLabel();
+	Emit(JUMP_IF_FALSE, test.target, else_label);
+	if (!CompileBlock(statement.GetBlock())) {
+		return false;
+	}
+	Emit(JUMP, end);
+
+	BindLabel(else_label);
+	auto else_block = statement.GetElseBlock();
+	if (else_block && !CompileBlock(else_block)) {
+		return false;
+	}
+
+	BindLabel(end);
+	return true;
+}
+
+const bool BytecodeCompiler::CompileBlock(
+		const_shared_ptr<StatementBlock> block) {
+	EnterScope(block->GetStatements());
+	if (!CompileStatements(block->GetStatements())) {
+		return false;
+	}
+	ExitScope();
+	return true;
+}
+
+const bool BytecodeCompiler::CompileCondition(
+		const_shared_ptr<Expression> expression, Operand& out) {
+	// non-boolean conditions are reinterpreted rather than converted; leave them to the tree walker
+	return CompileExpression(expression, out) && out.type == BOOLEAN;
+}
+
+const bool BytecodeCompiler::CompileExpression(
+		const_shared_ptr<Expression> expression, Operand& out) {
+	auto as_constant = dynamic_pointer_cast<const ConstantExpression>(
+			expression);
+	// constant operations have been folded, so they are loaded as literals too
+	if (as_constant
+			|| (OPTIMIZATION_LEVEL >= CONSTANT_FOLDING
+					&& expression->IsConstant())) {
+		auto type_specifier = dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+				expression->GetTypeSpecifier(m_context).GetData());
+		if (!type_specifier) {
+			return false;
+		}
+
+		auto value = expression->Evaluate(m_context, m_context);
+		if (!ErrorList::IsTerminator(value->GetErrors())) {
+			return false;
+		}
+		Register constant;
+		auto type = type_specifier->GetBasicType();
+		switch (type) {
+		case BOOLEAN:
+			constant.as_bool = value->GetTaggedValue().As<bool>();
+			break;
+		case INT:
+			constant.as_int = value->GetTaggedValue().As<int>();
+			break;
+		case DOUBLE:
+			constant.as_double = value->GetTaggedValue().As<double>();
+			break;
+		default:
+			return false;
+		}
+
+		out = {AddRegister(), type};
+		Emit(LOAD_CONSTANT, out.target, AddConstant(constant));
+		return true;
+	}
+
+	auto as_variable = dynamic_pointer_cast<const VariableExpression>(
+			expression);
+	if (as_variable) {
+		auto as_basic = dynamic_pointer_cast<const BasicVariable>(
+				as_variable->GetVariable());
+		if (!as_basic
+				|| !NamespaceQualifierList::IsTerminator(as_basic->GetSpace())) {
+			return false;
+		}
+
+		return Lookup(*as_basic->GetName(), out);
+	}
+
+	auto as_unary = dynamic_pointer_cast<const UnaryExpression>(expression);
+	if (as_unary) {
+		Operand operand;
+		if (!CompileExpression(as_unary->GetExpression(), operand)) {
+			return false;
+		}
+
+		if (as_unary->GetOperator() == UNARY_MINUS && operand.type == INT) {
+			out = {AddRegister(), INT};
+			Emit(INT_NEGATE, out.target, operand.target);
+			return true;
+		} else if (as_unary->GetOperator() == UNARY_MINUS
+				&& operand.type == DOUBLE) {
+			out = {AddRegister(), DOUBLE};
+			Emit(DOUBLE_NEGATE, out.target, operand.target);
+			return true;
+		} else if (as_unary->GetOperator() == NOT && operand.type == BOOLEAN) {
+			out = {AddRegister(), BOOLEAN};
+			Emit(BOOL_NOT, out.target, operand.target);
+			return true;
+		}
+
+		return false;
+	}
+
+	auto as_binary = dynamic_pointer_cast<const BinaryExpression>(expression);
+	if (as_binary) {
+		return CompileBinary(as_binary->GetOperator(), as_binary->GetLeft(),
+				as_binary->GetRight(), out);
+	}
+
+	return false;
+}
+
+const bool BytecodeCompiler::CompileBinary(const OperatorType op,
+		const_shared_ptr<Expression> left, const_shared_ptr<Expression> right,
+		Operand& out) {
+	Operand left_operand;
+	Operand right_operand;
+	if (!CompileExpression(left, left_operand)
+			|| !CompileExpression(right, right_operand)) {
+		return false;
+	}
+
+	// mirror the widening rules of BinaryExpression::Evaluate
+	const BasicType type =
+			left_operand.type >= right_operand.type ?
+					left_operand.type : right_operand.type;
+
+	switch (op) {
+	case AND:
+	case OR: {
+		Operand converted_left;
+		Operand converted_right;
+		if (!Convert(left_operand, BOOLEAN, converted_left)
+				|| !Convert(right_operand, BOOLEAN, converted_right)) {
+			return false;
+		}
+
+		out = {AddRegister(), BOOLEAN};
+		Emit(op == AND ? BOOL_AND : BOOL_OR, out.target,
+				converted_left.target, converted_right.target);
+		return true;
+	}
+	case EQUAL:
+	case NOT_EQUAL:
+	case LESS_THAN:
+	case LESS_THAN_EQUAL:
+	case GREATER_THAN:
+	case GREATER_THAN_EQUAL: {
+		Operand converted_left;
+		Operand converted_right;
+		if (!Convert(left_operand, type, converted_left)
+				|| !Convert(right_operand, type, converted_right)) {
+			return false;
+		}
+
+		OpCode code;
+		if (type == BOOLEAN) {
+			if (op == EQUAL) {
+				code = BOOL_EQUAL;
+			} else if (op == NOT_EQUAL) {
+				code = BOOL_NOT_EQUAL;
+			} else {
+				return false;
+			}
+		} else {
+			const OpCode base = type == INT ? INT_EQUAL : DOUBLE_EQUAL;
+			code = OpCode(base + (op - EQUAL));
+		}
+
+		out = {AddRegister(), BOOLEAN};
+		Emit(code, out.target, converted_left.target, converted_right.target);
+		return true;
+	}
+	case PLUS:
+	case MINUS:
+	case MULTIPLY:
+	case DIVIDE:
+	case MOD: {
+		if (type == BOOLEAN || (op == MOD && type != INT)) {
+			return false;
+		}
+
+		const bool checked = op == DIVIDE || op == MOD;
+		Operand converted_left;
+		Operand converted_right;
+		if (!Convert(left_operand, type, converted_left)
+				|| !Convert(right_operand, type, converted_right)) {
+			return false;
+		}
+
+		const OpCode base = type == INT ? INT_ADD : DOUBLE_ADD;
+		out = {AddRegister(), type};
+		Emit(OpCode(base + (op - PLUS)), out.target, converted_left.target,
+				converted_right.target);
+		if (checked) {
+			EmitErrorSite(
+					op == DIVIDE ? Error::DIVIDE_BY_ZERO : Error::MOD_BY_ZERO,
+					right->GetLocation().begin);
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+const bool BytecodeCompiler::CompileAssignment(const string& name,
+		const AssignmentType op, const_shared_ptr<Expression> expression) {
+	Operand variable;
+	Operand value;
+	if (!Lookup(name, variable) || !CompileExpression(expression, value)) {
+		return false;
+	}
+
+	if (variable.type == BOOLEAN) {
+		if (op != ASSIGN || value.type != BOOLEAN) {
+			return false;
+		}
+		Emit(MOVE, variable.target, value.target);
+	} else {
+		// narrowing assignments are rejected during preprocessing
+		Operand converted;
+		if (value.type > variable.type
+				|| !Convert(value, variable.type, converted)) {
+			return false;
+		}
+
+		const bool is_int = variable.type == INT;
+		switch (op) {
+		case ASSIGN:
+			Emit(MOVE, variable.target, converted.target);
+			break;
+		case PLUS_ASSIGN:
+			Emit(is_int ? INT_ADD : DOUBLE_ADD, variable.target,
+					variable.target, converted.target);
+			break;
+		case MINUS_ASSIGN:
+			Emit(is_int ? INT_SUBTRACT : DOUBLE_SUBTRACT, variable.target,
+					variable.target, converted.target);
+			break;
+		default:
+			return false;
+		}
+	}
+
+	for (auto & binding : m_bindings) {
+		if (binding.target == variable.target) {
+			binding.written = true;
+		}
+	}
+
+	return true;
+}
+
+const bool BytecodeCompiler::Convert(const Operand& operand,
+		const BasicType type, Operand& out) {
+	if (operand.type == type) {
+		out = operand;
+		return true;
+	}
+
+	OpCode code;
+	if (operand.type == BOOLEAN && type == INT) {
+		code = BOOL_TO_INT;
+	} else if (operand.type == BOOLEAN && type == DOUBLE) {
+		code = BOOL_TO_DOUBLE;
+	} else if (operand.type == INT && type == BOOLEAN) {
+		code = INT_TO_BOOL;
+	} else if (operand.type == INT && type == DOUBLE) {
+		code = INT_TO_DOUBLE;
+	} else if (operand.type == DOUBLE && type == BOOLEAN) {
+		code = DOUBLE_TO_BOOL;
+	} else {
+		return false;
+	}
+
+	out = {AddRegister(), type};
+	Emit(code, out.target, operand.target);
+	return true;
+}
+
+void BytecodeCompiler::EnterScope(const StatementListRef statements) {
+	// the tree walker clones a block's preprocessed context on entry, so every
+	// variable declared in the block exists (with its default value) before
+	// its declaration statement runs. Declarations without initializers are
+	// never re-assigned, so we reset them here; anything else is marked
+	// pending until its declaration has been compiled.
+	Scope scope;
+	auto subject = statements;
+	while (!StatementList::IsTerminator(subject)) {
+		auto statement = subject->GetData();
+		auto as_primitive = dynamic_pointer_cast<
+				const PrimitiveDeclarationStatement>(statement);
+		auto type_specifier =
+				as_primitive ?
+						dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+								as_primitive->GetTypeSpecifier()) :
+						nullptr;
+		if (type_specifier && !as_primitive->GetInitializerExpression()) {
+			Operand local = { AddRegister(), type_specifier->GetBasicType() };
+			Register value;
+			switch (local.type) {
+			case BOOLEAN:
+				value.as_bool = false;
+				break;
+			case INT:
+				value.as_int = 0;
+				break;
+			case DOUBLE:
+				value.as_double = 0.0;
+				break;
+			default:
+				// not supported; make sure any reference fails
+				scope.pending.insert(*as_primitive->GetName());
+				subject = subject->GetNext();
+				continue;
+			}
+
+			Emit(LOAD_CONSTANT, local.target, AddConstant(value));
+			scope.locals[*as_primitive->GetName()] = local;
+		} else {
+			auto as_declaration = dynamic_pointer_cast<
+					const DeclarationStatement>(statement);
+			if (as_declaration) {
+				scope.pending.insert(*as_declaration->GetName());
+			}
+		}
+
+		subject = subject->GetNext();
+	}
+
+	m_scopes.push_back(scope);
+}
+
+void BytecodeCompiler::ExitScope() {
+	m_scopes.pop_back();
+}
+
+const bool BytecodeCompiler::Lookup(const string& name, Operand& out) {
+	for (auto scope = m_scopes.rbegin(); scope != m_scopes.rend(); ++scope) {
+		auto local = scope->locals.find(name);
+		if (local != scope->locals.end()) {
+			out = local->second;
+			return true;
+		}
+
+		if (scope->pending.count(name) == 1) {
+			return false;
+		}
+	}
+
+	for (auto & binding : m_bindings) {
+		if (binding.name == name) {
+			out = {binding.target, binding.type};
+			return true;
+		}
+	}
+
+	auto symbol = m_context->GetSymbol(name, DEEP);
+	if (!symbol || symbol == Symbol::GetDefaultSymbol()) {
+		return false;
+	}
+
+	auto type_specifier = dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+			symbol->GetTypeSpecifier());
+	if (!type_specifier) {
+		return false;
+	}
+
+	auto type = type_specifier->GetBasicType();
+	if (type != BOOLEAN && type != INT && type != DOUBLE) {
+		return false;
+	}
+
+	out = {AddRegister(), type};
+	m_bindings.push_back( { name, type, out.target, false });
+	return true;
+}
+
+const int BytecodeCompiler::AddRegister() {
+	return m_register_count++;
+}
+
+const int BytecodeCompiler::AddConstant(const Register& value) {
+	m_constants.push_back(value);
+	return m_constants.size() - 1;
+}
+
+const int BytecodeCompiler::AddLabel() {
+	m_labels.push_back(-1);
+	return m_labels.size() - 1;
+}
+
+void BytecodeCompiler::BindLabel(const int label) {
+	m_labels[label] = m_instructions.size();
+}
+
+void BytecodeCompiler::Emit(const OpCode op, const int a, const int b,
+		const int c) {
+	m_instructions.push_back( { op, a, b, c });
+}
+
+void BytecodeCompiler::EmitErrorSite(const Error::ErrorCode code,
+		const yy::position position) {
+	// attach to the most recently emitted instruction
+	m_error_sites[m_instructions.size() - 1] = {code, position,
+			m_handlers.back()};
+}
@@ -0,0 +1,119 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BYTECODE_COMPILER_H_
+#define BYTECODE_COMPILER_H_
+
+#include <set>
+#include <bytecode.h>
+#include <assignment_type.h>
+#include <defaults.h>
+#include <statement.h>
+
+class ExecutionContext;
+class Expression;
+class StatementBlock;
+class ForStatement;
+class WhileStatement;
+class IfStatement;
+
+/**
+ * Lowers loops over primitive values to register bytecode.
+ *
+ * Only a subset of the language is supported: boolean, int and double
+ * variables and constants, the arithmetic, comparison and logic operators,
+ * assignments, primitive declarations, print statements, and nested if, for
+ * and while statements. Anything else causes compilation to fail, in which
+ * case the caller should fall back to tree-walking evaluation.
+ */
+class BytecodeCompiler {
+public:
+	/**
+	 * Compile the given statement. The context is the one the statement will be
+	 * executed in; it is used to resolve variables declared outside the statement.
+	 *
+	 * Returns nullptr if the statement contains unsupported constructs.
+	 */
+	static const_shared_ptr<Bytecode> Compile(const ForStatement& statement,
+			const shared_ptr<ExecutionContext> context);
+	static const_shared_ptr<Bytecode> Compile(const WhileStatement& statement,
+			const shared_ptr<ExecutionContext> context);
+
+private:
+	struct Operand {
+		int target;
+		BasicType type;
+	};
+
+	struct Scope {
+		map<string, Operand> locals;
+		set<string> pending;
+	};
+
+	BytecodeCompiler(const shared_ptr<ExecutionContext> context);
+
+	const_shared_ptr<Bytecode> Finish();
+
+	const bool CompileStatement(const_shared_ptr<Statement> statement);
+	const bool CompileStatements(const StatementListRef statements);
+	const bool CompileFor(const ForStatement& statement);
+	const bool CompileWhile(const WhileStatement& statement);
+	const bool CompileIf(const IfStatement& statement);
+	const bool CompileBlock(const_shared_ptr<StatementBlock> block);
+	const bool CompileCondition(const_shared_ptr<Expression> expression,
+			Operand& out);
+
+	const bool CompileExpression(const_shared_ptr<Expression> expression,
+			Operand& out);
+	const bool CompileBinary(const OperatorType op,
+			const_shared_ptr<Expression> left,
+			const_shared_ptr<Expression> right, Operand& out);
+	const bool CompileAssignment(const string& name,
+			const AssignmentType op, const_shared_ptr<Expression> expression);
+
+	const bool Convert(const Operand& operand, const BasicType type,
+			Operand& out);
+
+	void EnterScope(const StatementListRef statements);
+	void ExitScope();
+	const bool Lookup(const string& name, Operand& out);
+
+	const int AddRegister();
+	const int AddConstant(const Register& value);
+	const int AddLabel();
+	void BindLabel(const int label);
+	void Emit(const OpCode op, const int a = 0, const int b = 0,
+			const int c = 0);
+	void EmitErrorSite(const Error::ErrorCode code,
+			const yy::position position);
+
+	const shared_ptr<ExecutionContext> m_context;
+	vector<Instruction> m_instructions;
+	vector<Register> m_constants;
+	vector<string> m_strings;
+	vector<Binding> m_bindings;
+	map<size_t, ErrorSite> m_error_sites;
+	size_t m_register_count;
+
+	vector<Scope> m_scopes;
+	vector<int> m_labels;
+	vector<int> m_handlers;
+};
+
+#endif /* BYTECODE_COMPILER_H_ */
@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <call_stack.h>
+#include <ucontext.h>
+
+size_t MAX_STACK = 0;
+
+const bool CallStack::Extend(const std::function<void()>& callback) {
+	State& state = GetState();
+	if (state.depth == state.segments.size()) {
+		if (state.used + 2 * RED_ZONE > MAX_STACK) {
+			return false;
+		}
+
+		auto remaining = MAX_STACK - state.used;
+		auto size = remaining < SEGMENT_SIZE ? remaining : SEGMENT_SIZE;
+		state.segments.push_back(
+				Segment { std::unique_ptr<char[]>(new char[size]), size });
+	}
+
+	// nested invocations may add segments, so don't hold on to this one
+	auto memory = state.segments[state.depth].memory.get();
+	auto size = state.segments[state.depth].size;
+
+	ucontext_t caller;
+	ucontext_t callee;
+	getcontext(&callee);
+	callee.uc_stack.ss_sp = memory;
+	callee.uc_stack.ss_size = size;
+	callee.uc_link = &caller;
+	makecontext(&callee, &CallStack::Enter, 0);
+
+	// stacks grow down, so the red zone is at the start of the segment
+	auto previous_limit = state.limit;
+	state.limit = reinterpret_cast<uintptr_t>(memory) + RED_ZONE;
+	state.used += size;
+	state.depth++;
+	state.callback = &callback;
+
+	swapcontext(&caller, &callee);
+
+	state.depth--;
+	state.used -= size;
+	state.limit = previous_limit;
+
+	if (state.exception) {
+		auto exception = state.exception;
+		state.exception = nullptr;
+		std::rethrow_exception(exception);
+	}
+
+	return true;
+}
+
+void CallStack::Enter() {
+	// read the callback before anything else can run on this thread
+	auto callback = GetState().callback;
+	try {
+		(*callback)();
+	} catch (...) {
+		// returning through uc_link is the only way back to the caller
+		GetState().exception = std::current_exception();
+	}
+}
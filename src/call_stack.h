@@ -0,0 +1,115 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CALL_STACK_H_
+#define CALL_STACK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * The memory budget for function invocations, in bytes. If zero (the
+ * default), invocations run on the process stack and are limited to
+ * INVOCATION_DEPTH nested calls.
+ */
+extern size_t MAX_STACK;
+
+/**
+ * A growable call stack, made of segments allocated from the heap.
+ *
+ * When a stack budget is set, function invocations run on heap-allocated
+ * stack segments rather than on the process stack. An invocation that would
+ * start too close to the end of its segment is run on the next segment
+ * instead, so the depth of recursion is bounded by the budget, not by the
+ * size of the process stack or a fixed invocation count.
+ *
+ * Segments are kept once allocated, so recursion that repeatedly crosses a
+ * segment boundary does not go back to the heap each time. Each thread has
+ * its own stack.
+ *
+ * Switching segments uses swapcontext, which saves and restores the signal
+ * mask with a system call on each switch. Switches happen only when an
+ * invocation crosses a segment boundary, so with the default segment size
+ * the cost is amortized over many invocations.
+ *
+ * Exceptions cannot unwind across a context switch, so an exception thrown
+ * by the callback is caught on the segment and rethrown by Extend once
+ * execution is back on the caller's stack.
+ */
+class CallStack {
+public:
+	/**
+	 * True if the next invocation must be run on a new segment. This is always
+	 * the case for the first invocation, which moves execution off the process
+	 * stack.
+	 */
+	static const bool IsLow() {
+		char marker;
+		return MAX_STACK > 0
+				&& reinterpret_cast<uintptr_t>(&marker) < GetState().limit;
+	}
+
+	/**
+	 * Run the callback on a new segment. Returns false without running the
+	 * callback if the segment would exceed the stack budget. Exceptions thrown
+	 * by the callback propagate to the caller.
+	 */
+	static const bool Extend(const std::function<void()>& callback);
+
+private:
+	struct Segment {
+		std::unique_ptr<char[]> memory;
+		size_t size;
+	};
+
+	struct State {
+		uintptr_t limit;
+		size_t used;
+		size_t depth;
+		std::vector<Segment> segments;
+		const std::function<void()>* callback;
+		std::exception_ptr exception;
+	};
+
+	static void Enter();
+
+	static State& GetState() {
+		static thread_local State state = { UINTPTR_MAX, 0, 0, { }, nullptr,
+				nullptr };
+		return state;
+	}
+
+	/**
+	 * The size of each segment, unless less of the budget remains.
+	 */
+	static const size_t SEGMENT_SIZE = 1024 * 1024;
+
+	/**
+	 * Space left free at the end of each segment for the native frames of a
+	 * single invocation (statements, expressions and builtins) that do not
+	 * themselves check the stack.
+	 */
+	static const size_t RED_ZONE = 128 * 1024;
+};
+
+#endif /* CALL_STACK_H_ */
@@ -18,6 +18,9 @@
  */
 
 #include <driver.h>
+#include <builtins.h>
+#include <stdlib.h>
+#include <sstream>
 
 int Driver::parse(volatile_shared_ptr<string> file_name) {
 	int scan_begin_result = scan_begin(file_name,
@@ -47,27 +50,157 @@ int Driver::parse_string(const std::string& string) {
 	return res;
 }
 
+FILE* Driver::open_import(const std::string& source,
+		volatile_shared_ptr<string>& file_name, bool& already_imported) {
+	auto debug_import = (m_trace_level & IMPORT) == IMPORT;
+	auto path_separator = Builtins::get_path_separator();
+
+	already_imported = false;
+	for (auto & include_path : *m_include_paths) {
+		auto potential_source = *include_path + path_separator + source;
+		FILE* file_handle = fopen(potential_source.c_str(), "r");
+		if (!file_handle) {
+			continue;
+		}
+
+		if (debug_import) {
+			cout << "Found import source " << potential_source << endl;
+		}
+
+		// the same file may be reachable through more than one include path
+		// (or more than one spelling of the same path), so imports are keyed
+		// on the canonical path of the file
+#ifdef _WIN32
+		char* canonical_path = _fullpath(nullptr, potential_source.c_str(), 0);
+#else
+		char* canonical_path = realpath(potential_source.c_str(), nullptr);
+#endif
+		auto key = canonical_path ? string(canonical_path) : potential_source;
+		free(canonical_path);
+
+		if (!m_imported_paths.insert(key).second) {
+			if (debug_import) {
+				cout << "Source already imported." << endl;
+			}
+			fclose(file_handle);
+			already_imported = true;
+			return nullptr;
+		}
+
+		file_name = GetFileName(potential_source);
+		return file_handle;
+	}
+
+	return nullptr;
+}
+
+bool Driver::begin_import(FILE* file_handle,
+		volatile_shared_ptr<string> file_name, const yy::location& location) {
+	if (!m_import_cache) {
+		return false;
+	}
+
+	auto debug_import = (m_trace_level & IMPORT) == IMPORT;
+	auto entry_path = m_import_cache->GetEntryPath(file_handle);
+	auto tokens = m_import_cache->Load(entry_path, file_name);
+	if (tokens) {
+		if (debug_import) {
+			cout << "Replaying cached tokens from " << entry_path << endl;
+		}
+		m_replays.push(
+				TokenReplay(tokens, m_input_stack->size(), location));
+		return true;
+	}
+
+	// the caller pushes the input stack before scanning the source
+	m_recordings.push(
+			TokenRecording(entry_path, m_input_stack->size() + 1,
+					m_error_count));
+	return false;
+}
+
+void Driver::end_import() {
+	if (m_recordings.empty()
+			|| m_recordings.top().GetDepth() != m_input_stack->size()) {
+		return;
+	}
+
+	auto& recording = m_recordings.top();
+	if (recording.GetErrorCount() == m_error_count) {
+		auto stored = m_import_cache->Store(recording.GetEntryPath(),
+				recording.GetTokens());
+		if ((m_trace_level & IMPORT) == IMPORT) {
+			cout << (stored ? "Cached" : "Could not cache") << " tokens in "
+					<< recording.GetEntryPath() << endl;
+		}
+	}
+	m_recordings.pop();
+}
+
+void Driver::record(const yy::newt_parser::symbol_type& symbol) {
+	if (!m_recordings.empty() && !is_replaying()
+			&& m_recordings.top().GetDepth() == m_input_stack->size()) {
+		m_recordings.top().GetTokens().push_back(ScannedToken(symbol));
+	}
+}
+
+void Driver::record_import(const std::string& import_name,
+		const yy::location& location) {
+	if (!m_recordings.empty() && !is_replaying()
+			&& m_recordings.top().GetDepth() == m_input_stack->size()) {
+		m_recordings.top().GetTokens().push_back(
+				ScannedToken(make_shared<const string>(import_name),
+						location));
+	}
+}
+
+volatile_shared_ptr<string> Driver::GetFileName(
+		const std::string& file_name) const {
+	auto existing = m_file_names->find(file_name);
+	if (existing != m_file_names->end()) {
+		return existing->second;
+	}
+
+	auto result = make_shared<string>(file_name);
+	m_file_names->insert(make_pair(file_name, result));
+	return result;
+}
+
 void Driver::error(const std::string& message) {
-	std::cerr << message;
-	m_error_count++;
+	// messages without a location are terminated by a newline
+	auto length = message.size();
+	if (length > 0 && message[length - 1] == '\n') {
+		length--;
+	}
+	add_error(yy::position(), message.substr(0, length));
 }
 
 void Driver::lexer_error(const yy::location& location,
 		const std::string& message) {
-	std::cerr << "Lex error at " << location << ": " << message << std::endl;
-	m_error_count++;
+	std::ostringstream os;
+	os << "Lex error at " << location << ": " << message;
+	add_error(location.begin, os.str());
 }
 
 void Driver::invalid_token(const yy::location& location,
 		const std::string& token_name) {
-	std::cerr << "Lex error at " << location << ": '" << token_name << "'"
-			<< " is not a legal token." << std::endl;
-	m_error_count++;
+	std::ostringstream os;
+	os << "Lex error at " << location << ": '" << token_name << "'"
+			<< " is not a legal token.";
+	add_error(location.begin, os.str());
 }
 
 void Driver::parser_error(const yy::location& location,
 		const std::string& message) {
-	std::cerr << "Parse error at " << location << ": " << message << "."
-			<< std::endl;
+	std::ostringstream os;
+	os << "Parse error at " << location << ": " << message << ".";
+	add_error(location.begin, os.str());
+}
+
+void Driver::add_error(const yy::position position,
+		const std::string& message) {
+	m_errors = ErrorList::From(
+			make_shared<Error>(Error::PARSE, Error::PARSE_ERROR, position,
+					message), m_errors);
 	m_error_count++;
 }
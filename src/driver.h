@@ -20,12 +20,20 @@
 #ifndef DRIVER_H_
 #define DRIVER_H_
 
+#include <map>
+#include <set>
 #include "parser.tab.hh"
+#include <error.h>
+#include <import_cache.h>
 
+// The scanner proper; yylex returns replayed tokens from the import cache in
+// its place where it can.
 #define YY_DECL \
-	yy::newt_parser::symbol_type yylex (Driver& driver)
+	yy::newt_parser::symbol_type yyscan (Driver& driver)
 YY_DECL;
 
+yy::newt_parser::symbol_type yylex(Driver& driver);
+
 enum TRACE {
 	NO_TRACE = 0, SCANNING = 1, PARSING = 2, IMPORT = 4
 };
@@ -61,12 +69,92 @@ private:
 typedef plain_shared_ptr<InputStackEntry> input_entry;
 typedef std::stack<input_entry, std::deque<input_entry>> input_stack;
 
+// Cached tokens being returned in place of scanning an import. The replay is
+// active while the input stack has the depth it had when the import was
+// found; deeper entries belong to imports nested in the replayed tokens.
+class TokenReplay {
+public:
+	TokenReplay(const_shared_ptr<token_list> tokens, const size_t depth,
+			const yy::location resume_location) :
+			m_tokens(tokens), m_next(0), m_depth(depth), m_resume_location(
+					resume_location) {
+	}
+
+	const bool AtEnd() const {
+		return m_next == m_tokens->size();
+	}
+
+	const ScannedToken& Next() {
+		return m_tokens->at(m_next++);
+	}
+
+	const size_t GetDepth() const {
+		return m_depth;
+	}
+
+	// Get the scanner location to restore once the replay is over.
+	const yy::location GetResumeLocation() const {
+		return m_resume_location;
+	}
+
+private:
+	const_shared_ptr<token_list> m_tokens;
+	size_t m_next;
+	const size_t m_depth;
+	const yy::location m_resume_location;
+};
+
+// The tokens scanned from an import so far, to be stored in the import cache
+// once the import has been scanned to its end.
+class TokenRecording {
+public:
+	TokenRecording(const std::string& entry_path, const size_t depth,
+			const unsigned int error_count) :
+			m_entry_path(entry_path), m_depth(depth), m_error_count(
+					error_count) {
+	}
+
+	const std::string& GetEntryPath() const {
+		return m_entry_path;
+	}
+
+	const size_t GetDepth() const {
+		return m_depth;
+	}
+
+	// Get the driver's error count when the recording started.
+	const unsigned int GetErrorCount() const {
+		return m_error_count;
+	}
+
+	token_list& GetTokens() {
+		return m_tokens;
+	}
+
+private:
+	const std::string m_entry_path;
+	const size_t m_depth;
+	const unsigned int m_error_count;
+	token_list m_tokens;
+};
+
+// Source locations refer to file names by pointer, so the names are kept in a
+// table that lives at least as long as the syntax trees and errors that refer
+// to them.
+typedef std::map<std::string, volatile_shared_ptr<string>> file_name_map;
+
 class Driver {
 public:
 	Driver(const_shared_ptr<string_list> include_paths, const TRACE trace_level) :
+			Driver(include_paths, trace_level, make_shared<file_name_map>()) {
+	}
+
+	Driver(const_shared_ptr<string_list> include_paths, const TRACE trace_level,
+			volatile_shared_ptr<file_name_map> file_names,
+			plain_shared_ptr<ImportCache> import_cache = nullptr) :
 			m_input_stack(make_shared<input_stack>()), m_include_paths(
-					include_paths), m_included_file_names(
-					make_shared<string_list>()), m_trace_level(trace_level) {
+					include_paths), m_file_names(file_names), m_import_cache(
+					import_cache), m_trace_level(trace_level) {
 	}
 
 	virtual ~Driver() {
@@ -86,6 +174,47 @@ public:
 	int scan_string_begin(const std::string& string, const bool trace_scanning);
 	void scan_string_end();
 
+	// Open the given import source, looking in each include path in turn.
+	// Returns nullptr if the source cannot be found, or if the file it
+	// resolves to has already been imported, in which case already_imported
+	// is set. Otherwise file_name is set to the path of the opened file.
+	FILE* open_import(const std::string& source,
+			volatile_shared_ptr<string>& file_name, bool& already_imported);
+
+	// Look up an opened import source in the import cache. On a hit, the
+	// cached tokens are queued for replay, to resume scanning at the given
+	// location afterwards, and true is returned. Otherwise, if there is a
+	// cache, the tokens scanned from the source are recorded for it; the
+	// caller is expected to push the input stack and scan the source.
+	bool begin_import(FILE* file_handle, volatile_shared_ptr<string> file_name,
+			const yy::location& location);
+
+	// Called when the scanner reaches the end of an import, before the input
+	// stack is popped. Stores the tokens recorded for it, unless errors were
+	// found while they were scanned.
+	void end_import();
+
+	// Whether tokens should come from the innermost replay rather than from
+	// the scanner.
+	const bool is_replaying() const {
+		return !m_replays.empty()
+				&& m_replays.top().GetDepth() == m_input_stack->size();
+	}
+
+	TokenReplay& get_replay() {
+		return m_replays.top();
+	}
+
+	void end_replay() {
+		m_replays.pop();
+	}
+
+	// Add a scanned token, or a nested import, to the recording for the
+	// source being scanned, if any.
+	void record(const yy::newt_parser::symbol_type& symbol);
+	void record_import(const std::string& import_name,
+			const yy::location& location);
+
 	void error(const std::string& message);
 	void lexer_error(const yy::location& location, const std::string& message);
 	void invalid_token(const yy::location& location,
@@ -104,13 +233,17 @@ public:
 		return m_error_count;
 	}
 
+	// Get the errors reported so far, in the order they were found.
+	const ErrorListRef GetErrors() const {
+		return ErrorList::Reverse(m_errors);
+	}
+
 	volatile_shared_ptr<input_stack> GetInputStack() const {
 		return m_input_stack;
 	}
 
-	volatile_shared_ptr<string_list> GetIncludedFileNames() const {
-		return m_included_file_names;
-	}
+	// Get the table's instance of the given file name, adding it if needed.
+	volatile_shared_ptr<string> GetFileName(const std::string& file_name) const;
 
 	const_shared_ptr<string_list> GetIncludePaths() const {
 		return m_include_paths;
@@ -129,12 +262,19 @@ public:
 	}
 
 private:
+	void add_error(const yy::position position, const std::string& message);
+
 	std::string m_file_name;
 	plain_shared_ptr<StatementBlock> m_statement_block;
 	unsigned int m_error_count = 0;
+	ErrorListRef m_errors = ErrorList::GetTerminator();
 	volatile_shared_ptr<input_stack> m_input_stack;
 	const_shared_ptr<string_list> m_include_paths;
-	volatile_shared_ptr<string_list> m_included_file_names;
+	volatile_shared_ptr<file_name_map> m_file_names;
+	std::set<std::string> m_imported_paths;
+	plain_shared_ptr<ImportCache> m_import_cache;
+	std::stack<TokenReplay> m_replays;
+	std::stack<TokenRecording> m_recordings;
 	std::vector<char>* m_string_buffer;
 	const TRACE m_trace_level;
 };
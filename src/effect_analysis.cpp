@@ -0,0 +1,467 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <effect_analysis.h>
+#include <typeinfo>
+#include <statement_block.h>
+#include <assignment_statement.h>
+#include <exit_statement.h>
+#include <for_statement.h>
+#include <foreach_statement.h>
+#include <if_statement.h>
+#include <invoke_statement.h>
+#include <match_statement.h>
+#include <match.h>
+#include <print_statement.h>
+#include <return_statement.h>
+#include <while_statement.h>
+#include <declaration_statement.h>
+#include <record_declaration_statement.h>
+#include <sum_declaration_statement.h>
+#include <type_alias_declaration_statement.h>
+#include <unit_declaration_statement.h>
+#include <binary_expression.h>
+#include <constant_expression.h>
+#include <default_value_expression.h>
+#include <function_expression.h>
+#include <invoke_expression.h>
+#include <unary_expression.h>
+#include <using_expression.h>
+#include <variable_expression.h>
+#include <with_expression.h>
+#include <member_instantiation.h>
+#include <basic_variable.h>
+#include <array_variable.h>
+#include <member_variable.h>
+#include <function_declaration.h>
+#include <function_variant.h>
+
+EffectAnalysis::EffectAnalysis(const bool loop) :
+		m_loop(loop), m_function_depth(0), m_errors(
+				ErrorList::GetTerminator()) {
+}
+
+const bool EffectAnalysis::HasEffects(
+		const_shared_ptr<FunctionDeclaration> declaration,
+		const_shared_ptr<StatementBlock> body) {
+	if (!body) {
+		return false;
+	}
+
+	EffectAnalysis analysis(false);
+	analysis.AnalyzeFunction(declaration, body);
+	return !ErrorList::IsTerminator(analysis.m_errors);
+}
+
+const ErrorListRef EffectAnalysis::AnalyzeLoop(const string& identifier,
+		const_shared_ptr<StatementBlock> body,
+		vector<Reduction>& reductions) {
+	EffectAnalysis analysis(true);
+	analysis.m_scopes.push_back(set<string>());
+	analysis.Declare(identifier);
+	analysis.AnalyzeBlock(body);
+	analysis.m_scopes.pop_back();
+
+	auto errors = analysis.m_errors;
+	for (auto& reduction : analysis.m_reductions) {
+		auto name = *reduction.name;
+		if (analysis.m_reads.find(name) != analysis.m_reads.end()) {
+			errors = ErrorList::From(
+					make_shared<Error>(Error::SEMANTIC,
+							Error::PARALLEL_INVALID_REDUCTION,
+							reduction.location.begin, name,
+							"the variable is also read in the loop body"),
+					errors);
+			continue;
+		}
+
+		bool found = false;
+		for (auto& existing : reductions) {
+			if (*existing.name == name) {
+				found = true;
+				if (existing.op != reduction.op) {
+					errors = ErrorList::From(
+							make_shared<Error>(Error::SEMANTIC,
+									Error::PARALLEL_INVALID_REDUCTION,
+									reduction.location.begin, name,
+									"the variable is both added to and multiplied"),
+							errors);
+				}
+				break;
+			}
+		}
+
+		if (!found) {
+			reductions.push_back(reduction);
+		}
+	}
+
+	return errors;
+}
+
+void EffectAnalysis::AnalyzeBlock(const_shared_ptr<StatementBlock> block) {
+	if (!block) {
+		return;
+	}
+
+	m_scopes.push_back(set<string>());
+	auto subject = block->GetStatements();
+	while (!StatementList::IsTerminator(subject)) {
+		AnalyzeStatement(subject->GetData());
+		subject = subject->GetNext();
+	}
+	m_scopes.pop_back();
+}
+
+void EffectAnalysis::AnalyzeStatement(const_shared_ptr<Statement> statement) {
+	if (!statement) {
+		return;
+	}
+
+	auto location = statement->GetLocation();
+	auto as_declaration = dynamic_pointer_cast<const DeclarationStatement>(
+			statement);
+	if (as_declaration) {
+		if (dynamic_pointer_cast<const RecordDeclarationStatement>(statement)
+				|| dynamic_pointer_cast<const SumDeclarationStatement>(
+						statement)
+				|| dynamic_pointer_cast<const UnitDeclarationStatement>(
+						statement)
+				|| dynamic_pointer_cast<const TypeAliasDeclarationStatement>(
+						statement)) {
+			AddEffect(location, "declare types");
+		} else {
+			AnalyzeExpression(as_declaration->GetInitializerExpression());
+		}
+
+		Declare(*as_declaration->GetName());
+		return;
+	}
+
+	auto as_assignment = dynamic_pointer_cast<const AssignmentStatement>(
+			statement);
+	if (as_assignment) {
+		if (!IsReduction(as_assignment)) {
+			AnalyzeAssignment(as_assignment);
+		}
+		return;
+	}
+
+	auto as_invoke = dynamic_pointer_cast<const InvokeStatement>(statement);
+	if (as_invoke) {
+		AnalyzeExpression(as_invoke->GetExpression());
+		return;
+	}
+
+	auto as_print = dynamic_pointer_cast<const PrintStatement>(statement);
+	if (as_print) {
+		AddEffect(location, "print");
+		AnalyzeExpression(as_print->GetExpression());
+		return;
+	}
+
+	if (dynamic_pointer_cast<const ExitStatement>(statement)) {
+		AddEffect(location, "exit");
+		return;
+	}
+
+	auto as_return = dynamic_pointer_cast<const ReturnStatement>(statement);
+	if (as_return) {
+		if (m_loop) {
+			AddEffect(location, "return");
+		}
+		AnalyzeExpression(as_return->GetExpression());
+		return;
+	}
+
+	auto as_if = dynamic_pointer_cast<const IfStatement>(statement);
+	if (as_if) {
+		AnalyzeExpression(as_if->GetExpression());
+		AnalyzeBlock(as_if->GetBlock());
+		AnalyzeBlock(as_if->GetElseBlock());
+		return;
+	}
+
+	auto as_while = dynamic_pointer_cast<const WhileStatement>(statement);
+	if (as_while) {
+		AnalyzeExpression(as_while->GetExpression());
+		AnalyzeBlock(as_while->GetBlock());
+		return;
+	}
+
+	auto as_for = dynamic_pointer_cast<const ForStatement>(statement);
+	if (as_for) {
+		m_scopes.push_back(set<string>());
+		AnalyzeStatement(as_for->GetInitial());
+		AnalyzeExpression(as_for->GetLoopExpression());
+		AnalyzeStatement(as_for->GetLoopAssignment());
+		AnalyzeBlock(as_for->GetStatementBlock());
+		m_scopes.pop_back();
+		return;
+	}
+
+	auto as_foreach = dynamic_pointer_cast<const ForeachStatement>(statement);
+	if (as_foreach) {
+		AnalyzeExpression(as_foreach->GetExpression());
+		m_scopes.push_back(set<string>());
+		Declare(*as_foreach->GetEvaluationIdentifier());
+		AnalyzeBlock(as_foreach->GetStatementBlock());
+		m_scopes.pop_back();
+		return;
+	}
+
+	auto as_match = dynamic_pointer_cast<const MatchStatement>(statement);
+	if (as_match) {
+		AnalyzeExpression(as_match->GetSourceExpression());
+		auto subject = as_match->GetMatchList();
+		while (!MatchList::IsTerminator(subject)) {
+			auto match = subject->GetData();
+			m_scopes.push_back(set<string>());
+			Declare(*match->GetAlias());
+			AnalyzeBlock(match->GetBlock());
+			m_scopes.pop_back();
+			subject = subject->GetNext();
+		}
+		return;
+	}
+
+	AddEffect(location, "contain this statement");
+}
+
+void EffectAnalysis::AnalyzeAssignment(
+		const_shared_ptr<AssignmentStatement> statement) {
+	auto variable = statement->GetVariable();
+	auto root = variable;
+	auto as_array = dynamic_pointer_cast<const ArrayVariable>(root);
+	while (as_array) {
+		root = as_array->GetBaseVariable();
+		as_array = dynamic_pointer_cast<const ArrayVariable>(root);
+	}
+
+	auto name = *root->GetName();
+	if (dynamic_pointer_cast<const MemberVariable>(root)) {
+		AddEffect(statement->GetLocation(), "assign to a record member");
+	} else if (!IsLocal(name)) {
+		AddEffect(statement->GetLocation(),
+				"assign to '" + name + "', which is declared outside of "
+						+ (m_loop ? "the loop" : "the function"));
+	}
+
+	if (root != variable) {
+		AnalyzeVariable(variable);
+	}
+	AnalyzeExpression(statement->GetExpression());
+}
+
+const bool EffectAnalysis::IsReduction(
+		const_shared_ptr<AssignmentStatement> statement) {
+	auto as_basic = dynamic_pointer_cast<const BasicVariable>(
+			statement->GetVariable());
+	if (!m_loop || m_function_depth > 0 || !as_basic
+			|| IsLocal(*as_basic->GetName())) {
+		return false;
+	}
+
+	auto name = as_basic->GetName();
+	auto expression = statement->GetExpression();
+	vector<plain_shared_ptr<Expression>> operands;
+	OperatorType op = PLUS;
+	if (statement->GetOpType() == PLUS_ASSIGN) {
+		operands.push_back(expression);
+	} else if (statement->GetOpType() == ASSIGN) {
+		// walk down the left operands of e.g. "x = x + a + b"
+		auto as_binary = dynamic_pointer_cast<const BinaryExpression>(
+				expression);
+		if (as_binary) {
+			op = as_binary->GetOperator();
+		}
+
+		plain_shared_ptr<Expression> left = expression;
+		while (as_binary && as_binary->GetOperator() == op
+				&& (op == PLUS || op == MULTIPLY)) {
+			operands.push_back(as_binary->GetRight());
+			left = as_binary->GetLeft();
+			as_binary = dynamic_pointer_cast<const BinaryExpression>(left);
+		}
+
+		auto as_variable = dynamic_pointer_cast<const VariableExpression>(
+				left);
+		auto left_basic =
+				as_variable ?
+						dynamic_pointer_cast<const BasicVariable>(
+								as_variable->GetVariable()) :
+						nullptr;
+		if (!left_basic || *left_basic->GetName() != *name) {
+			operands.clear();
+		}
+	}
+
+	if (operands.empty()) {
+		return false;
+	}
+
+	m_reductions.push_back(Reduction { name, op, statement->GetLocation() });
+	for (auto& operand : operands) {
+		AnalyzeExpression(operand);
+	}
+	return true;
+}
+
+void EffectAnalysis::AnalyzeExpression(
+		const_shared_ptr<Expression> expression) {
+	if (!expression) {
+		return;
+	}
+
+	if (dynamic_pointer_cast<const ConstantExpression>(expression)
+			|| dynamic_pointer_cast<const DefaultValueExpression>(expression)) {
+		return;
+	}
+
+	auto as_variable = dynamic_pointer_cast<const VariableExpression>(
+			expression);
+	if (as_variable) {
+		AnalyzeVariable(as_variable->GetVariable());
+		return;
+	}
+
+	auto as_binary = dynamic_pointer_cast<const BinaryExpression>(expression);
+	if (as_binary) {
+		AnalyzeExpression(as_binary->GetLeft());
+		AnalyzeExpression(as_binary->GetRight());
+		return;
+	}
+
+	auto as_unary = dynamic_pointer_cast<const UnaryExpression>(expression);
+	if (as_unary) {
+		AnalyzeExpression(as_unary->GetExpression());
+		return;
+	}
+
+	auto as_invoke = dynamic_pointer_cast<const InvokeExpression>(expression);
+	if (as_invoke) {
+		// the builtin stream operations are subclasses
+		if (typeid(*as_invoke) != typeid(InvokeExpression)) {
+			AddEffect(expression->GetLocation(), "perform I/O");
+		}
+
+		AnalyzeExpression(as_invoke->GetExpression());
+		auto subject = as_invoke->GetArgumentListRef();
+		while (!ArgumentList::IsTerminator(subject)) {
+			AnalyzeExpression(subject->GetData());
+			subject = subject->GetNext();
+		}
+		return;
+	}
+
+	auto as_function = dynamic_pointer_cast<const FunctionExpression>(
+			expression);
+	if (as_function) {
+		// a function's effects are checked when it is invoked, but the loop
+		// body must still know which variables it reads
+		if (m_loop) {
+			m_function_depth++;
+			auto subject = as_function->GetVariantList();
+			while (!FunctionVariantList::IsTerminator(subject)) {
+				auto variant = subject->GetData();
+				AnalyzeFunction(variant->GetDeclaration(), variant->GetBody());
+				subject = subject->GetNext();
+			}
+			m_function_depth--;
+		}
+		return;
+	}
+
+	auto as_with = dynamic_pointer_cast<const WithExpression>(expression);
+	if (as_with) {
+		AnalyzeExpression(as_with->GetSourceExpression());
+		auto subject = as_with->GetMemberInstantiationListRef();
+		while (!MemberInstantiationList::IsTerminator(subject)) {
+			AnalyzeExpression(subject->GetData()->GetExpression());
+			subject = subject->GetNext();
+		}
+		return;
+	}
+
+	if (dynamic_pointer_cast<const UsingExpression>(expression)) {
+		AddEffect(expression->GetLocation(), "perform I/O");
+		return;
+	}
+
+	AddEffect(expression->GetLocation(), "contain this expression");
+}
+
+void EffectAnalysis::AnalyzeVariable(const_shared_ptr<Variable> variable) {
+	auto as_array = dynamic_pointer_cast<const ArrayVariable>(variable);
+	if (as_array) {
+		AnalyzeVariable(as_array->GetBaseVariable());
+		AnalyzeExpression(as_array->GetExpression());
+		return;
+	}
+
+	auto as_member = dynamic_pointer_cast<const MemberVariable>(variable);
+	if (as_member) {
+		AnalyzeVariable(as_member->GetContainer());
+		return;
+	}
+
+	auto name = *variable->GetName();
+	if (!IsLocal(name)) {
+		m_reads.insert(name);
+	}
+}
+
+void EffectAnalysis::AnalyzeFunction(
+		const_shared_ptr<FunctionDeclaration> declaration,
+		const_shared_ptr<StatementBlock> body) {
+	m_scopes.push_back(set<string>());
+	auto subject = declaration->GetParameterList();
+	while (!DeclarationList::IsTerminator(subject)) {
+		Declare(*subject->GetData()->GetName());
+		subject = subject->GetNext();
+	}
+	AnalyzeBlock(body);
+	m_scopes.pop_back();
+}
+
+void EffectAnalysis::Declare(const string& name) {
+	m_scopes.back().insert(name);
+}
+
+const bool EffectAnalysis::IsLocal(const string& name) const {
+	for (auto& scope : m_scopes) {
+		if (scope.find(name) != scope.end()) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void EffectAnalysis::AddEffect(const yy::location location,
+		const string& description) {
+	// effects inside nested functions are checked when they are invoked
+	if (m_function_depth > 0) {
+		return;
+	}
+
+	m_errors = ErrorList::From(
+			make_shared<Error>(Error::SEMANTIC, Error::PARALLEL_SIDE_EFFECT,
+					location.begin, description), m_errors);
+}
@@ -0,0 +1,101 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EFFECT_ANALYSIS_H_
+#define EFFECT_ANALYSIS_H_
+
+#include <set>
+#include <vector>
+#include <defaults.h>
+#include <statement.h>
+#include <type.h>
+
+class AssignmentStatement;
+class Expression;
+class Variable;
+class StatementBlock;
+class FunctionDeclaration;
+
+/**
+ * Determines, from the syntax tree alone, whether a function body or the body
+ * of a parallel foreach statement can affect anything outside of itself.
+ *
+ * A body has effects if it assigns to a variable it does not declare, assigns
+ * to a record member (records may be shared), prints, exits, performs I/O or
+ * declares a type. Invocations are not followed; a function's own analysis
+ * is consulted when it is invoked.
+ */
+class EffectAnalysis {
+public:
+	/**
+	 * An assignment in a parallel loop body that combines values into a
+	 * variable declared outside the loop, i.e. "x += e", "x = x + e1 + e2..."
+	 * or "x = x * e1 * e2...", where the operands do not refer to x.
+	 */
+	struct Reduction {
+		const_shared_ptr<string> name;
+		OperatorType op;
+		yy::location location;
+	};
+
+	static const bool HasEffects(
+			const_shared_ptr<FunctionDeclaration> declaration,
+			const_shared_ptr<StatementBlock> body);
+
+	/**
+	 * Analyze the body of a parallel foreach statement whose loop variable is
+	 * the given identifier. Returns an error for each effect that is not a
+	 * reduction, and for any return statement. Reductions are appended to the
+	 * given list.
+	 */
+	static const ErrorListRef AnalyzeLoop(const string& identifier,
+			const_shared_ptr<StatementBlock> body,
+			vector<Reduction>& reductions);
+
+private:
+	EffectAnalysis(const bool loop);
+
+	void AnalyzeBlock(const_shared_ptr<StatementBlock> block);
+	void AnalyzeStatement(const_shared_ptr<Statement> statement);
+	void AnalyzeAssignment(const_shared_ptr<AssignmentStatement> statement);
+	void AnalyzeExpression(const_shared_ptr<Expression> expression);
+	void AnalyzeVariable(const_shared_ptr<Variable> variable);
+	void AnalyzeFunction(const_shared_ptr<FunctionDeclaration> declaration,
+			const_shared_ptr<StatementBlock> body);
+
+	/**
+	 * Record the given assignment as a reduction if it is one, analyzing only
+	 * its operand: the reduced variable itself does not count as read.
+	 */
+	const bool IsReduction(const_shared_ptr<AssignmentStatement> statement);
+
+	void Declare(const string& name);
+	const bool IsLocal(const string& name) const;
+
+	void AddEffect(const yy::location location, const string& description);
+
+	const bool m_loop;
+	size_t m_function_depth;
+	vector<set<string>> m_scopes;
+	set<string> m_reads;
+	vector<Reduction> m_reductions;
+	ErrorListRef m_errors;
+};
+
+#endif /* EFFECT_ANALYSIS_H_ */
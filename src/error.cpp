@@ -41,6 +41,11 @@ const string Error::ToString() const {
 		os << "Runtime error at " << m_position << ": " << get_error_message();
 		break;
 	}
+	case PARSE: {
+		// the message is a complete diagnostic from the scanner or parser
+		os << get_error_message();
+		break;
+	}
 	default:
 		assert(false);
 	}
@@ -212,6 +217,9 @@ const string Error::get_error_message() const {
 	case MAX_INVOCATION_DEPTH:
 		os << "Max invocation depth " << m_s1 << " exceeded.";
 		break;
+	case MAX_STACK_SIZE:
+		os << "Max stack size of " << m_s1 << " bytes exceeded.";
+		break;
 	case INVALID_WITH_OPERAND:
 		os << "Invalid source expression type '" << m_s1
 				<< "' for 'with' operation: source must be of a record type.";
@@ -260,6 +268,19 @@ const string Error::get_error_message() const {
 				<< "'cannot be unambiguously widened to block result type '"
 				<< m_s2 << "'.";
 		break;
+	case PARALLEL_SIDE_EFFECT:
+		os << "Parallel foreach body cannot " << m_s1 << ".";
+		break;
+	case PARALLEL_INVALID_REDUCTION:
+		os << "Invalid reduction of variable '" << m_s1
+				<< "' in parallel foreach: " << m_s2 << ".";
+		break;
+	case PARALLEL_EFFECTFUL_INVOCATION:
+		os << "Function with side effects invoked in a parallel foreach.";
+		break;
+	case PARSE_ERROR:
+		os << m_s1;
+		break;
 	default:
 		os << "Unknown error code " << m_code
 				<< " passed to Error::error_core.";
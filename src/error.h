@@ -94,6 +94,7 @@ public:
 		EXTRANEOUS_DEFAULT_MATCH,
 		RAW_RECURSIVE_DECLARATION,
 		MAX_INVOCATION_DEPTH,
+		MAX_STACK_SIZE,
 		INVALID_WITH_OPERAND,
 		FUNCTION_VARIANT_WITH_DUPLICATE_SIGNATURE,
 		NO_FUNCTION_VARIANT_MATCH,
@@ -106,7 +107,10 @@ public:
 		RETURN_STMT_MUST_BE_MAYBE,
 		FOREACH_NEXT_MUST_EVALUATE_TO_BASE_TYPE,
 		USING_ASSIGNMENT_TYPE_ERROR,
-		USING_AMBIGUOUS_WIDENING_CONVERSION
+		USING_AMBIGUOUS_WIDENING_CONVERSION,
+		PARALLEL_SIDE_EFFECT,
+		PARALLEL_INVALID_REDUCTION,
+		PARALLEL_EFFECTFUL_INVOCATION
 	};
 
 	Error(ErrorClass error_class, ErrorCode code, yy::position position,
@@ -20,7 +20,9 @@
 #include <execution_context.h>
 #include <symbol_table.h>
 #include <type_table.h>
+#include <frame_allocator.h>
 #include <memory>
+#include <utils.h>
 
 ExecutionContext::ExecutionContext() :
 		ExecutionContext(Modifier::Type::NONE, make_shared<symbol_map>(),
@@ -76,6 +78,62 @@ const_shared_ptr<Symbol> ExecutionContext::GetSymbol(const string& identifier,
 	}
 }
 
+const_shared_ptr<Symbol> ExecutionContext::GetSymbol(const string& identifier,
+		LexicalAddress& address) const {
+	if (SameName(identifier, *TypeTable::GetNilName())) {
+		return Symbol::GetNilSymbol();
+	}
+
+	const ExecutionContext* context = this;
+	shared_ptr<ExecutionContext> parent = nullptr;
+	size_t cached_depth, cached_slot;
+	address.Get(cached_depth, cached_slot);
+	for (size_t i = 0; i < cached_depth && context; i++) {
+		// a node may run against a different chain than the one its address
+		// was found in, so a nearer scope may declare the name and shadow the
+		// cached symbol
+		auto& table = context->GetTable();
+		if (table->size() > 0
+				&& table->GetSlot(identifier) != symbol_map::NO_SLOT) {
+			context = nullptr;
+		} else if (context->m_parent) {
+			parent = context->m_parent->GetData();
+			context = parent.get();
+		} else {
+			context = nullptr;
+		}
+	}
+
+	if (context) {
+		auto result = context->GetTable()->GetSymbol(cached_slot, identifier);
+		if (result) {
+			return result;
+		}
+	}
+
+	// the address is stale; resolve the name and remember where it was found
+	context = this;
+	size_t depth = 0;
+	while (context) {
+		auto slot = context->GetTable()->GetSlot(identifier);
+		if (slot != symbol_map::NO_SLOT) {
+			address.Set(depth, slot);
+			return context->GetTable()->GetSymbol(slot, identifier);
+		}
+
+		if (context->m_parent) {
+			parent = context->m_parent->GetData();
+			assert(parent);
+			context = parent.get();
+			depth++;
+		} else {
+			context = nullptr;
+		}
+	}
+
+	return Symbol::GetDefaultSymbol();
+}
+
 const void ExecutionContext::print(ostream& os, const TypeTable& type_table,
 		const Indent& indent, const SearchType search_type) const {
 	SymbolContext::print(os, type_table, indent);
@@ -89,7 +147,7 @@ const void ExecutionContext::print(ostream& os, const TypeTable& type_table,
 }
 
 SetResult ExecutionContext::SetSymbol(const string& identifier,
-		const_shared_ptr<TypeSpecifier> type, const_shared_ptr<void> value,
+		const_shared_ptr<TypeSpecifier> type, const Value& value,
 		const TypeTable& type_table) {
 	auto result = SymbolContext::SetSymbol(identifier, type, value, type_table);
 
@@ -126,24 +184,66 @@ const shared_ptr<ExecutionContext> ExecutionContext::WithParent(
 							GetDepth()));
 }
 
+const shared_ptr<ExecutionContext> ExecutionContext::GetFrame(
+		const shared_ptr<ExecutionContext> variant_context,
+		const shared_ptr<ExecutionContext> closure, const size_t depth) {
+	auto parent = ExecutionContextList::From(closure, closure->GetParent());
+	auto table = allocate_shared<symbol_map>(FrameAllocator<symbol_map>(),
+			*variant_context->GetTable());
+
+	// parameter lists cannot declare types, so frames share the closure's types
+	// the frame is EPHEMERAL so that strong references will be made to it by functions that return functions, e.g. partial applicators
+	return allocate_shared<ExecutionContext>(FrameAllocator<ExecutionContext>(),
+			variant_context->GetModifiers(), table, parent,
+			closure->GetTypeTable(), EPHEMERAL, depth);
+}
+
 const shared_ptr<ExecutionContext> ExecutionContext::GetRuntimeInstance(
 		const shared_ptr<ExecutionContext> source,
 		const shared_ptr<ExecutionContext> parent) {
 	ExecutionContextListRef new_parent;
 	volatile_shared_ptr<TypeTable> new_type_table = source->GetTypeTable();
 	if (parent) {
-		auto parent_context = ExecutionContextList::From(parent,
-				parent->GetParent());
-
 		new_parent = ExecutionContextList::From(parent, parent->GetParent());
-		new_type_table = new_type_table->WithParent(parent->GetTypeTable());
+		if (new_type_table->IsEmpty()) {
+			// the block declares no types, so it can share its parent's table
+			new_type_table = parent->GetTypeTable();
+		} else {
+			new_type_table = new_type_table->WithParent(parent->GetTypeTable());
+		}
 	}
 
-	auto execution_context = make_shared<ExecutionContext>(source->Clone(),
-			Modifier::MUTABLE, new_parent, new_type_table, EPHEMERAL,
-			parent->GetDepth() + 1);
+	auto table = allocate_shared<symbol_map>(FrameAllocator<symbol_map>(),
+			*source->GetTable());
+	return allocate_shared<ExecutionContext>(FrameAllocator<ExecutionContext>(),
+			source->GetModifiers(), table, new_parent, new_type_table,
+			EPHEMERAL, parent->GetDepth() + 1);
+}
 
-	return execution_context;
+const shared_ptr<ExecutionContext> ExecutionContext::GetRootInstance(
+		const shared_ptr<ExecutionContext> source) {
+	// types are only declared during preprocessing, so the type table can be
+	// shared rather than copied
+	auto result = make_shared<ExecutionContext>(source->GetModifiers(),
+			make_shared<symbol_map>(*source->GetTable()), source->GetParent(),
+			source->GetTypeTable(), ROOT, source->GetDepth());
+	result->m_layout = source.get();
+	return result;
+}
+
+const shared_ptr<ExecutionContext> ExecutionContext::ResolveClosure(
+		const shared_ptr<ExecutionContext> closure,
+		const shared_ptr<ExecutionContext> context) {
+	auto current = context;
+	while (current) {
+		if (current->m_layout == closure.get()) {
+			return current;
+		}
+
+		current = current->m_parent ? current->m_parent->GetData() : nullptr;
+	}
+
+	return closure;
 }
 
 ExecutionContext::ExecutionContext(const shared_ptr<SymbolContext> context,
@@ -151,11 +251,9 @@ ExecutionContext::ExecutionContext(const shared_ptr<SymbolContext> context,
 		volatile_shared_ptr<TypeTable> type_table, const LifeTime life_time,
 		size_t depth) :
 		SymbolTable(*context), m_parent(parent_context), m_type_table(
-				type_table), m_life_time(life_time), m_depth(depth) {
+				type_table), m_life_time(life_time), m_depth(depth), m_layout(
+				nullptr) {
 	assert(m_type_table);
-	if (m_parent && m_parent->GetData()) {
-		assert(m_type_table != m_parent->GetData()->GetTypeTable());
-	}
 }
 
 ExecutionContext::ExecutionContext(const Modifier::Type modifiers,
@@ -164,11 +262,9 @@ ExecutionContext::ExecutionContext(const Modifier::Type modifiers,
 		volatile_shared_ptr<TypeTable> type_table, const LifeTime life_time,
 		size_t depth) :
 		SymbolTable(modifiers, symbol_map), m_parent(parent_context), m_type_table(
-				type_table), m_life_time(life_time), m_depth(depth) {
+				type_table), m_life_time(life_time), m_depth(depth), m_layout(
+				nullptr) {
 	assert(m_type_table);
-	if (m_parent && m_parent->GetData()) {
-		assert(m_type_table != m_parent->GetData()->GetTypeTable());
-	}
 }
 
 ExecutionContext::~ExecutionContext() {
@@ -225,15 +321,6 @@ const shared_ptr<ExecutionContext> ExecutionContext::GetEmptyChild(
 void ExecutionContext::WeakenReferences() {
 	if ((GetModifiers() & Modifier::MUTABLE) == Modifier::MUTABLE
 			&& GetLifeTime() != ROOT) {
-		auto symbol_table = GetTable();
-
-		symbol_map::iterator it;
-		for (it = symbol_table->begin(); it != symbol_table->end(); it++) {
-			auto symbol = it->second;
-			if (symbol->IsWeakenable()) {
-				auto new_symbol = Symbol::WeakenReference(symbol);
-				it->second = new_symbol;
-			}
-		}
+		GetTable()->WeakenReferences();
 	}
 }
@@ -23,6 +23,7 @@
 #include <defaults.h>
 #include <symbol_table.h>
 #include <search_type.h>
+#include <lexical_address.h>
 #include <modifier.h>
 
 class TypeTable;
@@ -55,6 +56,11 @@ public:
 			const ExecutionContextListRef parent_context,
 			volatile_shared_ptr<TypeTable> type_table, const LifeTime life_time,
 			size_t depth);
+	ExecutionContext(const Modifier::Type modifiers,
+			const shared_ptr<symbol_map>,
+			const ExecutionContextListRef parent_context,
+			volatile_shared_ptr<TypeTable> type_table, const LifeTime life_time,
+			size_t depth);
 	virtual ~ExecutionContext();
 
 	static const shared_ptr<ExecutionContext> GetEmptyChild(
@@ -72,10 +78,51 @@ public:
 			volatile_shared_ptr<TypeTable> type_table,
 			const shared_ptr<symbol_map> map);
 
+	/**
+	 * Create the context for a single function invocation: a copy of the
+	 * variant's symbols, parented to the function's closure, sharing the
+	 * closure's type table.
+	 *
+	 * The context and its symbol table are drawn from a FramePool, as they are
+	 * typically released when the invocation returns.
+	 */
+	static const shared_ptr<ExecutionContext> GetFrame(
+			const shared_ptr<ExecutionContext> variant_context,
+			const shared_ptr<ExecutionContext> closure, const size_t depth);
+
+	/**
+	 * Create the context for a single execution of a block: a copy of the
+	 * symbols and types laid out when the block was preprocessed, parented to
+	 * the given context.
+	 *
+	 * The source is a layout, filled in during preprocessing and only read
+	 * afterwards, so any number of executions (possibly on different threads)
+	 * may be instantiated from it at once.
+	 */
 	static const shared_ptr<ExecutionContext> GetRuntimeInstance(
 			const shared_ptr<ExecutionContext> source,
 			const shared_ptr<ExecutionContext> parent);
 
+	/**
+	 * Create the context for a single execution of a program: a copy of the
+	 * top-level symbols laid out when the program was preprocessed, with the
+	 * same parent (the builtins) and types.
+	 */
+	static const shared_ptr<ExecutionContext> GetRootInstance(
+			const shared_ptr<ExecutionContext> source);
+
+	/**
+	 * Resolve a function's closure against the context it is invoked from.
+	 *
+	 * Functions built during preprocessing (e.g. record member defaults) close
+	 * over the program's layout; if the invoking context runs in an instance of
+	 * that layout, the instance is returned instead, so that such functions see
+	 * the symbols of the current execution.
+	 */
+	static const shared_ptr<ExecutionContext> ResolveClosure(
+			const shared_ptr<ExecutionContext> closure,
+			const shared_ptr<ExecutionContext> context);
+
 	const shared_ptr<ExecutionContext> WithContents(
 			const shared_ptr<SymbolContext> contents) const;
 
@@ -91,6 +138,14 @@ public:
 		return m_depth;
 	}
 
+	/**
+	 * Set the invocation depth of this context. Used when a tail call replaces
+	 * its caller's frame, so that the callee runs at the caller's depth.
+	 */
+	void SetDepth(const size_t depth) {
+		m_depth = depth;
+	}
+
 	volatile_shared_ptr<TypeTable> GetTypeTable() const {
 		return m_type_table;
 	}
@@ -106,6 +161,14 @@ public:
 	const_shared_ptr<Symbol> GetSymbol(const std::string& identifier,
 			const SearchType search_type) const;
 
+	/**
+	 * Look up a symbol by lexical address. If the address does not hold a symbol
+	 * of the given name, fall back to a deep search by name and update the
+	 * address to point at the result.
+	 */
+	const_shared_ptr<Symbol> GetSymbol(const std::string& identifier,
+			LexicalAddress& address) const;
+
 	const void print(ostream &os, const TypeTable& type_table,
 			const Indent& indent, const SearchType search_type = SHALLOW) const;
 
@@ -113,18 +176,11 @@ public:
 
 	void WeakenReferences();
 
-protected:
 	virtual SetResult SetSymbol(const std::string& identifier,
-			const_shared_ptr<TypeSpecifier> type, const_shared_ptr<void> value,
+			const_shared_ptr<TypeSpecifier> type, const Value& value,
 			const TypeTable& type_table);
 
 private:
-	ExecutionContext(const Modifier::Type modifiers,
-			const shared_ptr<symbol_map>,
-			const ExecutionContextListRef parent_context,
-			volatile_shared_ptr<TypeTable> type_table, const LifeTime life_time,
-			size_t depth);
-
 	ExecutionContext(const shared_ptr<SymbolContext> context,
 			const ExecutionContextListRef parent_context,
 			volatile_shared_ptr<TypeTable> type_table, const LifeTime life_time,
@@ -134,6 +190,7 @@ private:
 	volatile_shared_ptr<TypeTable> m_type_table;
 	const LifeTime m_life_time;
 	size_t m_depth;
+	const ExecutionContext* m_layout;
 };
 
 #endif /* EXECUTION_CONTEXT_H_ */
@@ -26,9 +26,6 @@ shared_ptr<ExecutionContextList> ExecutionContextList::From(
 	assert(context);
 	if (context_parent) {
 		assert(context != context_parent->GetData());
-		assert(
-				context->GetTypeTable()
-						!= context_parent->GetData()->GetTypeTable());
 	}
 
 	switch (context->GetLifeTime()) {
@@ -43,42 +43,42 @@ const_shared_ptr<Result> ArithmeticExpression::compute(const int& left,
 		yy::location right_location) const {
 	ErrorListRef errors = ErrorList::GetTerminator();
 
-	int* result = new int;
+	int result = 0;
 	switch (GetOperator()) {
 	case PLUS:
-		*result = left + right;
+		result = left + right;
 		break;
 	case MULTIPLY:
-		*result = left * right;
+		result = left * right;
 		break;
 	case DIVIDE:
 		if (right == 0) {
 			errors = ErrorList::From(
 					make_shared<Error>(Error::SEMANTIC, Error::DIVIDE_BY_ZERO,
 							right_location.begin), errors);
-			*result = 0;
+			result = 0;
 		} else {
-			*result = left / right;
+			result = left / right;
 		}
 		break;
 	case MINUS:
-		*result = left - right;
+		result = left - right;
 		break;
 	case MOD:
 		if (right == 0) {
 			errors = ErrorList::From(
 					make_shared<Error>(Error::SEMANTIC, Error::MOD_BY_ZERO,
 							right_location.begin), errors);
-			*result = 0;
+			result = 0;
 		} else {
-			*result = left % right;
+			result = left % right;
 		}
 		break;
 	default:
 		break;
 	}
 
-	return make_shared<Result>(const_shared_ptr<const void>(result), errors);
+	return make_shared<Result>(Value(result), errors);
 }
 
 const_shared_ptr<Result> ArithmeticExpression::compute(const double& left,
@@ -86,32 +86,32 @@ const_shared_ptr<Result> ArithmeticExpression::compute(const double& left,
 		yy::location right_location) const {
 	ErrorListRef errors = ErrorList::GetTerminator();
 
-	double* result = new double;
+	double result = 0;
 	switch (GetOperator()) {
 	case PLUS:
-		*result = left + right;
+		result = left + right;
 		break;
 	case MULTIPLY:
-		*result = left * right;
+		result = left * right;
 		break;
 	case DIVIDE:
 		if (right == 0.0) {
 			errors = ErrorList::From(
 					make_shared<Error>(Error::SEMANTIC, Error::DIVIDE_BY_ZERO,
 							right_location.begin), errors);
-			*result = 0;
+			result = 0;
 		} else {
-			*result = left / right;
+			result = left / right;
 		}
 		break;
 	case MINUS:
-		*result = left - right;
+		result = left - right;
 		break;
 	default:
 		break;
 	}
 
-	return make_shared<Result>(const_shared_ptr<const void>(result), errors);
+	return make_shared<Result>(Value(result), errors);
 }
 
 const_shared_ptr<Result> ArithmeticExpression::compute(const std::uint8_t& left,
@@ -119,32 +119,32 @@ const_shared_ptr<Result> ArithmeticExpression::compute(const std::uint8_t& left,
 		yy::location right_location) const {
 	ErrorListRef errors = ErrorList::GetTerminator();
 
-	uint8_t* result = new uint8_t;
+	uint8_t result = 0;
 	switch (GetOperator()) {
 	case PLUS:
-		*result = left + right;
+		result = left + right;
 		break;
 	case MULTIPLY:
-		*result = left * right;
+		result = left * right;
 		break;
 	case DIVIDE:
 		if (right == 0.0) {
 			errors = ErrorList::From(
 					make_shared<Error>(Error::SEMANTIC, Error::DIVIDE_BY_ZERO,
 							right_location.begin), errors);
-			*result = 0;
+			result = 0;
 		} else {
-			*result = left / right;
+			result = left / right;
 		}
 		break;
 	case MINUS:
-		*result = left - right;
+		result = left - right;
 		break;
 	default:
 		break;
 	}
 
-	return make_shared<Result>(const_shared_ptr<const void>(result), errors);
+	return make_shared<Result>(Value(result), errors);
 }
 
 const_shared_ptr<Result> ArithmeticExpression::compute(const string& left,
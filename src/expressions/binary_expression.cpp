@@ -20,11 +20,13 @@
 #include "binary_expression.h"
 #include "error.h"
 #include <execution_context.h>
+#include <optimizer.h>
 
 BinaryExpression::BinaryExpression(const yy::location position,
 		const OperatorType op, const_shared_ptr<Expression> left,
 		const_shared_ptr<Expression> right) :
-		Expression(position), m_operator(op), m_left(left), m_right(right) {
+		Expression(position), m_operator(op), m_left(left), m_right(right), m_left_type(
+				NONE), m_right_type(NONE) {
 	assert(left != NULL);
 	assert(right != NULL);
 }
@@ -93,6 +95,10 @@ TypedResult<TypeSpecifier> BinaryExpression::ComputeResultType(
 const_shared_ptr<Result> BinaryExpression::Evaluate(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure) const {
+	if (m_folded) {
+		return m_folded;
+	}
+
 	ErrorListRef errors = ErrorList::GetTerminator();
 	const_shared_ptr<Expression> left = GetLeft();
 	const_shared_ptr<Expression> right = GetRight();
@@ -107,220 +113,103 @@ const_shared_ptr<Result> BinaryExpression::Evaluate(
 		return right_result;
 	}
 
-	auto left_type_specifier_result = left->GetTypeSpecifier(context);
-	auto right_type_specifier_result = right->GetTypeSpecifier(context);
+	auto left_type = m_left_type.load(std::memory_order_relaxed);
+	auto right_type = m_right_type.load(std::memory_order_relaxed);
+	if (left_type == NONE || right_type == NONE) {
+		// operand types are static, so they only need to be resolved once
+		auto left_type_specifier_result = left->GetTypeSpecifier(context);
+		auto right_type_specifier_result = right->GetTypeSpecifier(context);
 
-	errors = left_type_specifier_result.GetErrors();
-	if (ErrorList::IsTerminator(errors)) {
-		errors = right_type_specifier_result.GetErrors();
+		errors = left_type_specifier_result.GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
-			yy::location left_position = left->GetLocation();
-			yy::location right_position = right->GetLocation();
-
-			auto type_table = context->GetTypeTable();
-
-			auto left_type = left_type_specifier_result.GetData();
-			auto right_type = right_type_specifier_result.GetData();
-
-			// This logic is essentially a big muxer.
-			// It works in tandem with C++ type widening to convert operands to the same data type
-			if (left_type->AnalyzeAssignmentTo(
-					PrimitiveTypeSpecifier::GetBoolean(), type_table)
-					== EQUIVALENT) {
-				bool left_value = *(left_result->GetData<bool>());
-
-				if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetBoolean(), type_table)
-						== EQUIVALENT) {
-					bool right_value = *(right_result->GetData<bool>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetByte(), type_table)
-						== EQUIVALENT) {
-					auto right_value = *(right_result->GetData<std::uint8_t>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetInt(), type_table)
-						== EQUIVALENT) {
-					int right_value = *(right_result->GetData<int>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetDouble(), type_table)
-						== EQUIVALENT) {
-					double right_value = *(right_result->GetData<double>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetString(), type_table)
-						== EQUIVALENT) {
-					string right_value = *(right_result->GetData<string>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else {
-					assert(false);
-				}
-			} else if (left_type->AnalyzeAssignmentTo(
-					PrimitiveTypeSpecifier::GetByte(), type_table)
-					== EQUIVALENT) {
-				auto left_value = *(left_result->GetData<std::uint8_t>());
-
-				if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetBoolean(), type_table)
-						== EQUIVALENT) {
-					bool right_value = *(right_result->GetData<bool>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetByte(), type_table)
-						== EQUIVALENT) {
-					auto right_value = *(right_result->GetData<std::uint8_t>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetInt(), type_table)
-						== EQUIVALENT) {
-					int right_value = *(right_result->GetData<int>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetDouble(), type_table)
-						== EQUIVALENT) {
-					double right_value = *(right_result->GetData<double>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetString(), type_table)
-						== EQUIVALENT) {
-					string right_value = *(right_result->GetData<string>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else {
-					assert(false);
-				}
-			} else if (left_type->AnalyzeAssignmentTo(
-					PrimitiveTypeSpecifier::GetInt(), type_table)
-					== EQUIVALENT) {
-				int left_value = *(left_result->GetData<int>());
-
-				if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetBoolean(), type_table)
-						== EQUIVALENT) {
-					bool right_value = *(right_result->GetData<bool>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetByte(), type_table)
-						== EQUIVALENT) {
-					auto right_value = *(right_result->GetData<std::uint8_t>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetInt(), type_table)
-						== EQUIVALENT) {
-					int right_value = *(right_result->GetData<int>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetDouble(), type_table)
-						== EQUIVALENT) {
-					double right_value = *(right_result->GetData<double>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetString(), type_table)
-						== EQUIVALENT) {
-					string right_value = *(right_result->GetData<string>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else {
-					assert(false);
-				}
-			} else if (left_type->AnalyzeAssignmentTo(
-					PrimitiveTypeSpecifier::GetDouble(), type_table)
-					== EQUIVALENT) {
-				double left_value = *(left_result->GetData<double>());
-
-				if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetBoolean(), type_table)
-						== EQUIVALENT) {
-					bool right_value = *(right_result->GetData<bool>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetByte(), type_table)
-						== EQUIVALENT) {
-					auto right_value = *(right_result->GetData<std::uint8_t>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetInt(), type_table)
-						== EQUIVALENT) {
-					int right_value = *(right_result->GetData<int>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetDouble(), type_table)
-						== EQUIVALENT) {
-					double right_value = *(right_result->GetData<double>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetString(), type_table)
-						== EQUIVALENT) {
-					string right_value = *(right_result->GetData<string>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else {
-					assert(false);
-				}
-			} else if (left_type->AnalyzeAssignmentTo(
-					PrimitiveTypeSpecifier::GetString(), type_table)
-					== EQUIVALENT) {
-				string left_value = *(left_result->GetData<string>());
-
-				if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetBoolean(), type_table)
-						== EQUIVALENT) {
-					bool right_value = *(right_result->GetData<bool>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetByte(), type_table)
-						== EQUIVALENT) {
-					auto right_value = *(right_result->GetData<std::uint8_t>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetInt(), type_table)
-						== EQUIVALENT) {
-					int right_value = *(right_result->GetData<int>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetDouble(), type_table)
-						== EQUIVALENT) {
-					double right_value = *(right_result->GetData<double>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else if (right_type->AnalyzeAssignmentTo(
-						PrimitiveTypeSpecifier::GetString(), type_table)
-						== EQUIVALENT) {
-					string right_value = *(right_result->GetData<string>());
-					return compute(left_value, right_value, left_position,
-							right_position);
-				} else {
-					assert(false);
-				}
-			} else {
-				assert(false);
-			}
+			errors = right_type_specifier_result.GetErrors();
+		}
+
+		if (!ErrorList::IsTerminator(errors)) {
+			return make_shared<Result>(nullptr, errors);
 		}
+
+		auto type_table = context->GetTypeTable();
+		left_type = GetOperandType(left_type_specifier_result.GetData(),
+				type_table);
+		right_type = GetOperandType(right_type_specifier_result.GetData(),
+				type_table);
+		m_left_type.store(left_type, std::memory_order_relaxed);
+		m_right_type.store(right_type, std::memory_order_relaxed);
+	}
+
+	yy::location left_position = left->GetLocation();
+	yy::location right_position = right->GetLocation();
+
+	switch (left_type) {
+	case BOOLEAN:
+		return compute(left_result->GetTaggedValue().As<bool>(), *right_result,
+				right_type, left_position, right_position);
+	case BYTE:
+		return compute(left_result->GetTaggedValue().As<std::uint8_t>(),
+				*right_result, right_type, left_position, right_position);
+	case INT:
+		return compute(left_result->GetTaggedValue().As<int>(), *right_result,
+				right_type, left_position, right_position);
+	case DOUBLE:
+		return compute(left_result->GetTaggedValue().As<double>(), *right_result,
+				right_type, left_position, right_position);
+	case STRING:
+		return compute(*(left_result->GetData<string>()), *right_result,
+				right_type, left_position, right_position);
+	default:
+		assert(false);
+		return make_shared<Result>(nullptr, errors);
+	}
+}
+
+const BasicType BinaryExpression::GetOperandType(
+		const_shared_ptr<TypeSpecifier> type_specifier,
+		volatile_shared_ptr<TypeTable> type_table) {
+	// This logic works in tandem with C++ type widening to convert operands to the same data type
+	if (type_specifier->AnalyzeAssignmentTo(
+			PrimitiveTypeSpecifier::GetBoolean(), *type_table) == EQUIVALENT) {
+		return BOOLEAN;
+	} else if (type_specifier->AnalyzeAssignmentTo(
+			PrimitiveTypeSpecifier::GetByte(), *type_table) == EQUIVALENT) {
+		return BYTE;
+	} else if (type_specifier->AnalyzeAssignmentTo(
+			PrimitiveTypeSpecifier::GetInt(), *type_table) == EQUIVALENT) {
+		return INT;
+	} else if (type_specifier->AnalyzeAssignmentTo(
+			PrimitiveTypeSpecifier::GetDouble(), *type_table) == EQUIVALENT) {
+		return DOUBLE;
+	} else if (type_specifier->AnalyzeAssignmentTo(
+			PrimitiveTypeSpecifier::GetString(), *type_table) == EQUIVALENT) {
+		return STRING;
+	} else {
+		return NONE;
 	}
+}
 
-	return make_shared<Result>(nullptr, errors);
+template<class T> const_shared_ptr<Result> BinaryExpression::compute(
+		const T& left, const Result& right, const BasicType right_type,
+		yy::location left_position, yy::location right_position) const {
+	switch (right_type) {
+	case BOOLEAN:
+		return compute(left, right.GetTaggedValue().As<bool>(), left_position,
+				right_position);
+	case BYTE:
+		return compute(left, right.GetTaggedValue().As<std::uint8_t>(),
+				left_position, right_position);
+	case INT:
+		return compute(left, right.GetTaggedValue().As<int>(), left_position,
+				right_position);
+	case DOUBLE:
+		return compute(left, right.GetTaggedValue().As<double>(), left_position,
+				right_position);
+	case STRING:
+		return compute(left, *(right.GetData<string>()), left_position,
+				right_position);
+	default:
+		assert(false);
+		return make_shared<Result>(nullptr, ErrorList::GetTerminator());
+	}
 }
 
 TypedResult<TypeSpecifier> BinaryExpression::GetTypeSpecifier(
@@ -347,7 +236,7 @@ const ErrorListRef BinaryExpression::Validate(
 		if (ErrorList::IsTerminator(left_type_specifier_errors)) {
 			auto left_type_specifier = left_type_specifier_result.GetData();
 			auto left_analysis = left_type_specifier->AnalyzeAssignmentTo(
-					valid_left, execution_context->GetTypeTable());
+					valid_left, *execution_context->GetTypeTable());
 			if (left_analysis != EQUIVALENT && left_analysis != UNAMBIGUOUS) {
 				errors = ErrorList::From(
 						make_shared<Error>(Error::SEMANTIC,
@@ -372,7 +261,7 @@ const ErrorListRef BinaryExpression::Validate(
 		if (ErrorList::IsTerminator(right_type_specifier_errors)) {
 			auto right_type_specifier = right_type_specifier_result.GetData();
 			auto right_analysis = right_type_specifier->AnalyzeAssignmentTo(
-					valid_right, execution_context->GetTypeTable());
+					valid_right, *execution_context->GetTypeTable());
 			if (right_analysis != EQUIVALENT && right_analysis != UNAMBIGUOUS) {
 				errors = ErrorList::From(
 						make_shared<Error>(Error::SEMANTIC,
@@ -388,6 +277,10 @@ const ErrorListRef BinaryExpression::Validate(
 		errors = ErrorList::Concatenate(errors, right_errors);
 	}
 
+	if (ErrorList::IsTerminator(errors) && !m_folded) {
+		m_folded = Optimizer::Fold(*this, execution_context);
+	}
+
 	return errors;
 }
 
@@ -20,6 +20,7 @@
 #ifndef BINARY_EXPRESSION_H_
 #define BINARY_EXPRESSION_H_
 
+#include <atomic>
 #include "expression.h"
 
 class Error;
@@ -134,9 +135,28 @@ protected:
 			yy::location right_position) const = 0;
 
 private:
+	static const BasicType GetOperandType(
+			const_shared_ptr<TypeSpecifier> type_specifier,
+			volatile_shared_ptr<TypeTable> type_table);
+
+	template<class T> const_shared_ptr<Result> compute(const T& left,
+			const Result& right, const BasicType right_type,
+			yy::location left_position, yy::location right_position) const;
+
 	const OperatorType m_operator;
 	const_shared_ptr<Expression> m_left;
 	const_shared_ptr<Expression> m_right;
+	/**
+	 * Operand types, resolved on first evaluation. Every thread resolves the
+	 * same types, so a racing store is harmless.
+	 */
+	mutable std::atomic<BasicType> m_left_type;
+	mutable std::atomic<BasicType> m_right_type;
+
+	/**
+	 * The value of this expression, if it was folded during validation.
+	 */
+	mutable plain_shared_ptr<Result> m_folded;
 }
 ;
 
@@ -71,15 +71,19 @@ const_shared_ptr<Result> CloseExpression::Evaluate(
 			}
 			map->erase(handle_entry);
 		}
+
+		// views of a mapped file keep the mapping alive after this
+		Builtins::get_mapped_file_map()->erase(*file_handle);
 	}
 
 	auto type_table = closure->GetTypeTable();
 	auto error_list_type = type_table->GetType<TypeDefinition>(
 			Builtins::get_error_list_type_specifier(), DEEP);
 	auto terminator = static_pointer_cast<const Record>(
-			error_list_type->GetDefaultValue(type_table));
+			error_list_type->GetDefaultValue(*type_table));
 	if (result_code == 0) {
-		auto result = make_shared<Sum>(TypeTable::GetNilName(), terminator);
+		auto result = make_shared<Sum>(TypeTable::GetNilName(),
+				TypeTable::GetNilTagId(), terminator);
 		return make_shared<Result>(result, errors);
 	} else {
 		auto error_symbol_map = make_shared<symbol_map>();
@@ -107,7 +111,7 @@ const_shared_ptr<Result> CloseExpression::Evaluate(
 		assert(insert_result.second);
 
 		auto error_list_sum = make_shared<Sum>(TypeTable::GetNilName(),
-				terminator);
+				TypeTable::GetNilTagId(), terminator);
 		insert_result = error_list_symbol_map->insert(
 				std::pair<const string, const_shared_ptr<Symbol>>(
 						*Builtins::ERROR_LIST_NEXT_NAME,
@@ -121,7 +125,7 @@ const_shared_ptr<Result> CloseExpression::Evaluate(
 		auto error_list = make_shared<Record>(error_list_symbol_table);
 
 		auto result = make_shared<Sum>(MaybeTypeSpecifier::VARIANT_NAME,
-				error_list);
+				MaybeTypeSpecifier::VARIANT_TAG_ID, error_list);
 		return make_shared<Result>(result, errors);
 	}
 }
@@ -175,7 +179,7 @@ const ErrorListRef CloseExpression::Validate(
 					auto specifier = PrimitiveTypeSpecifier::GetInt();
 					auto assignability =
 							argument_type_specifier->AnalyzeAssignmentTo(
-									specifier, type_table);
+									specifier, *type_table);
 					if (assignability == AnalysisResult::AMBIGUOUS) {
 						errors =
 								ErrorList::From(
@@ -52,12 +52,12 @@ const_shared_ptr<Result> ComparisonExpression::compute(const bool& left,
 	switch (GetOperator()) {
 	case EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left == right)),
+				Value(left == right),
 				ErrorList::GetTerminator());
 		break;
 	case NOT_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left != right)),
+				Value(left != right),
 				ErrorList::GetTerminator());
 		break;
 	case LESS_THAN:
@@ -81,28 +81,28 @@ const_shared_ptr<Result> ComparisonExpression::compute(const int& left,
 	switch (GetOperator()) {
 	case EQUAL: {
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left == right)),
+				Value(left == right),
 				ErrorList::GetTerminator());
 	}
 	case NOT_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left != right)),
+				Value(left != right),
 				ErrorList::GetTerminator());
 	case LESS_THAN:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left < right)),
+				Value(left < right),
 				ErrorList::GetTerminator());
 	case LESS_THAN_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left <= right)),
+				Value(left <= right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left > right)),
+				Value(left > right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left >= right)),
+				Value(left >= right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
@@ -118,27 +118,27 @@ const_shared_ptr<Result> ComparisonExpression::compute(const double& left,
 	switch (GetOperator()) {
 	case EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left == right)),
+				Value(left == right),
 				ErrorList::GetTerminator());
 	case NOT_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left != right)),
+				Value(left != right),
 				ErrorList::GetTerminator());
 	case LESS_THAN:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left < right)),
+				Value(left < right),
 				ErrorList::GetTerminator());
 	case LESS_THAN_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left <= right)),
+				Value(left <= right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left > right)),
+				Value(left > right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left >= right)),
+				Value(left >= right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
@@ -154,27 +154,27 @@ const_shared_ptr<Result> ComparisonExpression::compute(const std::uint8_t& left,
 	switch (GetOperator()) {
 	case EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left == right)),
+				Value(left == right),
 				ErrorList::GetTerminator());
 	case NOT_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left != right)),
+				Value(left != right),
 				ErrorList::GetTerminator());
 	case LESS_THAN:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left < right)),
+				Value(left < right),
 				ErrorList::GetTerminator());
 	case LESS_THAN_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left <= right)),
+				Value(left <= right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left > right)),
+				Value(left > right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left >= right)),
+				Value(left >= right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
@@ -190,27 +190,27 @@ const_shared_ptr<Result> ComparisonExpression::compute(const string& left,
 	switch (GetOperator()) {
 	case EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left == right)),
+				Value(left == right),
 				ErrorList::GetTerminator());
 	case NOT_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left != right)),
+				Value(left != right),
 				ErrorList::GetTerminator());
 	case LESS_THAN:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left < right)),
+				Value(left < right),
 				ErrorList::GetTerminator());
 	case LESS_THAN_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left <= right)),
+				Value(left <= right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left > right)),
+				Value(left > right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN_EQUAL:
 		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left >= right)),
+				Value(left >= right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
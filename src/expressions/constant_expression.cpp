@@ -71,6 +71,10 @@ TypedResult<TypeSpecifier> ConstantExpression::GetTypeSpecifier(
 const_shared_ptr<Result> ConstantExpression::Evaluate(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure) const {
+	if (m_result) {
+		return m_result;
+	}
+
 	return make_shared<Result>(m_value, ErrorList::GetTerminator());
 }
 
@@ -112,7 +116,9 @@ const_shared_ptr<Result> ConstantExpression::GetConstantExpression(
 
 ConstantExpression::ConstantExpression(const yy::location position,
 		const_shared_ptr<TypeSpecifier> type, const_shared_ptr<void> value) :
-		Expression(position), m_type(type), m_value(value) {
+		Expression(position), m_type(type), m_value(value), m_result(
+				value ? make_shared<Result>(value, ErrorList::GetTerminator()) :
+						nullptr) {
 }
 
 const ErrorListRef ConstantExpression::Validate(
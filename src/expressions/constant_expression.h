@@ -68,6 +68,11 @@ private:
 			const_shared_ptr<const void> value);
 	const_shared_ptr<TypeSpecifier> m_type;
 	const_shared_ptr<void> m_value;
+
+	/**
+	 * Results are immutable, so every evaluation can share one.
+	 */
+	const_shared_ptr<Result> m_result;
 };
 
 #endif /* EXPRESSIONS_CONSTANT_EXPRESSION_H_ */
@@ -46,7 +46,7 @@ TypedResult<string> Expression::ToString(
 		if (ErrorList::IsTerminator(errors)) {
 			auto type_specifier = type_specifier_result.GetData();
 			auto type_result = type_specifier->GetType(
-					execution_context->GetTypeTable(),
+					*execution_context->GetTypeTable(),
 					AliasResolution::RESOLVE);
 
 			errors = type_result->GetErrors();
@@ -56,32 +56,17 @@ TypedResult<string> Expression::ToString(
 						const PrimitiveType>(type);
 				if (as_primitive) {
 					const BasicType basic_type = as_primitive->GetType();
-					switch (basic_type) {
-					case BOOLEAN:
-						buffer << *(evaluation->GetData<bool>());
-						break;
-					case BYTE: {
-						buffer << std::hex << uppercase
-								<< unsigned(
-										*(evaluation->GetData<std::uint8_t>()));
-						break;
-					}
-					case INT:
-						buffer << *(evaluation->GetData<int>());
-						break;
-					case DOUBLE:
-						buffer << *(evaluation->GetData<double>());
-						break;
-					case STRING:
+					if (basic_type == STRING) {
 						buffer << *(evaluation->GetData<string>());
-						break;
-					default:
-						assert(false);
+					} else {
+						buffer
+								<< ToString(basic_type,
+										evaluation->GetTaggedValue());
 					}
 				} else {
 					buffer
 							<< type->ValueToString(
-									execution_context->GetTypeTable(),
+									*execution_context->GetTypeTable(),
 									Indent(0), evaluation->GetRawData());
 				}
 			}
@@ -93,3 +78,25 @@ TypedResult<string> Expression::ToString(
 	return TypedResult<string>(
 			const_shared_ptr<string>(new string(buffer.str())), errors);
 }
+
+const string Expression::ToString(const BasicType type, const Value& value) {
+	ostringstream buffer;
+	switch (type) {
+	case BOOLEAN:
+		buffer << value.As<bool>();
+		break;
+	case BYTE:
+		buffer << std::hex << uppercase << unsigned(value.As<std::uint8_t>());
+		break;
+	case INT:
+		buffer << value.As<int>();
+		break;
+	case DOUBLE:
+		buffer << value.As<double>();
+		break;
+	default:
+		assert(false);
+	}
+
+	return buffer.str();
+}
@@ -52,6 +52,11 @@ public:
 	TypedResult<string> ToString(
 			const shared_ptr<ExecutionContext> execution_context) const;
 
+	/**
+	 * Format a boolean, byte, int or double value the way ToString does.
+	 */
+	static const string ToString(const BasicType type, const Value& value);
+
 	virtual const bool IsConstant() const = 0;
 
 	virtual const ErrorListRef Validate(
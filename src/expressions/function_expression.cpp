@@ -86,7 +86,7 @@ const ErrorListRef FunctionExpression::Validate(
 					duplication_subject_variant->GetDeclaration();
 			auto assignment_result =
 					duplication_subject_declaration->AnalyzeAssignmentTo(
-							declaration, execution_context->GetTypeTable());
+							declaration, *execution_context->GetTypeTable());
 
 			if (assignment_result == EQUIVALENT) {
 				ostringstream out;
@@ -157,7 +157,7 @@ const ErrorListRef FunctionExpression::Validate(
 			if (ErrorList::IsTerminator(errors)
 					&& return_type_specifier->AnalyzeAssignmentTo(
 							TypeTable::GetNilTypeSpecifier(),
-							execution_context->GetTypeTable()) != EQUIVALENT) {
+							*execution_context->GetTypeTable()) != EQUIVALENT) {
 				// we have a non-nil return type and no other errors; check return coverage
 				if (body_process_result.GetReturnCoverage()
 						!= PreprocessResult::ReturnCoverage::FULL) {
@@ -76,24 +76,36 @@ const_shared_ptr<Result> GetByteExpression::Evaluate(
 				}
 			}
 		}
+
+		auto mapped_files = Builtins::get_mapped_file_map();
+		auto mapped_entry = mapped_files->find(*file_handle);
+		if (mapped_entry != mapped_files->end()) {
+			auto handle = mapped_entry->second;
+			if (handle->position < handle->file->GetSize()) {
+				value = handle->file->GetData()[handle->position++];
+			} else {
+				at_eof = true;
+			}
+		}
 	}
 
 	auto type_table = closure->GetTypeTable();
 	auto error_list_type = type_table->GetType<TypeDefinition>(
 			Builtins::get_error_list_type_specifier(), DEEP);
 	auto terminator = static_pointer_cast<const Record>(
-			error_list_type->GetDefaultValue(type_table));
+			error_list_type->GetDefaultValue(*type_table));
 	if (at_eof) {
 		auto value =
 				Builtins::get_byte_read_result_eof_type_specifier()->GetType(
-						type_table, RETURN)->GetData<UnitType>()->GetDefaultValue(
-						type_table);
+						*type_table, RETURN)->GetData<UnitType>()
+						->GetDefaultValue(*type_table);
 		auto result = make_shared<Sum>(Builtins::BYTE_READ_RESULT_EOF_NAME,
-				value);
+				Builtins::BYTE_READ_RESULT_EOF_TAG_ID, value);
 
 		return make_shared<Result>(result, errors);
 	} else if (result_code == 0) {
 		auto result = make_shared<Sum>(Builtins::BYTE_READ_RESULT_DATA_NAME,
+				Builtins::BYTE_READ_RESULT_DATA_TAG_ID,
 				make_shared<std::uint8_t>(value));
 
 		return make_shared<Result>(result, errors);
@@ -123,9 +135,9 @@ const_shared_ptr<Result> GetByteExpression::Evaluate(
 		assert(insert_result.second);
 
 		auto terminator = static_pointer_cast<const Record>(
-				error_list_type->GetDefaultValue(type_table));
+				error_list_type->GetDefaultValue(*type_table));
 		auto error_list_sum = make_shared<Sum>(TypeTable::GetNilName(),
-				terminator);
+				TypeTable::GetNilTagId(), terminator);
 		insert_result = error_list_symbol_map->insert(
 				std::pair<const string, const_shared_ptr<Symbol>>(
 						*Builtins::ERROR_LIST_NEXT_NAME,
@@ -139,7 +151,7 @@ const_shared_ptr<Result> GetByteExpression::Evaluate(
 		auto error_list = make_shared<Record>(error_list_symbol_table);
 
 		auto result = make_shared<Sum>(Builtins::BYTE_READ_RESULT_ERRORS_NAME,
-				error_list);
+				Builtins::BYTE_READ_RESULT_ERRORS_TAG_ID, error_list);
 		return make_shared<Result>(result, errors);
 	}
 }
@@ -193,7 +205,7 @@ const ErrorListRef GetByteExpression::Validate(
 					auto specifier = PrimitiveTypeSpecifier::GetInt();
 					auto assignability =
 							argument_type_specifier->AnalyzeAssignmentTo(
-									specifier, type_table);
+									specifier, *type_table);
 					if (assignability == AnalysisResult::AMBIGUOUS) {
 						errors =
 								ErrorList::From(
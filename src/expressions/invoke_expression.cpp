@@ -31,6 +31,7 @@
 #include <location.hh>
 #include <modifier.h>
 #include <position.hh>
+#include <profiler.h>
 #include <primitive_type_specifier.h>
 #include <record_type_specifier.h>
 #include <result.h>
@@ -44,20 +45,24 @@
 #include <builtins.h>
 #include <variable_expression.h>
 #include <variable.h>
+#include <member_variable.h>
 #include <open_expression.h>
 #include <close_expression.h>
 #include <get_byte_expression.h>
 #include <put_byte_expression.h>
+#include <read_bytes_expression.h>
+#include <write_bytes_expression.h>
 
 const vector<string> InvokeExpression::BuiltinFunctionList = vector<string> {
-		"open", "close", "get", "put" };
+		"open", "close", "get", "put", "read_bytes", "write_bytes" };
 
 InvokeExpression::InvokeExpression(const yy::location position,
 		const_shared_ptr<Expression> expression,
 		const ArgumentListRef argument_list,
 		const yy::location argument_list_location) :
 		Expression(position), m_expression(expression), m_argument_list(
-				argument_list), m_argument_list_location(argument_list_location) {
+				argument_list), m_argument_list_location(argument_list_location), m_call_name(
+				GetCallName(expression)) {
 }
 
 InvokeExpression::~InvokeExpression() {
@@ -85,19 +90,24 @@ TypedResult<TypeSpecifier> InvokeExpression::GetTypeSpecifier(
 					const VariantFunctionSpecifier>(expression_type_specifier);
 			if (as_variant_function) {
 				//look up overload
-				auto variant_result = Function::GetVariant(m_argument_list,
-						m_argument_list_location,
-						as_variant_function->GetVariantList(),
-						execution_context);
+				auto variant_list = as_variant_function->GetVariantList();
+				auto variant = m_variant_cache.Get(variant_list);
+				if (!variant) {
+					auto variant_result = Function::GetVariant(m_argument_list,
+							m_argument_list_location, variant_list,
+							execution_context);
+
+					errors = variant_result.GetErrors();
+					if (ErrorList::IsTerminator(errors)) {
+						variant = variant_result.GetData();
+						m_variant_cache.Set(variant_list, variant);
+					}
+				}
 
-				auto variant_result_errors = variant_result.GetErrors();
-				if (ErrorList::IsTerminator(variant_result_errors)) {
-					auto variant = variant_result.GetData();
+				if (ErrorList::IsTerminator(errors)) {
 					auto return_type_specifer =
 							variant->GetDeclaration()->GetReturnTypeSpecifier();
 					result = return_type_specifer;
-				} else {
-					errors = variant_result_errors;
 				}
 
 			} else {
@@ -115,54 +125,59 @@ TypedResult<TypeSpecifier> InvokeExpression::GetTypeSpecifier(
 const_shared_ptr<Result> InvokeExpression::Evaluate(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure) const {
-	plain_shared_ptr<void> value;
-
-	auto type_specifier_result = m_expression->GetTypeSpecifier(context);
-	auto errors = type_specifier_result.GetErrors();
-	if (ErrorList::IsTerminator(errors)) {
-		auto type_specifier = type_specifier_result.GetData();
+	auto function_result = GetFunction(context, closure);
+	auto errors = function_result.GetErrors();
+	if (!ErrorList::IsTerminator(errors)) {
+		return make_shared<Result>(nullptr, errors);
+	}
 
-		shared_ptr<const Function> function = nullptr;
+	auto function = function_result.GetData();
+	Profiler::Frame frame(function->GetLocation(), m_call_name);
+	return function->Evaluate(m_argument_list, m_argument_list_location,
+			context, m_variant_cache);
+}
 
-		const_shared_ptr<FunctionTypeSpecifier> as_function =
-				std::dynamic_pointer_cast<const FunctionTypeSpecifier>(
-						type_specifier);
-		if (as_function) {
-			auto expression_result = m_expression->Evaluate(context, closure);
-			errors = expression_result->GetErrors();
-			if (ErrorList::IsTerminator(errors)) {
-				function = expression_result->GetData<Function>();
-			}
-		}
+const TypedResult<Invocation> InvokeExpression::Bind(
+		const shared_ptr<ExecutionContext> context,
+		const shared_ptr<ExecutionContext> closure) const {
+	auto function_result = GetFunction(context, closure);
+	auto errors = function_result.GetErrors();
+	if (!ErrorList::IsTerminator(errors)) {
+		return TypedResult<Invocation>(nullptr, errors);
+	}
 
-		auto as_variant_function = std::dynamic_pointer_cast<
-				const VariantFunctionSpecifier>(type_specifier);
-		if (as_variant_function) {
-			auto expression_result = m_expression->Evaluate(context, closure);
-			errors = expression_result->GetErrors();
-			if (ErrorList::IsTerminator(errors)) {
-				function = expression_result->GetData<Function>();
-			}
-		}
+	return Function::Bind(function_result.GetData(), m_argument_list,
+			m_argument_list_location, context, m_variant_cache);
+}
 
-		if (function) {
-			if (ErrorList::IsTerminator(errors)) {
-				auto eval_result = function->Evaluate(m_argument_list,
-						m_argument_list_location, context);
+const TypedResult<Function> InvokeExpression::GetFunction(
+		const shared_ptr<ExecutionContext> context,
+		const shared_ptr<ExecutionContext> closure) const {
+	auto type_specifier_result = m_expression->GetTypeSpecifier(context);
+	auto errors = type_specifier_result.GetErrors();
+	if (!ErrorList::IsTerminator(errors)) {
+		return TypedResult<Function>(nullptr, errors);
+	}
 
-				errors = eval_result->GetErrors();
-				if (ErrorList::IsTerminator(errors)) {
-					value = eval_result->GetRawData();
-				}
-			}
-		} else {
-			errors = ErrorList::From(
-					make_shared<Error>(Error::SEMANTIC, Error::NOT_A_FUNCTION,
-							GetLocation().begin), errors);
+	auto type_specifier = type_specifier_result.GetData();
+	plain_shared_ptr<Function> function = nullptr;
+	if (std::dynamic_pointer_cast<const FunctionTypeSpecifier>(type_specifier)
+			|| std::dynamic_pointer_cast<const VariantFunctionSpecifier>(
+					type_specifier)) {
+		auto expression_result = m_expression->Evaluate(context, closure);
+		errors = expression_result->GetErrors();
+		if (ErrorList::IsTerminator(errors)) {
+			function = expression_result->GetData<Function>();
 		}
 	}
 
-	return make_shared<Result>(value, errors);
+	if (!function) {
+		errors = ErrorList::From(
+				make_shared<Error>(Error::SEMANTIC, Error::NOT_A_FUNCTION,
+						GetLocation().begin), errors);
+	}
+
+	return TypedResult<Function>(function, errors);
 }
 
 TypedResult<string> InvokeExpression::ToString(
@@ -297,7 +312,7 @@ const ErrorListRef InvokeExpression::Validate(
 								auto assignment_analysis =
 										argument_type_specifier->AnalyzeAssignmentTo(
 												parameter_type_specifier,
-												execution_context->GetTypeTable());
+												*execution_context->GetTypeTable());
 								if (assignment_analysis == AMBIGUOUS) {
 									errors =
 											ErrorList::From(
@@ -394,9 +409,38 @@ const_shared_ptr<InvokeExpression> InvokeExpression::BuildInvokeExpression(
 		} else if (*variable_name == "put") {
 			return make_shared<PutByteExpression>(location, expression,
 					argument_list, argument_list_location);
+		} else if (*variable_name == "read_bytes") {
+			return make_shared<ReadBytesExpression>(location, expression,
+					argument_list, argument_list_location);
+		} else if (*variable_name == "write_bytes") {
+			return make_shared<WriteBytesExpression>(location, expression,
+					argument_list, argument_list_location);
 		}
 	}
 
 	return make_shared<InvokeExpression>(location, expression, argument_list,
 			argument_list_location);
 }
+
+const string InvokeExpression::GetCallName(
+		const_shared_ptr<Expression> expression) {
+	auto variable_expression = dynamic_pointer_cast<const VariableExpression>(
+			expression);
+	if (variable_expression) {
+		return GetCallName(variable_expression->GetVariable());
+	}
+
+	return "<anonymous>";
+}
+
+const string InvokeExpression::GetCallName(
+		const_shared_ptr<Variable> variable) {
+	auto member_variable = dynamic_pointer_cast<const MemberVariable>(
+			variable);
+	if (member_variable) {
+		return GetCallName(member_variable->GetContainer()) + "."
+				+ GetCallName(member_variable->GetMemberVariable());
+	}
+
+	return *variable->GetName();
+}
@@ -21,6 +21,9 @@
 #define EXPRESSIONS_INVOKE_EXPRESSION_H_
 
 #include <expression.h>
+#include <function.h>
+
+class Variable;
 
 class InvokeExpression: public Expression {
 public:
@@ -66,12 +69,33 @@ public:
 		return m_argument_list_location;
 	}
 
+	/**
+	 * Evaluate the invoked function and bind the arguments to a new frame,
+	 * without executing the function body.
+	 */
+	const TypedResult<Invocation> Bind(
+			const shared_ptr<ExecutionContext> context,
+			const shared_ptr<ExecutionContext> closure) const;
+
 	static const vector<string> BuiltinFunctionList;
 
 private:
+	const TypedResult<Function> GetFunction(
+			const shared_ptr<ExecutionContext> context,
+			const shared_ptr<ExecutionContext> closure) const;
+
+	/**
+	 * The name of the invoked function as written at the call site, used to
+	 * label the invocation when profiling.
+	 */
+	static const string GetCallName(const_shared_ptr<Expression> expression);
+	static const string GetCallName(const_shared_ptr<Variable> variable);
+
 	const_shared_ptr<Expression> m_expression;
 	const ArgumentListRef m_argument_list;
 	const yy::location m_argument_list_location;
+	mutable VariantCache m_variant_cache;
+	const string m_call_name;
 };
 
 #endif /* STATEMENTS_INVOKE_STATEMENT_H_ */
@@ -19,6 +19,8 @@
 
 #include "logic_expression.h"
 #include "error.h"
+#include <execution_context.h>
+#include <optimizer.h>
 
 LogicExpression::LogicExpression(const yy::location position,
 		const OperatorType op, const_shared_ptr<Expression> left,
@@ -34,11 +36,84 @@ TypedResult<TypeSpecifier> LogicExpression::GetTypeSpecifier(
 			ErrorList::GetTerminator());
 }
 
+const_shared_ptr<Result> LogicExpression::Evaluate(
+		const shared_ptr<ExecutionContext> context,
+		const shared_ptr<ExecutionContext> closure) const {
+	if (m_operand) {
+		auto evaluation = m_operand->Evaluate(context, closure);
+		if (m_result && ErrorList::IsTerminator(evaluation->GetErrors())) {
+			return m_result;
+		}
+
+		return evaluation;
+	}
+
+	return BinaryExpression::Evaluate(context, closure);
+}
+
 const ErrorListRef LogicExpression::Validate(
 		const shared_ptr<ExecutionContext> execution_context) const {
-	return BinaryExpression::Validate(execution_context,
+	auto errors = BinaryExpression::Validate(execution_context,
 			PrimitiveTypeSpecifier::GetDouble(),
 			PrimitiveTypeSpecifier::GetDouble());
+
+	if (ErrorList::IsTerminator(errors) && !m_operand
+			&& OPTIMIZATION_LEVEL >= CONSTANT_FOLDING && !IsConstant()) {
+		Simplify(execution_context);
+	}
+
+	return errors;
+}
+
+void LogicExpression::Simplify(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	auto left = GetLeft();
+	auto right = GetRight();
+	auto constant = left->IsConstant() ? left : right;
+	auto operand = left->IsConstant() ? right : left;
+	if (!constant->IsConstant()) {
+		return;
+	}
+
+	auto type_table = execution_context->GetTypeTable();
+	auto constant_type_specifier = constant->GetTypeSpecifier(
+			execution_context).GetData();
+	if (!constant_type_specifier
+			|| constant_type_specifier->AnalyzeAssignmentTo(
+					PrimitiveTypeSpecifier::GetBoolean(), *type_table)
+					!= EQUIVALENT) {
+		return;
+	}
+
+	auto constant_result = constant->Evaluate(execution_context,
+			execution_context);
+	if (!ErrorList::IsTerminator(constant_result->GetErrors())) {
+		return;
+	}
+
+	const bool value = constant_result->GetTaggedValue().As<bool>();
+	if (value == (GetOperator() == OR)) {
+		m_operand = operand;
+		m_result = constant_result;
+		Optimizer::Trace(GetLocation(),
+				string("simplified logical expression to ")
+						+ (value ? "true" : "false"));
+		return;
+	}
+
+	// the result is that of the other operand, which can stand in for this
+	// expression if it is also a boolean
+	auto operand_type_specifier = operand->GetTypeSpecifier(
+			execution_context).GetData();
+	if (operand_type_specifier
+			&& operand_type_specifier->AnalyzeAssignmentTo(
+					PrimitiveTypeSpecifier::GetBoolean(), *type_table)
+					== EQUIVALENT) {
+		m_operand = operand;
+		Optimizer::Trace(GetLocation(),
+				string("simplified logical expression to its ")
+						+ (operand == left ? "left" : "right") + " operand");
+	}
 }
 
 const_shared_ptr<Result> LogicExpression::compute(const bool& left,
@@ -47,11 +122,11 @@ const_shared_ptr<Result> LogicExpression::compute(const bool& left,
 	switch (GetOperator()) {
 	case OR:
 		return make_shared<Result>(
-				const_shared_ptr<void>(new bool(left || right)),
+				Value(left || right),
 				ErrorList::GetTerminator());
 	case AND:
 		return make_shared<Result>(
-				const_shared_ptr<void>(new bool(left && right)),
+				Value(left && right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
@@ -65,11 +140,11 @@ const_shared_ptr<Result> LogicExpression::compute(const std::uint8_t& left,
 	switch (GetOperator()) {
 	case OR:
 		return make_shared<Result>(
-				const_shared_ptr<void>(new bool(left || right)),
+				Value(left || right),
 				ErrorList::GetTerminator());
 	case AND:
 		return make_shared<Result>(
-				const_shared_ptr<void>(new bool(left && right)),
+				Value(left && right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
@@ -83,12 +158,12 @@ const_shared_ptr<Result> LogicExpression::compute(const int& left,
 	switch (GetOperator()) {
 	case OR: {
 		bool result = left || right;
-		return make_shared<Result>(const_shared_ptr<void>(new bool(result)),
+		return make_shared<Result>(Value(result),
 				ErrorList::GetTerminator());
 	}
 	case AND: {
 		bool result = left && right;
-		return make_shared<Result>(const_shared_ptr<void>(new bool(result)),
+		return make_shared<Result>(Value(result),
 				ErrorList::GetTerminator());
 	}
 	default:
@@ -103,11 +178,11 @@ const_shared_ptr<Result> LogicExpression::compute(const double& left,
 	switch (GetOperator()) {
 	case OR:
 		return make_shared<Result>(
-				const_shared_ptr<void>(new bool(left || right)),
+				Value(left || right),
 				ErrorList::GetTerminator());
 	case AND:
 		return make_shared<Result>(
-				const_shared_ptr<void>(new bool(left && right)),
+				Value(left && right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
@@ -32,6 +32,10 @@ public:
 			const shared_ptr<ExecutionContext> execution_context,
 			AliasResolution resolution = AliasResolution::RESOLVE) const;
 
+	const_shared_ptr<Result> Evaluate(
+			const shared_ptr<ExecutionContext> context,
+			const shared_ptr<ExecutionContext> closure) const;
+
 	virtual const ErrorListRef Validate(
 			const shared_ptr<ExecutionContext> execution_context) const;
 
@@ -50,5 +54,20 @@ protected:
 	virtual const_shared_ptr<Result> compute(const string& left,
 			const string& right, yy::location left_position,
 			yy::location right_position) const;
+
+private:
+	void Simplify(const shared_ptr<ExecutionContext> execution_context) const;
+
+	/**
+	 * If one operand is a boolean constant, the other operand, which is all
+	 * that needs to be evaluated.
+	 */
+	mutable plain_shared_ptr<Expression> m_operand;
+
+	/**
+	 * If the constant operand decides the result (true for OR, false for AND),
+	 * that result. The other operand is still evaluated for its side effects.
+	 */
+	mutable plain_shared_ptr<Result> m_result;
 };
 #endif /* LOGIC_EXPRESSION_H_ */
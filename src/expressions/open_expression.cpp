@@ -113,34 +113,65 @@ const_shared_ptr<Result> OpenExpression::Evaluate(
 				open_mode = open_mode | std::ios::trunc;
 			}
 
-			auto stream = make_shared<fstream>();
-			stream->exceptions(std::ifstream::failbit | std::ifstream::badbit);
-			try {
-				stream->open(*path, open_mode);
-				// add stream to file handle list
-				// N.B. that this process is not synchronized
-				index = Builtins::get_file_handle_map()->size();
-				Builtins::get_file_handle_map()->insert(
-						std::pair<int, volatile_shared_ptr<fstream>>(index,
-								stream));
-			} catch (std::fstream::failure &e) {
-				result_code = errno;
-				result_message = make_shared<string>(
-						std::strerror(result_code));
+			auto map = *static_pointer_cast<const bool>(
+					mode_definition->GetSymbol(*Builtins::STREAM_MODE_MAP_NAME)->GetValue());
+
+			if (map) {
+				// mappings are read-only
+				auto write_mode = std::ios::out | std::ios::app
+						| std::ios::trunc;
+				if (open_mode & write_mode) {
+					result_code = EINVAL;
+				} else {
+					auto file = MappedFile::Open(*path, result_code);
+					if (file) {
+						// N.B. that this process is not synchronized
+						index = Builtins::get_free_file_handle();
+						auto handle = make_shared<mapped_file_handle>();
+						handle->file = file;
+						handle->position = 0;
+						Builtins::get_mapped_file_map()->insert(
+								std::pair<int,
+										volatile_shared_ptr<mapped_file_handle>>(
+										index, handle));
+					}
+				}
+
+				if (result_code != 0) {
+					result_message = make_shared<string>(
+							std::strerror(result_code));
+				}
+			} else {
+				auto stream = make_shared<fstream>();
+				stream->exceptions(
+						std::ifstream::failbit | std::ifstream::badbit);
+				try {
+					stream->open(*path, open_mode);
+					// add stream to file handle list
+					// N.B. that this process is not synchronized
+					index = Builtins::get_free_file_handle();
+					Builtins::get_file_handle_map()->insert(
+							std::pair<int, volatile_shared_ptr<fstream>>(index,
+									stream));
+				} catch (std::fstream::failure &e) {
+					result_code = errno;
+					result_message = make_shared<string>(
+							std::strerror(result_code));
+				}
 			}
 		}
 	}
 
 	auto type_table = closure->GetTypeTable();
 	auto error_list_type_result =
-			Builtins::get_error_list_type_specifier()->GetType(type_table,
+			Builtins::get_error_list_type_specifier()->GetType(*type_table,
 					RETURN);
 	assert(ErrorList::IsTerminator(error_list_type_result->GetErrors()));
 	auto error_list_type = error_list_type_result->GetData<TypeDefinition>();
 
 	if (result_code == 0) {
 		auto result = make_shared<Sum>(Builtins::INT_RESULT_DATA_NAME,
-				make_shared<int>(index));
+				Builtins::INT_RESULT_DATA_TAG_ID, make_shared<int>(index));
 
 		return make_shared<Result>(result, errors);
 	} else {
@@ -168,9 +199,9 @@ const_shared_ptr<Result> OpenExpression::Evaluate(
 		assert(insert_result.second);
 
 		auto terminator = static_pointer_cast<const Record>(
-				error_list_type->GetDefaultValue(type_table));
+				error_list_type->GetDefaultValue(*type_table));
 		auto error_list_sum = make_shared<Sum>(TypeTable::GetNilName(),
-				terminator);
+				TypeTable::GetNilTagId(), terminator);
 		insert_result = error_list_symbol_map->insert(
 				std::pair<const string, const_shared_ptr<Symbol>>(
 						*Builtins::ERROR_LIST_NEXT_NAME,
@@ -184,7 +215,7 @@ const_shared_ptr<Result> OpenExpression::Evaluate(
 		auto error_list = make_shared<Record>(error_list_symbol_table);
 
 		auto result = make_shared<Sum>(Builtins::INT_RESULT_ERRORS_NAME,
-				error_list);
+				Builtins::INT_RESULT_ERRORS_TAG_ID, error_list);
 		return make_shared<Result>(result, errors);
 	}
 }
@@ -239,7 +270,7 @@ const ErrorListRef OpenExpression::Validate(
 					auto specifier = PrimitiveTypeSpecifier::GetString();
 					auto assignability =
 							argument_type_specifier->AnalyzeAssignmentTo(
-									specifier, type_table);
+									specifier, *type_table);
 					if (assignability == AnalysisResult::AMBIGUOUS) {
 						errors =
 								ErrorList::From(
@@ -261,7 +292,7 @@ const ErrorListRef OpenExpression::Validate(
 					auto specifier = Builtins::get_stream_mode_type_specifier();
 					auto assignability =
 							argument_type_specifier->AnalyzeAssignmentTo(
-									specifier, type_table);
+									specifier, *type_table);
 					if (assignability == AnalysisResult::AMBIGUOUS) {
 						errors =
 								ErrorList::From(
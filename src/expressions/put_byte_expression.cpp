@@ -64,7 +64,7 @@ const_shared_ptr<Result> PutByteExpression::Evaluate(
 
 		errors = value_evaluation->GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
-			auto value = (*value_evaluation->GetData<std::uint8_t>());
+			auto value = (value_evaluation->GetTaggedValue().As<std::uint8_t>());
 
 			auto map = Builtins::get_file_handle_map();
 			auto handle_entry = map->find(*file_handle);
@@ -77,6 +77,12 @@ const_shared_ptr<Result> PutByteExpression::Evaluate(
 					result_message = std::strerror(result_code);
 				}
 			}
+
+			if (Builtins::get_mapped_file_map()->count(*file_handle) > 0) {
+				// mappings are read-only
+				result_code = EBADF;
+				result_message = std::strerror(result_code);
+			}
 		}
 	}
 
@@ -84,9 +90,10 @@ const_shared_ptr<Result> PutByteExpression::Evaluate(
 	auto error_list_type = type_table->GetType<TypeDefinition>(
 			Builtins::get_error_list_type_specifier(), DEEP);
 	auto terminator = static_pointer_cast<const Record>(
-			error_list_type->GetDefaultValue(type_table));
+			error_list_type->GetDefaultValue(*type_table));
 	if (result_code == 0) {
-		auto result = make_shared<Sum>(TypeTable::GetNilName(), terminator);
+		auto result = make_shared<Sum>(TypeTable::GetNilName(),
+				TypeTable::GetNilTagId(), terminator);
 		return make_shared<Result>(result, errors);
 	} else {
 		auto error_symbol_map = make_shared<symbol_map>();
@@ -114,7 +121,7 @@ const_shared_ptr<Result> PutByteExpression::Evaluate(
 		assert(insert_result.second);
 
 		auto error_list_sum = make_shared<Sum>(TypeTable::GetNilName(),
-				terminator);
+				TypeTable::GetNilTagId(), terminator);
 		insert_result = error_list_symbol_map->insert(
 				std::pair<const string, const_shared_ptr<Symbol>>(
 						*Builtins::ERROR_LIST_NEXT_NAME,
@@ -128,7 +135,7 @@ const_shared_ptr<Result> PutByteExpression::Evaluate(
 		auto error_list = make_shared<Record>(error_list_symbol_table);
 
 		auto result = make_shared<Sum>(MaybeTypeSpecifier::VARIANT_NAME,
-				error_list);
+				MaybeTypeSpecifier::VARIANT_TAG_ID, error_list);
 		return make_shared<Result>(result, errors);
 	}
 }
@@ -183,7 +190,7 @@ const ErrorListRef PutByteExpression::Validate(
 					auto specifier = PrimitiveTypeSpecifier::GetInt();
 					auto assignability =
 							argument_type_specifier->AnalyzeAssignmentTo(
-									specifier, type_table);
+									specifier, *type_table);
 					if (assignability == AnalysisResult::AMBIGUOUS) {
 						errors =
 								ErrorList::From(
@@ -205,7 +212,7 @@ const ErrorListRef PutByteExpression::Validate(
 					auto specifier = PrimitiveTypeSpecifier::GetByte();
 					auto assignability =
 							argument_type_specifier->AnalyzeAssignmentTo(
-									specifier, type_table);
+									specifier, *type_table);
 					if (assignability == AnalysisResult::AMBIGUOUS) {
 						errors =
 								ErrorList::From(
@@ -23,6 +23,7 @@
 #include "unary_expression.h"
 #include "error.h"
 #include <execution_context.h>
+#include <optimizer.h>
 
 UnaryExpression::UnaryExpression(const yy::location position,
 		const OperatorType op, const_shared_ptr<Expression> expression) :
@@ -82,10 +83,10 @@ const ErrorListRef UnaryExpression::Validate(
 		case UNARY_MINUS: {
 			if (expression_type_specifier->AnalyzeAssignmentTo(
 					PrimitiveTypeSpecifier::GetInt(),
-					execution_context->GetTypeTable()) != EQUIVALENT
+					*execution_context->GetTypeTable()) != EQUIVALENT
 					&& expression_type_specifier->AnalyzeAssignmentTo(
 							PrimitiveTypeSpecifier::GetDouble(),
-							execution_context->GetTypeTable()) != EQUIVALENT) {
+							*execution_context->GetTypeTable()) != EQUIVALENT) {
 				errors = ErrorList::From(
 						make_shared<Error>(Error::SEMANTIC,
 								Error::INVALID_RIGHT_OPERAND_TYPE,
@@ -97,7 +98,7 @@ const ErrorListRef UnaryExpression::Validate(
 		case NOT: {
 			if (expression_type_specifier->AnalyzeAssignmentTo(
 					PrimitiveTypeSpecifier::GetBoolean(),
-					execution_context->GetTypeTable()) != EQUIVALENT) {
+					*execution_context->GetTypeTable()) != EQUIVALENT) {
 				errors = ErrorList::From(
 						make_shared<Error>(Error::SEMANTIC,
 								Error::INVALID_RIGHT_OPERAND_TYPE,
@@ -115,13 +116,21 @@ const ErrorListRef UnaryExpression::Validate(
 		}
 	}
 
+	if (ErrorList::IsTerminator(errors) && !m_folded) {
+		m_folded = Optimizer::Fold(*this, execution_context);
+	}
+
 	return errors;
 }
 
 const_shared_ptr<Result> UnaryExpression::Evaluate(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure) const {
-	shared_ptr<void> result;
+	if (m_folded) {
+		return m_folded;
+	}
+
+	Value result;
 
 	auto expression_type_specifier_result = m_expression->GetTypeSpecifier(
 			context);
@@ -140,23 +149,23 @@ const_shared_ptr<Result> UnaryExpression::Evaluate(
 			case UNARY_MINUS: {
 				if (expression_type_specifier->AnalyzeAssignmentTo(
 						PrimitiveTypeSpecifier::GetInt(),
-						context->GetTypeTable()) == EQUIVALENT) {
-					int value = -(*(evaluation->GetData<int>()));
-					result = make_shared<int>(value);
+						*context->GetTypeTable()) == EQUIVALENT) {
+					int value = -(evaluation->GetTaggedValue().As<int>());
+					result = Value(value);
 				} else if (expression_type_specifier->AnalyzeAssignmentTo(
 						PrimitiveTypeSpecifier::GetDouble(),
-						context->GetTypeTable()) == EQUIVALENT) {
-					double value = -(*(evaluation->GetData<double>()));
-					result = make_shared<double>(value);
+						*context->GetTypeTable()) == EQUIVALENT) {
+					double value = -(evaluation->GetTaggedValue().As<double>());
+					result = Value(value);
 				} else {
 					assert(false);
 				}
 				break;
 			}
 			case NOT: {
-				bool old_value = *(evaluation->GetData<bool>());
+				bool old_value = evaluation->GetTaggedValue().As<bool>();
 				bool value = !old_value;
-				result = make_shared<bool>(value);
+				result = Value(value);
 				break;
 			}
 			default:
@@ -42,11 +42,24 @@ public:
 	virtual const ErrorListRef Validate(
 			const shared_ptr<ExecutionContext> execution_context) const;
 
+	const_shared_ptr<Expression> GetExpression() const {
+		return m_expression;
+	}
+
+	const OperatorType GetOperator() const {
+		return m_operator;
+	}
+
 private:
 	static TypedResult<TypeSpecifier> compute_result_type(
 			const_shared_ptr<TypeSpecifier> input_type, const OperatorType op);
 	const_shared_ptr<Expression> m_expression;
 	const OperatorType m_operator;
+
+	/**
+	 * The value of this expression, if it was folded during validation.
+	 */
+	mutable plain_shared_ptr<Result> m_folded;
 };
 
 #endif /* UNARY_EXPRESSION_H_ */
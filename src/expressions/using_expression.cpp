@@ -30,6 +30,7 @@
 #include <nested_type_specifier.h>
 #include <function_declaration.h>
 #include <foreach_statement.h>
+#include <return_statement.h>
 #include <sum.h>
 #include <function.h>
 #include <record.h>
@@ -91,7 +92,7 @@ const_shared_ptr<Result> UsingExpression::Evaluate(
 		auto type_table = context->GetTypeTable();
 
 		auto expression_type_result = expression_type_specifier->GetType(
-				type_table, AliasResolution::RESOLVE);
+				*type_table, AliasResolution::RESOLVE);
 		errors = expression_type_result->GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
 			auto expression_type = expression_type_result->GetData<
@@ -105,7 +106,7 @@ const_shared_ptr<Result> UsingExpression::Evaluate(
 				auto raw_value = eval->GetRawData();
 
 				auto expression_type_result =
-						expression_type_specifier->GetType(type_table,
+						expression_type_specifier->GetType(*type_table,
 								AliasResolution::RESOLVE);
 
 				errors = expression_type_result->GetErrors();
@@ -179,11 +180,11 @@ const_shared_ptr<Result> UsingExpression::Evaluate(
 						auto set_result = execution_context->SetSymbol(
 								*m_identifier,
 								complex_expression_type_specifier, record,
-								context->GetTypeTable());
+								*context->GetTypeTable());
 						assert(set_result == SET_SUCCESS);
 
-						auto execution_result = m_body->Execute(
-								execution_context);
+						auto execution_result = ReturnStatement::Complete(
+								m_body->Execute(execution_context));
 						errors = ErrorList::Concatenate(errors,
 								execution_result.GetErrors());
 
@@ -300,7 +301,7 @@ const ErrorListRef UsingExpression::Validate(
 			auto expression_type_specifier =
 					expression_type_specifier_result.GetData();
 			auto expression_type_result = expression_type_specifier->GetType(
-					type_table, AliasResolution::RESOLVE);
+					*type_table, AliasResolution::RESOLVE);
 			errors = expression_type_result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
 				auto complex_expression_type_specifier = dynamic_pointer_cast<
@@ -335,7 +336,7 @@ const ErrorListRef UsingExpression::Validate(
 								auto assignability =
 										error_type_specifier->AnalyzeAssignmentTo(
 												m_return_type_specifier,
-												type_table);
+												*type_table);
 								if (assignability
 										== AnalysisResult::AMBIGUOUS) {
 									errors =
@@ -416,7 +417,7 @@ const ErrorListRef UsingExpression::Validate(
 											*type_table);
 
 							auto default_symbol = expression_type->GetSymbol(
-									type_table, expression_type_specifier,
+									*type_table, expression_type_specifier,
 									default_value);
 							m_block_context->InsertSymbol(*m_identifier,
 									default_symbol);
@@ -29,6 +29,7 @@
 #include <sum_type.h>
 #include <record.h>
 #include <alias_resolution.h>
+#include <default_value_expression.h>
 
 WithExpression::WithExpression(const yy::location position,
 		const_shared_ptr<Expression> source_expression,
@@ -36,7 +37,9 @@ WithExpression::WithExpression(const yy::location position,
 		const yy::location member_instantiation_list_position) :
 		Expression(position), m_source_expression(source_expression), m_member_instantiation_list(
 				member_instantiation_list), m_member_instantiation_list_position(
-				member_instantiation_list_position) {
+				member_instantiation_list_position), m_member_variables(
+				GetMemberVariables(member_instantiation_list)), m_updates_in_place(
+				false) {
 }
 
 WithExpression::~WithExpression() {
@@ -67,7 +70,7 @@ const_shared_ptr<Result> WithExpression::Evaluate(
 
 			shared_ptr<const RecordType> type = nullptr;
 			auto source_type_result = source_type_specifier->GetType(
-					context->GetTypeTable());
+					*context->GetTypeTable());
 
 			errors = source_type_result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
@@ -90,24 +93,28 @@ const_shared_ptr<Result> WithExpression::Evaluate(
 			if (ErrorList::IsTerminator(errors)) {
 				auto as_record = source_result->GetData<Record>();
 
-				const_shared_ptr<SymbolContext> definition =
+				volatile_shared_ptr<SymbolContext> definition =
 						as_record->GetDefinition();
 
+				auto target =
+						m_updates_in_place ?
+								definition : definition->Clone();
+
 				//create a new context that isn't read-only
 				volatile_shared_ptr<SymbolContext> new_symbol_context =
-						definition->Clone()->WithModifiers(
+						target->WithModifiers(
 								Modifier::Type(
 										definition->GetModifiers()
 												| Modifier::Type::MUTABLE));
 				auto type_definition = type->GetDefinition();
-				auto temp_type_table = type_definition->Clone()->WithParent(
+				auto temp_type_table = type_definition->WithParent(
 						context->GetTypeTable());
 
 				auto temp_execution_context = make_shared<ExecutionContext>(
 						new_symbol_context, temp_type_table, EPHEMERAL);
 
 				auto resolved_specifier_result = NestedTypeSpecifier::Resolve(
-						source_type_specifier, context->GetTypeTable());
+						source_type_specifier, *context->GetTypeTable());
 
 				errors = resolved_specifier_result.GetErrors();
 				if (ErrorList::IsTerminator(errors)) {
@@ -119,13 +126,12 @@ const_shared_ptr<Result> WithExpression::Evaluate(
 
 					MemberInstantiationListRef subject =
 							m_member_instantiation_list;
+					auto member_variable = m_member_variables.begin();
 					while (!MemberInstantiationList::IsTerminator(subject)) {
 						const_shared_ptr<MemberInstantiation> instantiation =
 								subject->GetData();
 
-						auto variable = make_shared<BasicVariable>(
-								instantiation->GetName(),
-								instantiation->GetNamePosition());
+						auto variable = *member_variable++;
 						errors = ErrorList::Concatenate(errors,
 								variable->AssignValue(context, closure,
 										instantiation->GetExpression(), ASSIGN,
@@ -169,6 +175,9 @@ const ErrorListRef WithExpression::Validate(
 	ErrorListRef errors = m_source_expression->Validate(execution_context);
 
 	if (ErrorList::IsTerminator(errors)) {
+		m_updates_in_place = OwnsResult(m_source_expression,
+				execution_context);
+
 		auto source_type_specifier_result =
 				m_source_expression->GetTypeSpecifier(execution_context,
 						RETURN);
@@ -290,3 +299,44 @@ const ErrorListRef WithExpression::Validate(
 
 	return errors;
 }
+
+const vector<plain_shared_ptr<BasicVariable>> WithExpression::GetMemberVariables(
+		MemberInstantiationListRef member_instantiation_list) {
+	vector<plain_shared_ptr<BasicVariable>> result;
+
+	auto subject = member_instantiation_list;
+	while (!MemberInstantiationList::IsTerminator(subject)) {
+		auto instantiation = subject->GetData();
+		result.push_back(
+				make_shared<BasicVariable>(instantiation->GetName(),
+						instantiation->GetNamePosition()));
+		subject = subject->GetNext();
+	}
+
+	return result;
+}
+
+const bool WithExpression::OwnsResult(
+		const_shared_ptr<Expression> expression,
+		const shared_ptr<ExecutionContext> execution_context) {
+	// the result of another with expression is always a new record
+	if (dynamic_pointer_cast<const WithExpression>(expression)) {
+		return true;
+	}
+
+	// record types build a new default instance on each evaluation, but
+	// aliases may hand out a stored default value
+	if (dynamic_pointer_cast<const DefaultValueExpression>(expression)) {
+		auto type_specifier_result = expression->GetTypeSpecifier(
+				execution_context, RETURN);
+		if (ErrorList::IsTerminator(type_specifier_result.GetErrors())) {
+			auto type_result = type_specifier_result.GetData()->GetType(
+					*execution_context->GetTypeTable(), RETURN);
+			return ErrorList::IsTerminator(type_result->GetErrors())
+					&& dynamic_pointer_cast<const RecordType>(
+							type_result->GetData<TypeDefinition>());
+		}
+	}
+
+	return false;
+}
@@ -22,6 +22,9 @@
 
 #include <expression.h>
 #include <member_instantiation.h>
+#include <vector>
+
+class BasicVariable;
 
 class WithExpression: public Expression {
 public:
@@ -60,6 +63,25 @@ private:
 	const_shared_ptr<Expression> m_source_expression;
 	MemberInstantiationListRef m_member_instantiation_list;
 	const yy::location m_member_instantiation_list_position;
+
+	/**
+	 * The members being assigned, in the same order as the instantiation
+	 * list. They are kept so that each one can cache its slot.
+	 */
+	const vector<plain_shared_ptr<BasicVariable>> m_member_variables;
+
+	/**
+	 * True if the source expression always evaluates to a record that nothing
+	 * else refers to, so that its members can be updated in place. Decided
+	 * during validation, from the form of the source expression.
+	 */
+	mutable bool m_updates_in_place;
+
+	static const bool OwnsResult(const_shared_ptr<Expression> expression,
+			const shared_ptr<ExecutionContext> execution_context);
+
+	static const vector<plain_shared_ptr<BasicVariable>> GetMemberVariables(
+			MemberInstantiationListRef member_instantiation_list);
 };
 
 #endif /* EXPRESSIONS_WITH_EXPRESSION_H_ */
@@ -0,0 +1,144 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAME_ALLOCATOR_H_
+#define FRAME_ALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <memory>
+
+/**
+ * A per-thread free list of fixed-size blocks.
+ *
+ * Function invocations create and destroy the same handful of objects
+ * (execution context, symbol table, type table) on every call. Released
+ * blocks are kept here and handed to the next invocation instead of going
+ * back to the general-purpose heap.
+ */
+template<size_t Size> class FramePool {
+public:
+	static void* Allocate() {
+		FreeList& list = GetFreeList();
+		if (list.head) {
+			Block* block = list.head;
+			list.head = block->next;
+			list.count--;
+			return block;
+		}
+
+		return ::operator new(BLOCK_SIZE);
+	}
+
+	static void Release(void* pointer) {
+		FreeList& list = GetFreeList();
+		if (list.count < CAPACITY) {
+			Block* block = static_cast<Block*>(pointer);
+			block->next = list.head;
+			list.head = block;
+			list.count++;
+		} else {
+			::operator delete(pointer);
+		}
+	}
+
+private:
+	struct Block {
+		Block* next;
+	};
+
+	/**
+	 * Returns its cached blocks to the heap when its thread exits. Blocks
+	 * released afterwards (e.g. by other thread-local destructors) go straight
+	 * back to the heap.
+	 */
+	struct FreeList {
+		~FreeList() {
+			while (head) {
+				Block* block = head;
+				head = block->next;
+				::operator delete(block);
+			}
+			count = CAPACITY;
+		}
+
+		Block* head;
+		size_t count;
+	};
+
+	static const size_t BLOCK_SIZE =
+			Size < sizeof(Block) ? sizeof(Block) : Size;
+
+	/**
+	 * Enough blocks to cover a deep recursion without holding on to an
+	 * unbounded amount of memory afterwards.
+	 */
+	static const size_t CAPACITY = 1024;
+
+	static FreeList& GetFreeList() {
+		static thread_local FreeList list = { nullptr, 0 };
+		return list;
+	}
+};
+
+/**
+ * An allocator for use with allocate_shared that draws single objects from
+ * a FramePool. Because the pool is keyed on the size of the rebound type,
+ * the object and its reference count share one recycled block.
+ *
+ * Objects allocated this way are ordinary reference-counted objects: one
+ * that outlives its invocation (for example, a context captured by a
+ * returned closure) simply keeps its block until the last reference drops.
+ */
+template<class T> class FrameAllocator {
+public:
+	typedef T value_type;
+
+	FrameAllocator() {
+	}
+
+	template<class U> FrameAllocator(const FrameAllocator<U>&) {
+	}
+
+	T* allocate(const size_t n) {
+		if (n == 1) {
+			return static_cast<T*>(FramePool<sizeof(T)>::Allocate());
+		}
+
+		return static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+
+	void deallocate(T* pointer, const size_t n) {
+		if (n == 1) {
+			FramePool<sizeof(T)>::Release(pointer);
+		} else {
+			::operator delete(pointer);
+		}
+	}
+
+	template<class U> bool operator==(const FrameAllocator<U>&) const {
+		return true;
+	}
+
+	template<class U> bool operator!=(const FrameAllocator<U>&) const {
+		return false;
+	}
+};
+
+#endif /* FRAME_ALLOCATOR_H_ */
@@ -34,6 +34,9 @@
 #include <maybe_type.h>
 #include <unit_type.h>
 #include <basic_variable.h>
+#include <call_stack.h>
+#include <parallel.h>
+#include <limits>
 
 const_shared_ptr<Function> Function::Build(const yy::location location,
 		FunctionVariantListRef variant_list,
@@ -101,41 +104,97 @@ Function::~Function() {
 const_shared_ptr<Result> Function::Evaluate(ArgumentListRef argument_list,
 		const yy::location argument_list_location,
 		const shared_ptr<ExecutionContext> invocation_context) const {
+	VariantCache cache;
+	return Evaluate(argument_list, argument_list_location, invocation_context,
+			cache);
+}
+
+const_shared_ptr<Result> Function::Evaluate(ArgumentListRef argument_list,
+		const yy::location argument_list_location,
+		const shared_ptr<ExecutionContext> invocation_context,
+		VariantCache& cache) const {
+	plain_shared_ptr<FunctionVariant> variant;
+	shared_ptr<ExecutionContext> frame;
+	auto errors = BindArguments(argument_list, argument_list_location,
+			invocation_context, cache, variant, frame);
+	if (!ErrorList::IsTerminator(errors)) {
+		return make_shared<Result>(nullptr, errors);
+	}
+
+	// the caller holds a reference to this function for the duration of the call
+	return Execute(
+			make_shared<Invocation>(
+					Invocation { nullptr, variant, frame,
+							invocation_context->GetTypeTable(),
+							GetLocation() }));
+}
+
+const TypedResult<Invocation> Function::Bind(
+		const_shared_ptr<Function> function, ArgumentListRef argument_list,
+		const yy::location argument_list_location,
+		const shared_ptr<ExecutionContext> invocation_context,
+		VariantCache& cache) {
+	plain_shared_ptr<FunctionVariant> variant;
+	shared_ptr<ExecutionContext> frame;
+	auto errors = function->BindArguments(argument_list,
+			argument_list_location, invocation_context, cache, variant,
+			frame);
+	if (!ErrorList::IsTerminator(errors)) {
+		return TypedResult<Invocation>(nullptr, errors);
+	}
+
+	return TypedResult<Invocation>(
+			make_shared<Invocation>(
+					Invocation { function, variant, frame,
+							invocation_context->GetTypeTable(),
+							function->GetLocation() }));
+}
+
+const ErrorListRef Function::BindArguments(ArgumentListRef argument_list,
+		const yy::location argument_list_location,
+		const shared_ptr<ExecutionContext> invocation_context,
+		VariantCache& cache, plain_shared_ptr<FunctionVariant>& variant,
+		shared_ptr<ExecutionContext>& frame) const {
 	auto errors = ErrorList::GetTerminator();
-	if (invocation_context->GetDepth() > INVOCATION_DEPTH) {
+	if (MAX_STACK == 0 && invocation_context->GetDepth() > INVOCATION_DEPTH) {
 		std::stringstream ss;
 		ss << INVOCATION_DEPTH;
 		std::string as_string = ss.str();
 		errors = ErrorList::From(
 				make_shared<Error>(Error::RUNTIME, Error::MAX_INVOCATION_DEPTH,
 						GetLocation().begin, as_string), errors);
-		return make_shared<Result>(nullptr, errors);
+		return errors;
 	}
 	auto closure_reference = GetClosureReference();
 
 	assert(closure_reference);
 
-	auto variant_result = GetVariant(argument_list, argument_list_location,
-			m_variant_list, invocation_context);
-	errors = ErrorList::Concatenate(errors, variant_result.GetErrors());
-	if (!ErrorList::IsTerminator(errors)) {
-		return make_shared<Result>(nullptr, errors);
+	if (closure_reference->GetLifeTime() == ROOT) {
+		closure_reference = ExecutionContext::ResolveClosure(closure_reference,
+				invocation_context);
+	}
+
+	variant = cache.Get(m_variant_list);
+	if (!variant) {
+		auto variant_result = GetVariant(argument_list, argument_list_location,
+				m_variant_list, invocation_context);
+		errors = ErrorList::Concatenate(errors, variant_result.GetErrors());
+		if (!ErrorList::IsTerminator(errors)) {
+			return errors;
+		}
+
+		variant = variant_result.GetData();
+		cache.Set(m_variant_list, variant);
 	}
 
-	auto variant = variant_result.GetData();
 	auto declaration = variant->GetDeclaration();
-	auto body = variant->GetBody();
 	auto variant_context = variant->GetContext();
 
-	// clone variant context to create the function execution context
+	// copy variant context to create the function execution context
 	// so repeated invocations of the function will use discrete child contexts
-	// this clone is EPHEMERAL so that strong references will be made to it by functions that return functions, e.g. partial applicators
-	auto parent_context = ExecutionContextList::From(closure_reference,
-			closure_reference->GetParent());
-	auto function_execution_context = make_shared<ExecutionContext>(
-			variant_context->Clone(), Modifier::MUTABLE, parent_context,
-			make_shared<TypeTable>(closure_reference->GetTypeTable()),
-			EPHEMERAL, invocation_context->GetDepth() + 1);
+	auto function_execution_context = ExecutionContext::GetFrame(
+			variant_context, closure_reference,
+			invocation_context->GetDepth() + 1);
 
 	//populate evaluation context with results of argument evaluation
 	ArgumentListRef argument = argument_list;
@@ -145,11 +204,11 @@ const_shared_ptr<Result> Function::Evaluate(ArgumentListRef argument_list,
 		if (!DeclarationList::IsTerminator(parameter)) {
 			auto parameter_declaration = parameter->GetData();
 
-			auto argument_variable = make_shared<const BasicVariable>(
+			const BasicVariable argument_variable(
 					parameter_declaration->GetName(),
 					argument_expression->GetLocation());
 
-			auto assign_errors = argument_variable->AssignValue(
+			auto assign_errors = argument_variable.AssignValue(
 					invocation_context, closure_reference, argument_expression,
 					ASSIGN, function_execution_context);
 			if (!ErrorList::IsTerminator(assign_errors)) {
@@ -186,45 +245,80 @@ const_shared_ptr<Result> Function::Evaluate(ArgumentListRef argument_list,
 		}
 	}
 
-	if (ErrorList::IsTerminator(errors)) {
+	frame = function_execution_context;
+	return errors;
+}
+
+const_shared_ptr<Result> Function::Execute(
+		const_shared_ptr<Invocation> invocation) {
+	if (CallStack::IsLow()) {
+		plain_shared_ptr<Result> result;
+		auto extended = CallStack::Extend([&]() {
+			result = Execute(invocation);
+		});
+
+		if (!extended) {
+			std::stringstream ss;
+			ss << MAX_STACK;
+			return make_shared<Result>(nullptr,
+					ErrorList::From(
+							make_shared<Error>(Error::RUNTIME,
+									Error::MAX_STACK_SIZE,
+									invocation->location.begin, ss.str()),
+							ErrorList::GetTerminator()));
+		}
+
+		return result;
+	}
+
+	plain_shared_ptr<Invocation> current = invocation;
+	const size_t depth = current->frame->GetDepth();
+	while (true) {
+		auto declaration = current->variant->GetDeclaration();
+		auto body = current->variant->GetBody();
+		auto function_execution_context = current->frame;
+
+		if (Parallel::InRegion() && current->variant->HasEffects()) {
+			return make_shared<Result>(nullptr,
+					ErrorList::From(
+							make_shared<Error>(Error::RUNTIME,
+									Error::PARALLEL_EFFECTFUL_INVOCATION,
+									body->GetLocation().begin),
+							ErrorList::GetTerminator()));
+		}
+
 		// the use of the function context as a closure is required for functions that yield functions, e.g. partial applicators
 		auto execute_result = body->Execute(function_execution_context,
 				function_execution_context);
-		auto execute_errors = execute_result.GetErrors();
-		if (ErrorList::IsTerminator(execute_errors)) {
-			if (*declaration->GetReturnTypeSpecifier()
-					== *TypeTable::GetNilTypeSpecifier()) {
-				return make_shared<Result>(
-						TypeTable::GetNilType()->GetDefaultValue(
-								closure_reference->GetTypeTable()), errors);
-			} else {
-				plain_shared_ptr<Symbol> evaluation_result =
-						execute_result.GetReturnValue();
-				assert(evaluation_result);
-
-				auto final_return_result = GetFinalReturnValue(
-						evaluation_result->GetValue(),
-						evaluation_result->GetTypeSpecifier(),
-						declaration->GetReturnTypeSpecifier(),
-						invocation_context->GetTypeTable());
-
-				auto final_return_result_errors =
-						final_return_result->GetErrors();
-				if (ErrorList::IsTerminator(final_return_result_errors)) {
-					return make_shared<Result>(
-							final_return_result->GetRawData(), errors);
-				} else {
-					errors = ErrorList::Concatenate(errors,
-							final_return_result_errors);
-				}
-			}
-		} else {
-			errors = ErrorList::Concatenate(errors, execute_errors);
+		auto errors = execute_result.GetErrors();
+		if (!ErrorList::IsTerminator(errors)) {
+			return make_shared<Result>(nullptr, errors);
 		}
-	}
 
-	// default behavior: we have no result
-	return make_shared<Result>(nullptr, errors);
+		auto tail_call = execute_result.GetTailCall();
+		if (tail_call) {
+			// the callee replaces this invocation, releasing its frame
+			tail_call->frame->SetDepth(depth);
+			current = tail_call;
+			continue;
+		}
+
+		if (*declaration->GetReturnTypeSpecifier()
+				== *TypeTable::GetNilTypeSpecifier()) {
+			return make_shared<Result>(
+					TypeTable::GetNilType()->GetDefaultValue(
+							*function_execution_context->GetTypeTable()),
+					errors);
+		}
+
+		plain_shared_ptr<Symbol> evaluation_result =
+				execute_result.GetReturnValue();
+		assert(evaluation_result);
+
+		return GetFinalReturnValue(evaluation_result->GetTaggedValue(),
+				evaluation_result->GetTypeSpecifier(),
+				declaration->GetReturnTypeSpecifier(), current->type_table);
+	}
 }
 
 const string Function::ToString(const TypeTable& type_table,
@@ -361,7 +455,7 @@ const TypedResult<FunctionVariant> Function::GetVariant(
 					auto argument_assignment_compatibility =
 							argument_type_specifier->AnalyzeAssignmentTo(
 									parameter_type_specifier,
-									context->GetTypeTable());
+									*context->GetTypeTable());
 
 					switch (argument_assignment_compatibility) {
 					case AnalysisResult::INCOMPATIBLE: {
@@ -484,16 +578,24 @@ const_shared_ptr<Result> Function::GetFinalReturnValue(
 		const_shared_ptr<TypeSpecifier> value_type_specifier,
 		const_shared_ptr<TypeSpecifier> return_type_specifier,
 		volatile_shared_ptr<TypeTable> type_table) {
-	auto final_result = value;
+	return GetFinalReturnValue(Value(value), value_type_specifier,
+			return_type_specifier, type_table);
+}
+
+const_shared_ptr<Result> Function::GetFinalReturnValue(const Value& value,
+		const_shared_ptr<TypeSpecifier> value_type_specifier,
+		const_shared_ptr<TypeSpecifier> return_type_specifier,
+		volatile_shared_ptr<TypeTable> type_table) {
+	Value final_result = value;
 	auto errors = ErrorList::GetTerminator();
 
 	auto assignment_analysis = value_type_specifier->AnalyzeAssignmentTo(
-			return_type_specifier, type_table);
+			return_type_specifier, *type_table);
 	switch (assignment_analysis) {
 	case UNAMBIGUOUS:
 	case UNAMBIGUOUS_NESTED: {
 		//we're returning a narrower type than the return type; perform widening
-		auto return_type_result = return_type_specifier->GetType(type_table,
+		auto return_type_result = return_type_specifier->GetType(*type_table,
 				RESOLVE);
 
 		auto return_type_errors = return_type_result->GetErrors();
@@ -504,11 +606,15 @@ const_shared_ptr<Result> Function::GetFinalReturnValue(
 			if (as_maybe) {
 				if (*value_type_specifier
 						== *TypeTable::GetNilTypeSpecifier()) {
-					final_result = make_shared<Sum>(TypeTable::GetNilName(),
-							value);
+					final_result = Value(
+							make_shared<Sum>(TypeTable::GetNilName(),
+									TypeTable::GetNilTagId(),
+									value.ToPointer()));
 				} else {
-					final_result = make_shared<Sum>(
-							MaybeTypeSpecifier::VARIANT_NAME, value);
+					final_result = Value(
+							make_shared<Sum>(MaybeTypeSpecifier::VARIANT_NAME,
+									MaybeTypeSpecifier::VARIANT_TAG_ID,
+									value.ToPointer()));
 				}
 				break;
 			}
@@ -524,7 +630,9 @@ const_shared_ptr<Result> Function::GetFinalReturnValue(
 				plain_shared_ptr<string> tag = as_sum->MapSpecifierToVariant(
 						as_sum_specifier, *value_type_specifier);
 
-				final_result = make_shared<Sum>(tag, value);
+				final_result = Value(
+						make_shared<Sum>(tag, as_sum->GetTagId(*tag),
+								value.ToPointer()));
 				break;
 			}
 		} else {
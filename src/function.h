@@ -20,14 +20,114 @@
 #ifndef FUNCTION_H_
 #define FUNCTION_H_
 
+#include <atomic>
 #include <expression.h>
 #include <function_variant.h>
 
 class FunctionDeclaration;
+class Function;
 class StatementBlock;
 class Result;
 class ExecutionContext;
 
+/**
+ * The variants selected by a call site. Argument types are static, so a call
+ * site that sees the same variant list again will select the same variant.
+ *
+ * A call site may be evaluated by several threads at once, so entries are
+ * never modified once published: a selection is recorded by pushing a new
+ * entry onto the front of the list. Only the first few variant lists a call
+ * site sees are recorded; later ones are resolved on every call.
+ */
+class VariantCache {
+public:
+	VariantCache() :
+			m_head(nullptr) {
+	}
+
+	~VariantCache() {
+		auto entry = m_head.load(std::memory_order_relaxed);
+		while (entry) {
+			auto previous = entry->previous;
+			delete entry;
+			entry = previous;
+		}
+	}
+
+	/**
+	 * Get the variant selected for the given variant list, or nullptr if no
+	 * selection has been recorded.
+	 */
+	plain_shared_ptr<FunctionVariant> Get(
+			const FunctionVariantListRef variant_list) const {
+		auto entry = m_head.load(std::memory_order_acquire);
+		while (entry) {
+			if (entry->variant_list == variant_list) {
+				return entry->variant;
+			}
+			entry = entry->previous;
+		}
+
+		return nullptr;
+	}
+
+	void Set(const FunctionVariantListRef variant_list,
+			const_shared_ptr<FunctionVariant> variant) {
+		auto head = m_head.load(std::memory_order_acquire);
+		auto entry = new Entry { variant_list, variant, head,
+				head ? head->count + 1 : 1 };
+		while (entry->count <= CAPACITY
+				&& !m_head.compare_exchange_weak(entry->previous, entry,
+						std::memory_order_release, std::memory_order_acquire)) {
+			entry->count = entry->previous ? entry->previous->count + 1 : 1;
+		}
+
+		if (entry->count > CAPACITY) {
+			delete entry;
+		}
+	}
+
+private:
+	VariantCache(const VariantCache&) = delete;
+	VariantCache& operator=(const VariantCache&) = delete;
+
+	struct Entry {
+		const FunctionVariantListRef variant_list;
+		const plain_shared_ptr<FunctionVariant> variant;
+		Entry* previous;
+		size_t count;
+	};
+
+	static const size_t CAPACITY = 4;
+
+	std::atomic<Entry*> m_head;
+};
+
+/**
+ * A function invocation whose arguments have been bound to a new frame, but
+ * whose body has not yet run.
+ */
+struct Invocation {
+	/**
+	 * The invoked function, if the invocation may outlive the caller's
+	 * reference to it (e.g. a closure returned from a block whose references
+	 * have since been weakened).
+	 */
+	plain_shared_ptr<Function> function;
+	plain_shared_ptr<FunctionVariant> variant;
+	shared_ptr<ExecutionContext> frame;
+
+	/**
+	 * The caller's type table, against which the return value is converted.
+	 */
+	volatile_shared_ptr<TypeTable> type_table;
+	/**
+	 * The location of the invoked function, at which errors that stop the
+	 * invocation from running are reported.
+	 */
+	yy::location location;
+};
+
 class Function {
 public:
 	static const_shared_ptr<Function> Build(const yy::location location,
@@ -54,12 +154,42 @@ public:
 			const_shared_ptr<TypeSpecifier> return_type_specifier,
 			volatile_shared_ptr<TypeTable> type_table);
 
+	static const_shared_ptr<Result> GetFinalReturnValue(const Value& value,
+			const_shared_ptr<TypeSpecifier> value_type_specifier,
+			const_shared_ptr<TypeSpecifier> return_type_specifier,
+			volatile_shared_ptr<TypeTable> type_table);
+
 	virtual ~Function();
 
 	const_shared_ptr<Result> Evaluate(ArgumentListRef argument_list,
 			const yy::location argument_list_location,
 			const shared_ptr<ExecutionContext> invocation_context) const;
 
+	const_shared_ptr<Result> Evaluate(ArgumentListRef argument_list,
+			const yy::location argument_list_location,
+			const shared_ptr<ExecutionContext> invocation_context,
+			VariantCache& cache) const;
+
+	/**
+	 * Select a variant and bind the given arguments to a new frame, without
+	 * running the function body.
+	 */
+	static const TypedResult<Invocation> Bind(
+			const_shared_ptr<Function> function, ArgumentListRef argument_list,
+			const yy::location argument_list_location,
+			const shared_ptr<ExecutionContext> invocation_context,
+			VariantCache& cache);
+
+	/**
+	 * Run a bound invocation to completion.
+	 *
+	 * If the body returns by way of a call in tail position, the callee runs in
+	 * place of the current invocation rather than on top of it, so that chains
+	 * of tail calls (e.g. tail-recursive loops) run in constant stack space.
+	 */
+	static const_shared_ptr<Result> Execute(
+			const_shared_ptr<Invocation> invocation);
+
 	const string ToString(const TypeTable& type_table,
 			const Indent& indent) const;
 
@@ -90,6 +220,12 @@ private:
 
 	const shared_ptr<ExecutionContext> GetClosureReference() const;
 
+	const ErrorListRef BindArguments(ArgumentListRef argument_list,
+			const yy::location argument_list_location,
+			const shared_ptr<ExecutionContext> invocation_context,
+			VariantCache& cache, plain_shared_ptr<FunctionVariant>& variant,
+			shared_ptr<ExecutionContext>& frame) const;
+
 	const yy::location m_location;
 	const FunctionVariantListRef m_variant_list;
 	const shared_ptr<ExecutionContext> m_closure;
@@ -22,12 +22,14 @@
 #include <function_declaration.h>
 #include <indent.h>
 #include <execution_context.h>
+#include <effect_analysis.h>
 
 FunctionVariant::FunctionVariant(const yy::location location,
 		const_shared_ptr<FunctionDeclaration> declaration,
 		const_shared_ptr<StatementBlock> body) :
 		m_location(location), m_declaration(declaration), m_body(body), m_context(
-				make_shared<ExecutionContext>(Modifier::Type::MUTABLE)) {
+				make_shared<ExecutionContext>(Modifier::Type::MUTABLE)), m_has_effects(
+				EffectAnalysis::HasEffects(declaration, body)) {
 }
 
 FunctionVariant::~FunctionVariant() {
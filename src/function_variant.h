@@ -51,6 +51,14 @@ public:
 		return m_context;
 	}
 
+	/**
+	 * True if the body may affect anything outside of the invocation, in
+	 * which case it cannot run in a parallel loop.
+	 */
+	const bool HasEffects() const {
+		return m_has_effects;
+	}
+
 	const string ToString(const Indent &indent) const;
 
 private:
@@ -58,6 +66,7 @@ private:
 	const_shared_ptr<FunctionDeclaration> m_declaration;
 	const_shared_ptr<StatementBlock> m_body;
 	shared_ptr<ExecutionContext> m_context;
+	const bool m_has_effects;
 };
 
 typedef const LinkedList<const FunctionVariant, NO_DUPLICATES> FunctionVariantList;
@@ -0,0 +1,408 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <import_cache.h>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <builtins.h>
+#include <utils.h>
+
+namespace {
+typedef yy::newt_parser::symbol_kind symbol_kind;
+typedef yy::newt_parser::token_kind_type token_kind_type;
+
+const char MAGIC[] = { 'N', 'W', 'T', 'C' };
+const std::uint32_t FORMAT = 1;
+
+// marks a nested import in place of a symbol kind
+const std::uint32_t IMPORT_KIND = 0xFFFF;
+
+const std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+const std::uint64_t Hash(std::uint64_t hash, const char* data,
+		const size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		hash ^= static_cast<unsigned char>(data[i]);
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+const std::uint64_t Hash(std::uint64_t hash, const std::string& data) {
+	// include the terminator, so consecutive strings can't run together
+	return Hash(hash, data.c_str(), data.size() + 1);
+}
+
+// The hash of everything besides the source that an entry depends on.
+const std::uint64_t GetInterpreterHash() {
+	static const std::uint64_t instance = [] {
+		auto hash = Hash(FNV_OFFSET_BASIS, *Builtins::LANGUAGE_VERSION_STRING);
+		for (int kind = 0; kind < yy::newt_parser::YYNTOKENS; kind++) {
+			hash = Hash(hash,
+					yy::newt_parser::symbol_name(
+							yy::newt_parser::symbol_kind_type(kind)));
+		}
+		return hash;
+	}();
+	return instance;
+}
+
+// Symbols are constructed from token numbers, but only expose their
+// (internal) symbol kinds, so entries store symbol kinds and are mapped back
+// on load.
+const std::vector<token_kind_type>& GetTokenKinds() {
+	static const std::vector<token_kind_type> instance = [] {
+		std::vector<token_kind_type> token_kinds(yy::newt_parser::YYNTOKENS,
+				yy::newt_parser::token::T_YYUNDEF);
+		token_kinds[symbol_kind::S_YYEOF] = yy::newt_parser::token::T_END;
+		for (int token = yy::newt_parser::token::T_YYerror;
+				token
+						< yy::newt_parser::token::T_YYerror
+								+ yy::newt_parser::YYNTOKENS; token++) {
+			auto kind =
+					yy::newt_parser::by_kind(token_kind_type(token)).kind();
+			if (kind != symbol_kind::S_YYUNDEF || token
+					== yy::newt_parser::token::T_YYUNDEF) {
+				token_kinds[kind] = token_kind_type(token);
+			}
+		}
+		return token_kinds;
+	}();
+	return instance;
+}
+
+// Entries are written in host byte order, with unsigned integers (including
+// line and column numbers) as variable-length quantities.
+void Write(std::string& buffer, std::uint32_t value) {
+	while (value >= 0x80) {
+		buffer.push_back(static_cast<char>(value | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back(static_cast<char>(value));
+}
+
+void Write(std::string& buffer, const double value) {
+	buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void Write(std::string& buffer, const std::string& value) {
+	Write(buffer, std::uint32_t(value.size()));
+	buffer.append(value);
+}
+
+void Write(std::string& buffer, const yy::location& location) {
+	Write(buffer, std::uint32_t(location.begin.line));
+	Write(buffer, std::uint32_t(location.begin.column));
+	Write(buffer, std::uint32_t(location.end.line - location.begin.line));
+	Write(buffer, std::uint32_t(location.end.column));
+}
+
+void Write(std::string& buffer, const ScannedToken& token) {
+	if (token.IsImport()) {
+		Write(buffer, IMPORT_KIND);
+		Write(buffer, token.GetLocation());
+		Write(buffer, *token.GetImportName());
+		return;
+	}
+
+	auto& symbol = token.GetSymbol();
+	auto kind = symbol.kind();
+	Write(buffer, std::uint32_t(kind));
+	Write(buffer, token.GetLocation());
+	switch (kind) {
+	case symbol_kind::S_TRUE:
+	case symbol_kind::S_FALSE:
+		Write(buffer, std::uint32_t(symbol.value.as<bool>()));
+		break;
+	case symbol_kind::S_IDENTIFIER:
+	case symbol_kind::S_STRING_CONSTANT:
+		Write(buffer, *symbol.value.as<plain_shared_ptr<std::string>>());
+		break;
+	case symbol_kind::S_INT_CONSTANT:
+		// the scanner only produces non-negative constants
+		Write(buffer, std::uint32_t(symbol.value.as<int>()));
+		break;
+	case symbol_kind::S_BYTE_CONSTANT:
+		Write(buffer, std::uint32_t(symbol.value.as<std::uint8_t>()));
+		break;
+	case symbol_kind::S_DOUBLE_CONSTANT:
+		Write(buffer, symbol.value.as<double>());
+		break;
+	default:
+		break;
+	}
+}
+
+// Reads an entry from memory. Each read returns false, and leaves the reader
+// exhausted, if the entry is too short.
+class Reader {
+public:
+	Reader(const std::string& buffer) :
+			m_next(buffer.data()), m_end(buffer.data() + buffer.size()) {
+	}
+
+	const bool Read(std::uint32_t& value) {
+		value = 0;
+		for (int shift = 0; shift < 32; shift += 7) {
+			if (m_next == m_end) {
+				return false;
+			}
+
+			std::uint8_t byte = *m_next++;
+			value |= std::uint32_t(byte & 0x7F) << shift;
+			if (byte < 0x80) {
+				return true;
+			}
+		}
+
+		m_next = m_end;
+		return false;
+	}
+
+	const bool Read(double& value) {
+		if (size_t(m_end - m_next) < sizeof(value)) {
+			m_next = m_end;
+			return false;
+		}
+
+		std::copy(m_next, m_next + sizeof(value),
+				reinterpret_cast<char*>(&value));
+		m_next += sizeof(value);
+		return true;
+	}
+
+	const bool Read(std::string& value) {
+		std::uint32_t size;
+		if (!Read(size) || size_t(m_end - m_next) < size) {
+			m_next = m_end;
+			return false;
+		}
+
+		value.assign(m_next, size);
+		m_next += size;
+		return true;
+	}
+
+	const bool Read(yy::location& location,
+			volatile_shared_ptr<std::string> file_name) {
+		std::uint32_t begin_line, begin_column, line_count, end_column;
+		if (!(Read(begin_line) && Read(begin_column) && Read(line_count)
+				&& Read(end_column))) {
+			return false;
+		}
+
+		location.begin = yy::position(file_name.get(), begin_line,
+				begin_column);
+		location.end = yy::position(file_name.get(), begin_line + line_count,
+				end_column);
+		return true;
+	}
+
+	const bool Read(volatile_shared_ptr<std::string> file_name,
+			token_list& tokens) {
+		std::uint32_t kind;
+		yy::location location;
+		if (!(Read(kind) && Read(location, file_name))) {
+			return false;
+		}
+
+		if (kind == IMPORT_KIND) {
+			std::string import_name;
+			if (!Read(import_name)) {
+				return false;
+			}
+
+			tokens.push_back(
+					ScannedToken(make_shared<const std::string>(import_name),
+							location));
+			return true;
+		}
+
+		if (kind >= yy::newt_parser::YYNTOKENS) {
+			return false;
+		}
+
+		auto token = GetTokenKinds()[kind];
+		std::uint32_t value;
+		switch (kind) {
+		case symbol_kind::S_TRUE:
+		case symbol_kind::S_FALSE:
+			if (!Read(value)) {
+				return false;
+			}
+			tokens.push_back(
+					ScannedToken(
+							yy::newt_parser::symbol_type(token, value != 0,
+									location)));
+			return true;
+		case symbol_kind::S_IDENTIFIER: {
+			std::string name;
+			if (!Read(name)) {
+				return false;
+			}
+			tokens.push_back(
+					ScannedToken(
+							yy::newt_parser::symbol_type(token, Intern(name),
+									location)));
+			return true;
+		}
+		case symbol_kind::S_STRING_CONSTANT: {
+			std::string constant;
+			if (!Read(constant)) {
+				return false;
+			}
+			tokens.push_back(
+					ScannedToken(
+							yy::newt_parser::symbol_type(token,
+									make_shared<const std::string>(constant),
+									location)));
+			return true;
+		}
+		case symbol_kind::S_INT_CONSTANT:
+			if (!Read(value)) {
+				return false;
+			}
+			tokens.push_back(
+					ScannedToken(
+							yy::newt_parser::symbol_type(token, int(value),
+									location)));
+			return true;
+		case symbol_kind::S_BYTE_CONSTANT:
+			if (!Read(value)) {
+				return false;
+			}
+			tokens.push_back(
+					ScannedToken(
+							yy::newt_parser::symbol_type(token,
+									std::uint8_t(value), location)));
+			return true;
+		case symbol_kind::S_DOUBLE_CONSTANT: {
+			double constant;
+			if (!Read(constant)) {
+				return false;
+			}
+			tokens.push_back(
+					ScannedToken(
+							yy::newt_parser::symbol_type(token, constant,
+									location)));
+			return true;
+		}
+		default:
+			tokens.push_back(
+					ScannedToken(
+							yy::newt_parser::symbol_type(token, location)));
+			return true;
+		}
+	}
+
+	const bool AtEnd() const {
+		return m_next == m_end;
+	}
+
+private:
+	const char* m_next;
+	const char* const m_end;
+};
+}
+
+const std::string ImportCache::GetEntryPath(FILE* source) const {
+	auto hash = GetInterpreterHash();
+	char buffer[65536];
+	size_t count;
+	while ((count = fread(buffer, 1, sizeof(buffer), source)) > 0) {
+		hash = Hash(hash, buffer, count);
+	}
+	rewind(source);
+
+	std::ostringstream path;
+	path << m_directory << Builtins::get_path_separator() << std::hex
+			<< std::setw(16) << std::setfill('0') << hash << ".nwtc";
+	return path.str();
+}
+
+const_shared_ptr<token_list> ImportCache::Load(const std::string& entry_path,
+		volatile_shared_ptr<std::string> file_name) const {
+	std::ifstream stream(entry_path, std::ios::in | std::ios::binary);
+	if (!stream) {
+		return nullptr;
+	}
+
+	std::ostringstream contents;
+	contents << stream.rdbuf();
+	auto buffer = contents.str();
+	if (buffer.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0) {
+		return nullptr;
+	}
+
+	auto body = buffer.substr(sizeof(MAGIC));
+	Reader reader(body);
+	std::uint32_t format;
+	std::uint32_t count;
+	if (!(reader.Read(format) && format == FORMAT && reader.Read(count))) {
+		return nullptr;
+	}
+
+	auto tokens = make_shared<token_list>();
+	tokens->reserve(count);
+	for (std::uint32_t i = 0; i < count; i++) {
+		if (!reader.Read(file_name, *tokens)) {
+			return nullptr;
+		}
+	}
+
+	if (!reader.AtEnd()) {
+		return nullptr;
+	}
+
+	return tokens;
+}
+
+const bool ImportCache::Store(const std::string& entry_path,
+		const token_list& tokens) const {
+	std::string buffer(MAGIC, sizeof(MAGIC));
+	Write(buffer, FORMAT);
+	Write(buffer, std::uint32_t(tokens.size()));
+	for (auto& token : tokens) {
+		Write(buffer, token);
+	}
+
+	// write a temporary file and rename it into place, so a concurrent run
+	// never loads a partial entry
+	auto temporary_path = entry_path + ".tmp";
+	{
+		std::ofstream stream(temporary_path,
+				std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!stream.write(buffer.data(), buffer.size()).flush()) {
+			stream.close();
+			remove(temporary_path.c_str());
+			return false;
+		}
+	}
+
+	if (rename(temporary_path.c_str(), entry_path.c_str()) != 0) {
+		remove(temporary_path.c_str());
+		return false;
+	}
+
+	return true;
+}
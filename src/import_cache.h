@@ -0,0 +1,111 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMPORT_CACHE_H_
+#define IMPORT_CACHE_H_
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "parser.tab.hh"
+
+/**
+ * A token scanned from an imported file, or an import nested in it. Nested
+ * imports are kept by name, and are resolved again each time the file's
+ * tokens are replayed, so they are found through the current include paths
+ * and skipped if they have already been imported.
+ */
+class ScannedToken {
+public:
+	ScannedToken(const yy::newt_parser::symbol_type& symbol) :
+			m_symbol(symbol), m_import_name(), m_location(symbol.location) {
+	}
+
+	ScannedToken(const_shared_ptr<std::string> import_name,
+			const yy::location& location) :
+			m_symbol(), m_import_name(import_name), m_location(location) {
+	}
+
+	const yy::newt_parser::symbol_type& GetSymbol() const {
+		return m_symbol;
+	}
+
+	const bool IsImport() const {
+		return m_import_name != nullptr;
+	}
+
+	// Get the import name as written in the source, e.g. "lib.io".
+	plain_shared_ptr<std::string> GetImportName() const {
+		return m_import_name;
+	}
+
+	const yy::location& GetLocation() const {
+		return m_location;
+	}
+
+private:
+	const yy::newt_parser::symbol_type m_symbol;
+	const plain_shared_ptr<std::string> m_import_name;
+	const yy::location m_location;
+};
+
+typedef std::vector<ScannedToken> token_list;
+
+/**
+ * A directory of the tokens scanned from imported files, so later runs can
+ * replay them instead of scanning the files again.
+ *
+ * An import is spliced into the token stream of the file that imports it, and
+ * is parsed and preprocessed as part of that file, so its tokens are the
+ * largest part of the work that does not depend on the importer. Entries are
+ * keyed by a hash of the file's contents, the interpreter version and the
+ * parser's token table; an edited file or a different interpreter reads a
+ * different entry rather than a stale one.
+ */
+class ImportCache {
+public:
+	ImportCache(const std::string& directory) :
+			m_directory(directory) {
+	}
+
+	/**
+	 * Get the path of the entry for the contents of the given file. The file
+	 * is read to its end, and then rewound.
+	 */
+	const std::string GetEntryPath(FILE* source) const;
+
+	/**
+	 * Load the entry at the given path, with locations in the given file.
+	 * Returns nullptr if there is no readable entry.
+	 */
+	const_shared_ptr<token_list> Load(const std::string& entry_path,
+			volatile_shared_ptr<std::string> file_name) const;
+
+	/**
+	 * Store the given tokens at the given path, replacing any existing entry.
+	 * Returns false if the entry cannot be written.
+	 */
+	const bool Store(const std::string& entry_path,
+			const token_list& tokens) const;
+
+private:
+	const std::string m_directory;
+};
+
+#endif /* IMPORT_CACHE_H_ */
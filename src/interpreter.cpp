@@ -0,0 +1,116 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <interpreter.h>
+#include <mutex>
+#include <builtins.h>
+#include <execution_context.h>
+#include <statement_block.h>
+
+namespace {
+std::mutex& GetCompileMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+}
+
+Interpreter::Interpreter(const_shared_ptr<string_list> include_paths,
+		const TRACE trace, plain_shared_ptr<ImportCache> import_cache,
+		const shared_ptr<ExecutionContext> builtin_context) :
+		m_include_paths(include_paths), m_trace(trace), m_import_cache(
+				import_cache), m_builtin_context(builtin_context), m_file_names(
+				make_shared<file_name_map>()) {
+}
+
+const TypedResult<Interpreter> Interpreter::Create(
+		const_shared_ptr<string_list> include_paths, const TRACE trace,
+		plain_shared_ptr<ImportCache> import_cache) {
+	std::lock_guard<std::mutex> lock(GetCompileMutex());
+
+	auto builtin_statements = Builtins::get_builtin_statement_block();
+	auto builtin_context = make_shared<ExecutionContext>(
+			Modifier::Type::MUTABLE);
+	auto errors = builtin_statements->Preprocess(builtin_context,
+			const_shared_ptr<TypeSpecifier>()).GetErrors();
+	if (ErrorList::IsTerminator(errors)) {
+		errors = builtin_statements->Execute(builtin_context).GetErrors();
+	}
+
+	if (!ErrorList::IsTerminator(errors)) {
+		return TypedResult<Interpreter>(nullptr, errors);
+	}
+
+	return TypedResult<Interpreter>(
+			shared_ptr<Interpreter>(
+					new Interpreter(include_paths, trace, import_cache,
+							builtin_context)));
+}
+
+const TypedResult<Program> Interpreter::Compile(
+		const_shared_ptr<string> file_name, const Bindings& inputs) const {
+	std::lock_guard<std::mutex> lock(GetCompileMutex());
+
+	Driver driver(m_include_paths, m_trace, m_file_names, m_import_cache);
+	auto parse_result = driver.parse(driver.GetFileName(*file_name));
+	return Compile(driver, parse_result, inputs);
+}
+
+const TypedResult<Program> Interpreter::CompileString(const string& source,
+		const Bindings& inputs) const {
+	std::lock_guard<std::mutex> lock(GetCompileMutex());
+
+	Driver driver(m_include_paths, m_trace, m_file_names, m_import_cache);
+	auto parse_result = driver.parse_string(source);
+	return Compile(driver, parse_result, inputs);
+}
+
+const TypedResult<Program> Interpreter::Compile(const Driver& driver,
+		const int parse_result, const Bindings& inputs) const {
+	if (parse_result != 0 || driver.GetErrorCount() != 0) {
+		auto errors = driver.GetErrors();
+		if (ErrorList::IsTerminator(errors)) {
+			errors = ErrorList::From(
+					make_shared<Error>(Error::PARSE, Error::PARSE_ERROR,
+							yy::position(), "Parsing failed."), errors);
+		}
+
+		return TypedResult<Program>(nullptr, errors);
+	}
+
+	auto statement_block = driver.GetStatementBlock();
+	auto context = make_shared<ExecutionContext>(Modifier::Type::MUTABLE,
+			LifeTime::ROOT);
+	context->LinkToParent(m_builtin_context);
+
+	for (auto& input : inputs.GetValues()) {
+		context->InsertSymbol(input.first, input.second);
+	}
+
+	auto errors = statement_block->Preprocess(context,
+			TypeTable::GetNilTypeSpecifier()).GetErrors();
+	if (!ErrorList::IsTerminator(errors)) {
+		// errors are accumulated in reverse order
+		return TypedResult<Program>(nullptr, ErrorList::Reverse(errors));
+	}
+
+	return TypedResult<Program>(
+			shared_ptr<Program>(
+					new Program(statement_block, m_file_names, context,
+							m_builtin_context)));
+}
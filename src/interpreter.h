@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INTERPRETER_H_
+#define INTERPRETER_H_
+
+#include <driver.h>
+#include <program.h>
+
+/**
+ * The entry point for programs that embed newt.
+ *
+ * An interpreter holds the builtin declarations, which are set up once, and
+ * compiles scripts into programs that can be executed many times:
+ *
+ *     auto interpreter = Interpreter::Create(include_paths).GetData();
+ *     Bindings inputs;
+ *     inputs.Set("n", 0);
+ *     auto program = interpreter->Compile(file_name, inputs).GetData();
+ *     inputs.Set("n", 10);
+ *     auto execution = program->Execute(inputs);
+ *     auto result = execution->GetInt("result");
+ *
+ * Compilation is serialized, because the scanner and parser are not
+ * reentrant. Compiled programs may be executed on any number of threads at
+ * once.
+ */
+class Interpreter {
+public:
+	/**
+	 * Create an interpreter that resolves imports against the given include
+	 * paths. If an import cache is given, the tokens scanned from imported
+	 * files are stored in it, and replayed when the same contents are
+	 * imported again, by this or a later process.
+	 */
+	static const TypedResult<Interpreter> Create(
+			const_shared_ptr<string_list> include_paths, const TRACE trace =
+					NO_TRACE, plain_shared_ptr<ImportCache> import_cache =
+					nullptr);
+
+	/**
+	 * Parse and preprocess the given script. The inputs are declared as
+	 * top-level variables before the script is preprocessed, with the types
+	 * and initial values of the given bindings.
+	 *
+	 * Scanner and parser errors are reported as errors of class PARSE;
+	 * preprocessing errors are SEMANTIC.
+	 */
+	const TypedResult<Program> Compile(const_shared_ptr<string> file_name,
+			const Bindings& inputs = Bindings()) const;
+
+	const TypedResult<Program> CompileString(const string& source,
+			const Bindings& inputs = Bindings()) const;
+
+private:
+	Interpreter(const_shared_ptr<string_list> include_paths, const TRACE trace,
+			plain_shared_ptr<ImportCache> import_cache,
+			const shared_ptr<ExecutionContext> builtin_context);
+
+	const TypedResult<Program> Compile(const Driver& driver,
+			const int parse_result, const Bindings& inputs) const;
+
+	const_shared_ptr<string_list> m_include_paths;
+	const TRACE m_trace;
+	const plain_shared_ptr<ImportCache> m_import_cache;
+	const shared_ptr<ExecutionContext> m_builtin_context;
+
+	/**
+	 * The names of every file compiled by this interpreter. Compiled programs
+	 * keep the table alive; errors only refer to it, so they are valid while
+	 * the interpreter or any of its programs is.
+	 */
+	const volatile_shared_ptr<file_name_map> m_file_names;
+};
+
+#endif /* INTERPRETER_H_ */
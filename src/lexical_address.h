@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEXICAL_ADDRESS_H_
+#define LEXICAL_ADDRESS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <symbol_map.h>
+
+/**
+ * The location of a symbol relative to the context that references it: the
+ * number of parent links to follow, and the slot in the table found there.
+ *
+ * The address is cached on a syntax tree node that may be evaluated by several
+ * threads at once, so both parts are packed into one atomic word and always
+ * read and written together. An address is only a hint: the symbol found
+ * there is checked by name before use, so a stale or racing update is
+ * harmless.
+ */
+class LexicalAddress {
+public:
+	LexicalAddress() :
+			m_packed(Pack(0, SymbolMap::NO_SLOT)) {
+	}
+
+	void Get(size_t& depth, size_t& slot) const {
+		auto packed = m_packed.load(std::memory_order_relaxed);
+		depth = packed >> 32;
+		slot = packed & NO_SLOT;
+		if (slot == NO_SLOT) {
+			slot = SymbolMap::NO_SLOT;
+		}
+	}
+
+	void Set(const size_t depth, const size_t slot) {
+		m_packed.store(Pack(depth, slot), std::memory_order_relaxed);
+	}
+
+private:
+	static const uint64_t NO_SLOT = 0xFFFFFFFF;
+
+	static const uint64_t Pack(const size_t depth, const size_t slot) {
+		if (depth > NO_SLOT || slot >= NO_SLOT) {
+			// too far away to cache; resolve by name every time
+			return NO_SLOT;
+		}
+
+		return (uint64_t(depth) << 32) | slot;
+	}
+
+	std::atomic<uint64_t> m_packed;
+};
+
+#endif /* LEXICAL_ADDRESS_H_ */
@@ -0,0 +1,104 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <mapped_file.h>
+#include <cerrno>
+
+#if defined _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::uint8_t* data, const size_t size) :
+		m_data(data), m_size(size) {
+}
+
+#if defined _WIN32
+// no mmap; fall back to reading the whole file into memory
+const_shared_ptr<MappedFile> MappedFile::Open(const std::string& path,
+		int& error_code) {
+	std::ifstream stream(path, std::ios::in | std::ios::binary);
+	if (!stream) {
+		error_code = errno;
+		return nullptr;
+	}
+
+	stream.seekg(0, std::ios::end);
+	size_t size = stream.tellg();
+	stream.seekg(0, std::ios::beg);
+
+	auto data = new std::uint8_t[size];
+	stream.read(reinterpret_cast<char*>(data), size);
+	if (!stream) {
+		error_code = errno;
+		delete[] data;
+		return nullptr;
+	}
+
+	return const_shared_ptr<MappedFile>(new MappedFile(data, size));
+}
+
+MappedFile::~MappedFile() {
+	delete[] m_data;
+}
+#else
+const_shared_ptr<MappedFile> MappedFile::Open(const std::string& path,
+		int& error_code) {
+	int descriptor = open(path.c_str(), O_RDONLY);
+	if (descriptor == -1) {
+		error_code = errno;
+		return nullptr;
+	}
+
+	struct stat status;
+	if (fstat(descriptor, &status) == -1) {
+		error_code = errno;
+		close(descriptor);
+		return nullptr;
+	}
+
+	size_t size = status.st_size;
+	const std::uint8_t* data = nullptr;
+	if (size > 0) {
+		// the mapping holds its own reference to the file, so the descriptor
+		// can be closed straight away
+		void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor,
+				0);
+		if (address == MAP_FAILED) {
+			error_code = errno;
+			close(descriptor);
+			return nullptr;
+		}
+		data = static_cast<const std::uint8_t*>(address);
+	}
+
+	close(descriptor);
+	return const_shared_ptr<MappedFile>(new MappedFile(data, size));
+}
+
+MappedFile::~MappedFile() {
+	if (m_data) {
+		munmap(const_cast<std::uint8_t*>(m_data), m_size);
+	}
+}
+#endif
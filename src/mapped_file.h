@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+#include <cstdint>
+#include <string>
+#include <defaults.h>
+
+/**
+ * A read-only view of a file's contents, mapped into memory.
+ *
+ * The mapping is released when the last reference to it is dropped, so arrays
+ * that view it remain valid after the file handle that created it is closed.
+ */
+class MappedFile {
+public:
+	/**
+	 * Map the file at the given path. Returns nullptr and sets error_code to
+	 * the errno value on failure.
+	 */
+	static const_shared_ptr<MappedFile> Open(const std::string& path,
+			int& error_code);
+
+	virtual ~MappedFile();
+
+	const std::uint8_t* GetData() const {
+		return m_data;
+	}
+
+	const size_t GetSize() const {
+		return m_size;
+	}
+
+private:
+	MappedFile(const std::uint8_t* data, const size_t size);
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const std::uint8_t* m_data;
+	const size_t m_size;
+};
+
+#endif /* MAPPED_FILE_H_ */
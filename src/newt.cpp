@@ -21,9 +21,17 @@
 #include <string.h>
 #include <memory>
 #include <fstream>
+#include <chrono>
 
 #include "builtins.h"
-#include "driver.h"
+#include "interpreter.h"
+#include "execution_context.h"
+#include "virtual_machine.h"
+#include "profiler.h"
+#include "optimizer.h"
+#include "call_stack.h"
+#include "parallel.h"
+#include "run_statistics.h"
 
 using namespace std;
 
@@ -36,6 +44,45 @@ void print_help() {
 	cout
 			<< "  --include-paths  : Specify a pipe-separated list of include paths"
 			<< endl;
+	cout
+			<< "  --import-cache=<dir> : Store the tokens scanned from imported files in <dir>,"
+			<< endl;
+	cout
+			<< "                     and reuse them while the files are unchanged"
+			<< endl;
+	cout
+			<< "  --engine=<name>  : Select the execution engine: 'tree' (default) or 'vm'"
+			<< endl;
+	cout
+			<< "  --profile[=file] : Print a flat profile to stderr on exit, and write collapsed"
+			<< endl;
+	cout
+			<< "                     stacks to the given file (default: <script>.folded)"
+			<< endl;
+	cout
+			<< "  --stats          : Print wall time, peak memory use and allocation count to stderr on exit"
+			<< endl;
+	cout
+			<< "  --max-stack=<size> : Run invocations on a heap-allocated stack of at most"
+			<< endl;
+	cout
+			<< "                     <size> bytes (with an optional k, m or g suffix) instead of"
+			<< endl;
+	cout
+			<< "                     limiting invocation depth"
+			<< endl;
+	cout
+			<< "  --threads=<count> : Run parallel loops on at most <count> threads (default:"
+			<< endl;
+	cout
+			<< "                     one per hardware thread)"
+			<< endl;
+	cout
+			<< "  -O0              : Disable optimization"
+			<< endl;
+	cout
+			<< "  -O1              : Fold constant expressions and branches (default)"
+			<< endl;
 	cout << "Debug Options:" << endl;
 	cout
 			<< "  --debug          : Print debug information during script execution"
@@ -49,6 +96,37 @@ void print_help() {
 	cout
 			<< "  --trace-import   : Print import information during script execution"
 			<< endl;
+	cout
+			<< "  --trace-optimization : Print each simplification made by the optimizer"
+			<< endl;
+}
+
+size_t parse_size(const char* text) {
+	char* suffix;
+	auto size = strtoull(text, &suffix, 10);
+	if (suffix == text) {
+		return 0;
+	}
+
+	switch (*suffix) {
+	case 'k':
+	case 'K':
+		size <<= 10;
+		suffix++;
+		break;
+	case 'm':
+	case 'M':
+		size <<= 20;
+		suffix++;
+		break;
+	case 'g':
+	case 'G':
+		size <<= 30;
+		suffix++;
+		break;
+	}
+
+	return *suffix == '\0' ? size : 0;
 }
 
 int get_exit_code(bool debug, int exit_code) {
@@ -61,6 +139,8 @@ int get_exit_code(bool debug, int exit_code) {
 }
 
 int main(int argc, char *argv[]) {
+	auto start_time = chrono::steady_clock::now();
+
 	if (argc < 2) {
 		cerr << "Input script must be specified." << endl;
 		return EXIT_FAILURE;
@@ -78,7 +158,11 @@ int main(int argc, char *argv[]) {
 
 	bool debug = false;
 	bool analyze = false;
+	bool profile = false;
+	string profile_path;
+	bool stats = false;
 	TRACE trace = NO_TRACE;
+	plain_shared_ptr<ImportCache> import_cache;
 	volatile_shared_ptr<string_list> import_paths = make_shared<string_list>();
 	import_paths->push_back(make_shared<const string>("."));
 	int i = 1;
@@ -103,6 +187,61 @@ int main(int argc, char *argv[]) {
 			trace = TRACE(trace | IMPORT);
 		}
 
+		if (strcmp(argv[i], "--trace-optimization") == 0) {
+			TRACE_OPTIMIZATION = true;
+		}
+
+		if (strcmp(argv[i], "-O0") == 0) {
+			OPTIMIZATION_LEVEL = NO_OPTIMIZATION;
+		} else if (strcmp(argv[i], "-O1") == 0) {
+			OPTIMIZATION_LEVEL = CONSTANT_FOLDING;
+		}
+
+		if (strncmp(argv[i], "--engine=", 9) == 0) {
+			if (strcmp(argv[i] + 9, "tree") == 0) {
+				EXECUTION_ENGINE = TREE_WALKER;
+			} else if (strcmp(argv[i] + 9, "vm") == 0) {
+				EXECUTION_ENGINE = VIRTUAL_MACHINE;
+			} else {
+				cerr << "Unknown execution engine '" << argv[i] + 9 << "'."
+						<< endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		if (strncmp(argv[i], "--max-stack=", 12) == 0) {
+			MAX_STACK = parse_size(argv[i] + 12);
+			if (MAX_STACK == 0) {
+				cerr << "Invalid stack size '" << argv[i] + 12 << "'." << endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		if (strncmp(argv[i], "--threads=", 10) == 0) {
+			char* end;
+			PARALLELISM = strtoul(argv[i] + 10, &end, 10);
+			if (PARALLELISM == 0 || *end != '\0') {
+				cerr << "Invalid thread count '" << argv[i] + 10 << "'."
+						<< endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		if (strcmp(argv[i], "--profile") == 0) {
+			profile = true;
+		} else if (strncmp(argv[i], "--profile=", 10) == 0) {
+			profile = true;
+			profile_path = string(argv[i] + 10);
+		}
+
+		if (strcmp(argv[i], "--stats") == 0) {
+			stats = true;
+		}
+
+		if (strncmp(argv[i], "--import-cache=", 15) == 0) {
+			import_cache = make_shared<ImportCache>(string(argv[i] + 15));
+		}
+
 		if (strcmp(argv[i], "--include-paths") == 0) {
 			auto as_string = string(argv[++i]);
 			auto commandline_include_paths = Unique(Tokenize(as_string, "|"));
@@ -134,139 +273,106 @@ int main(int argc, char *argv[]) {
 		cout << "Parsing file " << *filename << "..." << endl;
 	}
 
-	Driver driver(import_paths, trace);
-	int builtin_parse_result = driver.parse_string(
-			*Builtins::get_builtin_definition());
-	if (builtin_parse_result == 0) {
-		auto builtin_statements = driver.GetStatementBlock();
-		auto builtin_context = make_shared<ExecutionContext>(
-				Modifier::Type::MUTABLE);
-		auto builtin_preprocess_result = builtin_statements->Preprocess(
-				builtin_context, const_shared_ptr<TypeSpecifier>());
-
-		auto builtin_errors = builtin_preprocess_result.GetErrors();
-		if (ErrorList::IsTerminator(builtin_errors)) {
-			auto builtin_execute_result = builtin_statements->Execute(
-					builtin_context);
-
-			builtin_errors = builtin_execute_result.GetErrors();
-			if (ErrorList::IsTerminator(builtin_errors)) {
-				int parse_result = driver.parse(filename);
-				if (parse_result != 0 || driver.GetErrorCount() != 0) {
-					if (debug) {
-						cout << "Parsed file " << *filename << "." << endl;
-					}
-
-					cerr << driver.GetErrorCount() << " error";
-					if (driver.GetErrorCount() > 1)
-						cout << "s";
-					cout << " found; giving up." << endl;
-
-					return get_exit_code(debug, EXIT_FAILURE);
-				}
-
-				int exit_code = EXIT_SUCCESS;
-
-				if (parse_result == 0) {
-					auto main_statement_block = driver.GetStatementBlock();
-					//auto builtin_context = Builtins::GetBuiltinContext();
-					auto root_context = make_shared<ExecutionContext>(
-							Modifier::Type::MUTABLE, LifeTime::ROOT);
-					root_context->LinkToParent(builtin_context);
-					auto semantic_errors =
-							main_statement_block->Preprocess(root_context,
-									TypeTable::GetNilTypeSpecifier()).GetErrors();
-
-					if (ErrorList::IsTerminator(semantic_errors)) {
-						if (debug) {
-							cout << "Parsed file " << *filename << "." << endl;
-						}
-
-						if (!analyze) {
-							auto execution_result =
-									main_statement_block->Execute(root_context);
-							auto execution_errors =
-									execution_result.GetErrors();
-
-							bool has_execution_errors = false;
-							while (!ErrorList::IsTerminator(execution_errors)) {
-								has_execution_errors = true;
-								cerr << execution_errors->GetData()->ToString()
-										<< endl;
-								execution_errors = execution_errors->GetNext();
-							}
-
-							if (debug) {
-								cout << "Root Symbol Table:" << endl;
-								cout << "----------------" << endl;
-								root_context->print(cout,
-										*root_context->GetTypeTable(),
-										Indent(0));
-								cout << endl;
-								cout << "Root Type Table:" << endl;
-								cout << "----------------" << endl;
-								root_context->GetTypeTable()->print(cout,
-										Indent(0));
-							}
-
-							auto execution_exit_code =
-									execution_result.GetExitCode();
-							if (execution_exit_code
-									!= ExecutionResult::GetDefaultExitCode()) {
-								exit_code = *execution_exit_code;
-							}
-
-							// cleanup any open file handles
-							auto file_handle_map =
-									Builtins::get_file_handle_map();
-							for (file_handle_map::iterator it =
-									file_handle_map->begin();
-									it != file_handle_map->end(); ++it) {
-								auto stream = it->second;
-								stream->close();
-							}
-
-							return get_exit_code(debug,
-									has_execution_errors ?
-									EXIT_FAILURE :
-															exit_code);
-						}
-					} else {
-						//reverse linked list of errors, which comes to us in reverse order
-						semantic_errors = ErrorList::Reverse(semantic_errors);
-
-						int semantic_error_count = 0;
-						ErrorListRef error = semantic_errors;
-						while (!ErrorList::IsTerminator(error)) {
-							semantic_error_count++;
-							cerr << *(error->GetData()) << endl;
-							error = error->GetNext();
-						}
-
-						if (debug) {
-							cout << "Parsed file " << *filename << "." << endl;
-						}
-
-						if (semantic_error_count == 1) {
-							cout << "1 error found; giving up." << endl;
-						} else {
-							cout << semantic_error_count
-									<< " errors found; giving up." << endl;
-						}
-
-						return get_exit_code(debug, EXIT_FAILURE);
-					}
-				}
-			}
+	auto interpreter_result = Interpreter::Create(import_paths, trace,
+			import_cache);
+	auto errors = interpreter_result.GetErrors();
+	if (!ErrorList::IsTerminator(errors)) {
+		while (!ErrorList::IsTerminator(errors)) {
+			cerr << errors->GetData()->ToString() << endl;
+			errors = errors->GetNext();
 		}
 
-		if (!ErrorList::IsTerminator(builtin_errors)) {
-			while (!ErrorList::IsTerminator(builtin_errors)) {
-				cerr << builtin_errors->GetData()->ToString() << endl;
-				builtin_errors = builtin_errors->GetNext();
-			}
+		return get_exit_code(debug, EXIT_FAILURE);
+	}
+
+	auto compile_result = interpreter_result.GetData()->Compile(filename);
+	errors = compile_result.GetErrors();
+	if (!ErrorList::IsTerminator(errors)) {
+		bool parse_failed = errors->GetData()->GetErrorClass() == Error::PARSE;
+		int error_count = 0;
+		while (!ErrorList::IsTerminator(errors)) {
+			error_count++;
+			cerr << *(errors->GetData()) << endl;
+			errors = errors->GetNext();
+		}
 
-			return get_exit_code(debug, EXIT_FAILURE);
+		if (debug) {
+			cout << "Parsed file " << *filename << "." << endl;
 		}
+
+		if (parse_failed) {
+			cerr << error_count << " error";
+			if (error_count > 1)
+				cout << "s";
+			cout << " found; giving up." << endl;
+		} else if (error_count == 1) {
+			cout << "1 error found; giving up." << endl;
+		} else {
+			cout << error_count << " errors found; giving up." << endl;
+		}
+
+		return get_exit_code(debug, EXIT_FAILURE);
+	}
+
+	if (debug) {
+		cout << "Parsed file " << *filename << "." << endl;
+	}
+
+	if (analyze) {
+		return EXIT_SUCCESS;
+	}
+
+	if (profile) {
+		Profiler::Start(*filename);
+	}
+
+	auto execution = compile_result.GetData()->Execute();
+
+	if (profile) {
+		ofstream collapsed(
+				profile_path.empty() ? *filename + ".folded" : profile_path);
+		Profiler::Stop(cerr, collapsed);
+	}
+
+	if (stats) {
+		chrono::duration<double, milli> wall_time = chrono::steady_clock::now()
+				- start_time;
+		RunStatistics::Write(cerr, wall_time.count());
 	}
+
+	auto execution_errors = execution->GetErrors();
+	bool has_execution_errors = false;
+	while (!ErrorList::IsTerminator(execution_errors)) {
+		has_execution_errors = true;
+		cerr << execution_errors->GetData()->ToString() << endl;
+		execution_errors = execution_errors->GetNext();
+	}
+
+	if (debug) {
+		auto root_context = execution->GetContext();
+		cout << "Root Symbol Table:" << endl;
+		cout << "----------------" << endl;
+		root_context->print(cout, *root_context->GetTypeTable(), Indent(0));
+		cout << endl;
+		cout << "Root Type Table:" << endl;
+		cout << "----------------" << endl;
+		root_context->GetTypeTable()->print(cout, Indent(0));
+	}
+
+	int exit_code = EXIT_SUCCESS;
+	auto execution_exit_code = execution->GetExitCode();
+	if (execution_exit_code) {
+		exit_code = *execution_exit_code;
+	}
+
+	// cleanup any open file handles
+	auto file_handle_map = Builtins::get_file_handle_map();
+	for (file_handle_map::iterator it = file_handle_map->begin();
+			it != file_handle_map->end(); ++it) {
+		auto stream = it->second;
+		stream->close();
+	}
+
+	return get_exit_code(debug,
+			has_execution_errors ? EXIT_FAILURE : exit_code);
 }
@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <optimizer.h>
+#include <iostream>
+#include <expression.h>
+
+OptimizationLevel OPTIMIZATION_LEVEL = CONSTANT_FOLDING;
+bool TRACE_OPTIMIZATION = false;
+
+const_shared_ptr<Result> Optimizer::Fold(const Expression& expression,
+		const shared_ptr<ExecutionContext> context) {
+	if (OPTIMIZATION_LEVEL < CONSTANT_FOLDING || !expression.IsConstant()) {
+		return nullptr;
+	}
+
+	auto result = expression.Evaluate(context, context);
+	if (!ErrorList::IsTerminator(result->GetErrors())) {
+		return nullptr;
+	}
+
+	if (TRACE_OPTIMIZATION) {
+		auto value = expression.ToString(context);
+		if (ErrorList::IsTerminator(value.GetErrors())) {
+			Trace(expression.GetLocation(),
+					"folded constant expression to " + *value.GetData());
+		}
+	}
+
+	return result;
+}
+
+const Optimizer::Condition Optimizer::GetCondition(
+		const Expression& expression,
+		const shared_ptr<ExecutionContext> context) {
+	if (OPTIMIZATION_LEVEL < CONSTANT_FOLDING || !expression.IsConstant()) {
+		return DYNAMIC;
+	}
+
+	// any folding has already happened as the expression was validated
+	auto result = expression.Evaluate(context, context);
+	if (!ErrorList::IsTerminator(result->GetErrors())) {
+		return DYNAMIC;
+	}
+
+	return result->GetTaggedValue().As<bool>() ? ALWAYS_TRUE : ALWAYS_FALSE;
+}
+
+void Optimizer::Trace(const yy::location location,
+		const std::string& message) {
+	if (TRACE_OPTIMIZATION) {
+		std::cout << location.begin << ": " << message << std::endl;
+	}
+}
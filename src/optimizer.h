@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPTIMIZER_H_
+#define OPTIMIZER_H_
+
+#include <string>
+#include <defaults.h>
+#include <result.h>
+
+class ExecutionContext;
+class Expression;
+
+enum OptimizationLevel {
+	NO_OPTIMIZATION = 0, CONSTANT_FOLDING = 1
+};
+
+/**
+ * Set by -O0 and -O1. Constant folding is enabled unless -O0 is given.
+ */
+extern OptimizationLevel OPTIMIZATION_LEVEL;
+
+/**
+ * Set when --trace-optimization is given.
+ */
+extern bool TRACE_OPTIMIZATION;
+
+/**
+ * Simplifies the tree as it is preprocessed.
+ *
+ * Expressions whose operands are all constants are evaluated once, during
+ * preprocessing, and later evaluations return the stored result. Conditional
+ * statements whose condition is constant skip the test at run time, along
+ * with any branch that cannot be taken.
+ *
+ * Dead branches are still preprocessed, so the same semantic errors are
+ * reported at every optimization level. Likewise, a constant expression whose
+ * evaluation fails (e.g. a division by zero) is left alone, so that its error
+ * is reported at run time as usual.
+ */
+class Optimizer {
+public:
+	enum Condition {
+		DYNAMIC, ALWAYS_TRUE, ALWAYS_FALSE
+	};
+
+	/**
+	 * Evaluate a validated expression if it is constant. Returns nullptr if
+	 * the expression is not constant, if its evaluation produced errors, or if
+	 * optimization is disabled.
+	 */
+	static const_shared_ptr<Result> Fold(const Expression& expression,
+			const shared_ptr<ExecutionContext> context);
+
+	/**
+	 * Determine the outcome of a validated conditional expression, if it can
+	 * be known before execution.
+	 */
+	static const Condition GetCondition(const Expression& expression,
+			const shared_ptr<ExecutionContext> context);
+
+	/**
+	 * Report a simplification made at the given location, if tracing is
+	 * enabled.
+	 */
+	static void Trace(const yy::location location, const std::string& message);
+};
+
+#endif /* OPTIMIZER_H_ */
@@ -0,0 +1,141 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <parallel.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+size_t PARALLELISM = 0;
+
+class Parallel::Pool {
+public:
+	Pool(const size_t workers) :
+			m_generation(0) {
+		for (size_t i = 0; i < workers; i++) {
+			std::thread(&Pool::Work, this).detach();
+		}
+	}
+
+	void Run(const size_t count,
+			const std::function<void(const size_t)>& task) {
+		auto job = std::make_shared<Job>(task, count);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_job = job;
+			m_generation++;
+		}
+		m_wake.notify_all();
+
+		Help(*job);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [&job]() {
+			return job->pending.load() == 0;
+		});
+		m_job = nullptr;
+	}
+
+private:
+	struct Job {
+		Job(const std::function<void(const size_t)>& task, const size_t count) :
+				task(task), count(count), next(0), pending(count) {
+		}
+
+		const std::function<void(const size_t)>& task;
+		const size_t count;
+		std::atomic<size_t> next;
+		std::atomic<size_t> pending;
+	};
+
+	void Work() {
+		size_t generation = 0;
+		while (true) {
+			std::shared_ptr<Job> job;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [this, generation]() {
+					return m_generation != generation;
+				});
+				generation = m_generation;
+				job = m_job;
+			}
+
+			if (job) {
+				Help(*job);
+			}
+		}
+	}
+
+	/**
+	 * Claim and run tasks until none are left. A worker that wakes up late
+	 * finds every task of its job already claimed.
+	 */
+	void Help(Job& job) {
+		GetRegion() = true;
+		while (true) {
+			auto index = job.next.fetch_add(1);
+			if (index >= job.count) {
+				break;
+			}
+
+			job.task(index);
+			if (job.pending.fetch_sub(1) == 1) {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_done.notify_all();
+			}
+		}
+		GetRegion() = false;
+	}
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	size_t m_generation;
+	std::shared_ptr<Job> m_job;
+};
+
+const size_t Parallel::GetThreadCount() {
+	if (PARALLELISM > 0) {
+		return PARALLELISM;
+	}
+
+	auto hardware = std::thread::hardware_concurrency();
+	return hardware > 0 ? hardware : 1;
+}
+
+void Parallel::Run(const size_t count,
+		const std::function<void(const size_t)>& task) {
+	auto threads = GetThreadCount();
+	if (InRegion() || threads == 1 || count == 1) {
+		auto region = GetRegion();
+		GetRegion() = true;
+		for (size_t i = 0; i < count; i++) {
+			task(i);
+		}
+		GetRegion() = region;
+		return;
+	}
+
+	// never destroyed: idle workers wait on it until the program exits
+	static Pool* pool = new Pool(threads - 1);
+	pool->Run(count, task);
+}
@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * The number of threads that run parallel loops, including the thread that
+ * starts the loop. Set by --threads; if zero (the default), one thread per
+ * hardware thread is used.
+ */
+extern size_t PARALLELISM;
+
+/**
+ * Runs independent tasks on a shared pool of worker threads.
+ *
+ * Workers are started the first time they are needed and live until the
+ * program exits. The thread that submits the tasks works on them as well.
+ *
+ * Code running a task is said to be in a parallel region.
+ */
+class Parallel {
+public:
+	/**
+	 * True while the calling thread is running a task.
+	 */
+	static const bool InRegion() {
+		return GetRegion();
+	}
+
+	static const size_t GetThreadCount();
+
+	/**
+	 * Run task(0) through task(count - 1) and wait for all of them to finish.
+	 * Tasks are claimed one at a time, in order, by whichever thread is free.
+	 * A single task, or tasks started from within a parallel region, are run
+	 * on the calling thread.
+	 */
+	static void Run(const size_t count,
+			const std::function<void(const size_t)>& task);
+
+private:
+	class Pool;
+
+	static bool& GetRegion() {
+		static thread_local bool region = false;
+		return region;
+	}
+};
+
+#endif /* PARALLEL_H_ */
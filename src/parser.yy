@@ -149,6 +149,7 @@ void yy::newt_parser::error(const location_type& location, const std::string& me
 
 	IF                    "if"
 	FOR                   "for"
+	PARALLEL              "parallel"
 	ELSE                  "else"
 	DO                    "do"
 	WHILE                 "while"
@@ -527,7 +528,7 @@ statement:
 	| variable_reference LPAREN optional_argument_list RPAREN
 	{
 		const ArgumentListRef argument_list = ArgumentList::Reverse($3);
-		$$ = make_shared<InvokeStatement>($1, argument_list, @3);
+		$$ = make_shared<InvokeStatement>(@$, $1, argument_list, @3);
 	}
 
 //---------------------------------------------------------------------
@@ -545,81 +546,85 @@ conditional_block:
 if_statement:
 	IF LPAREN expression RPAREN conditional_block %prec IF_NO_ELSE
 	{
-		$$ = make_shared<IfStatement>($3, $5);
+		$$ = make_shared<IfStatement>(@$, $3, $5);
 	}
 	| IF LPAREN expression RPAREN conditional_block ELSE conditional_block
 	{
-		$$ = make_shared<IfStatement>($3, $5, $7);
+		$$ = make_shared<IfStatement>(@$, $3, $5, $7);
 	}
 
 //---------------------------------------------------------------------
 do_statement:
 	DO conditional_block WHILE LPAREN expression RPAREN
 	{
-		$$ = make_shared<WhileStatement>($5, $2, WhileStatement::WhileMode::DO_WHILE);
+		$$ = make_shared<WhileStatement>(@$, $5, $2, WhileStatement::WhileMode::DO_WHILE);
 	}
 
 //---------------------------------------------------------------------
 while_statement:
 	WHILE LPAREN expression RPAREN conditional_block
 	{
-		$$ = make_shared<WhileStatement>($3, $5, WhileStatement::WhileMode::WHILE);
+		$$ = make_shared<WhileStatement>(@$, $3, $5, WhileStatement::WhileMode::WHILE);
 	}
 
 //---------------------------------------------------------------------
 for_statement:
 	FOR LPAREN assign_statement SEMICOLON expression SEMICOLON assign_statement RPAREN statement_block
 	{
-		$$ = make_shared<ForStatement>($3, $5, $7, $9);
+		$$ = make_shared<ForStatement>(@$, $3, $5, $7, $9);
 	}
 	|
 	FOR LPAREN variable_declaration SEMICOLON expression SEMICOLON assign_statement RPAREN statement_block
 	{
-		$$ = make_shared<ForStatement>($3, $5, $7, $9);
+		$$ = make_shared<ForStatement>(@$, $3, $5, $7, $9);
 	}
 	| FOR IDENTIFIER IN expression statement_block
 	{
-		$$ = make_shared<ForeachStatement>($2, $4, $5);
+		$$ = make_shared<ForeachStatement>(@$, $2, $4, $5);
+	}
+	| PARALLEL FOR IDENTIFIER IN expression statement_block
+	{
+		$$ = make_shared<ForeachStatement>(@$, $3, $5, $6, true);
 	}
 
 //---------------------------------------------------------------------
 print_statement:
 	PRINT LPAREN expression RPAREN
 	{
-		$$ = make_shared<PrintStatement>($3);
+		$$ = make_shared<PrintStatement>(@$, $3);
 	}
 
 //---------------------------------------------------------------------
 exit_statement:
 	EXIT LPAREN expression RPAREN
 	{
-		$$ = make_shared<ExitStatement>($3);
+		$$ = make_shared<ExitStatement>(@$, $3);
 	}
 	| PRINT LPAREN RPAREN
 	{
-		$$ = make_shared<ExitStatement>();
+		$$ = make_shared<ExitStatement>(@$);
 	}
 
 //---------------------------------------------------------------------
 assign_statement:
 	variable_reference EQUALS expression
 	{
-		$$ = make_shared<const AssignmentStatement>($1, AssignmentType::ASSIGN, $3);
+		$$ = make_shared<const AssignmentStatement>(@$, $1, AssignmentType::ASSIGN, $3);
 	}
 	| variable_reference PLUS_ASSIGN expression
 	{
-		$$ = make_shared<const AssignmentStatement>($1, AssignmentType::PLUS_ASSIGN, $3);
+		$$ = make_shared<const AssignmentStatement>(@$, $1, AssignmentType::PLUS_ASSIGN, $3);
 	}
 	| variable_reference MINUS_ASSIGN expression
 	{
-		$$ = make_shared<const AssignmentStatement>($1, AssignmentType::MINUS_ASSIGN, $3);
+		$$ = make_shared<const AssignmentStatement>(@$, $1, AssignmentType::MINUS_ASSIGN, $3);
 	}
 
 //---------------------------------------------------------------------
 return_statement:
 	RETURN expression
 	{
-		$$ = make_shared<ReturnStatement>($2);
+		$$ = make_shared<ReturnStatement>(@$, $2);
 	}
 
 //---------------------------------------------------------------------
@@ -1121,6 +1126,18 @@ variant:
 	{
 		$$ = make_shared<TypeAliasDeclarationStatement>(@$, $3, @3, $1, @1);
 	}
+	| IDENTIFIER COLON type_specifier dimensions
+	{
+		plain_shared_ptr<TypeSpecifier> type_specifier = $3;
+		//add dimensions to type specifier
+		DimensionListRef dimension = $4;
+		while (!DimensionList::IsTerminator(dimension)) {
+			type_specifier = make_shared<ArrayTypeSpecifier>(type_specifier);
+			dimension = dimension->GetNext();
+		}
+
+		$$ = make_shared<TypeAliasDeclarationStatement>(@$, type_specifier, @3, $1, @1);
+	}
 	| IDENTIFIER
 	{
 		const_shared_ptr<ComplexTypeSpecifier> type = make_shared<ComplexTypeSpecifier>($1);
@@ -0,0 +1,292 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERSISTENT_VECTOR_H_
+#define PERSISTENT_VECTOR_H_
+
+#include <memory>
+#include <vector>
+#include <assert.h>
+
+using namespace std;
+
+/**
+ * An immutable vector with structural sharing.
+ *
+ * Elements are stored in a 32-way trie, with the last (partial) leaf held
+ * separately in a tail buffer so appends don't touch the trie until the tail
+ * fills. Updates copy only the path from the root to the modified leaf, so an
+ * indexed write is O(log32 n) rather than O(n).
+ *
+ * ref: http://hypirion.com/musings/understanding-persistent-vector-pt-1
+ */
+template<class T> class PersistentVector {
+public:
+	PersistentVector() :
+			m_size(0), m_shift(BITS), m_root(GetEmptyNode()), m_tail(
+					GetEmptyTail()) {
+	}
+
+	PersistentVector(const size_t count, const T& value) :
+			PersistentVector(PersistentVector().WithAppended(count, value)) {
+	}
+
+	const size_t GetSize() const {
+		return m_size;
+	}
+
+	const T& At(const size_t index) const {
+		assert(index < m_size);
+		if (index >= GetTailOffset()) {
+			return m_tail->at(index & MASK);
+		}
+
+		return GetLeaf(index)->values[index & MASK];
+	}
+
+	const PersistentVector<T> WithValue(const size_t index,
+			const T& value) const {
+		assert(index < m_size);
+		if (index >= GetTailOffset()) {
+			auto new_tail = make_shared<vector<T>>(*m_tail);
+			new_tail->at(index & MASK) = value;
+			return PersistentVector<T>(m_size, m_shift, m_root, new_tail);
+		}
+
+		return PersistentVector<T>(m_size, m_shift,
+				AssociatePath(m_shift, m_root, index, value), m_tail);
+	}
+
+	const PersistentVector<T> WithAppended(const T& value) const {
+		return WithAppended(1, value);
+	}
+
+	/**
+	 * Append count copies of value. Full leaves made up entirely of the appended
+	 * value are shared, so growing an array by a large default-filled region
+	 * costs one leaf allocation plus the trie paths that reference it.
+	 */
+	const PersistentVector<T> WithAppended(const size_t count,
+			const T& value) const {
+		if (count == 0) {
+			return *this;
+		}
+
+		size_t size = m_size;
+		size_t shift = m_shift;
+		node_ref root = m_root;
+		auto tail = make_shared<vector<T>>(*m_tail);
+		tail->reserve(WIDTH);
+
+		node_ref uniform_leaf = nullptr;
+		size_t remaining = count;
+		while (remaining > 0) {
+			if (tail->size() == WIDTH) {
+				// tail is full; push it into the trie
+				node_ref leaf;
+				bool uniform = true;
+				for (auto & element : *tail) {
+					if (element != value) {
+						uniform = false;
+						break;
+					}
+				}
+
+				if (uniform && uniform_leaf) {
+					leaf = uniform_leaf;
+				} else {
+					auto new_leaf = make_shared<Node>();
+					new_leaf->values.swap(*tail);
+					leaf = new_leaf;
+					if (uniform) {
+						uniform_leaf = leaf;
+					}
+				}
+
+				PushTail(size, shift, root, leaf);
+
+				tail = make_shared<vector<T>>();
+				tail->reserve(WIDTH);
+			}
+
+			size_t fill = WIDTH - tail->size();
+			if (fill > remaining) {
+				fill = remaining;
+			}
+			tail->insert(tail->end(), fill, value);
+			size += fill;
+			remaining -= fill;
+		}
+
+		return PersistentVector<T>(size, shift, root, tail);
+	}
+
+	/**
+	 * Append the elements in [first, last). Leaves are filled directly, so
+	 * building a large vector this way avoids the per-element copies of
+	 * repeated single appends.
+	 */
+	template<class InputIterator> const PersistentVector<T> WithAppended(
+			InputIterator first, const InputIterator last) const {
+		if (first == last) {
+			return *this;
+		}
+
+		size_t size = m_size;
+		size_t shift = m_shift;
+		node_ref root = m_root;
+		auto tail = make_shared<vector<T>>(*m_tail);
+		tail->reserve(WIDTH);
+
+		for (; first != last; ++first) {
+			if (tail->size() == WIDTH) {
+				auto leaf = make_shared<Node>();
+				leaf->values.swap(*tail);
+				PushTail(size, shift, root, leaf);
+
+				tail = make_shared<vector<T>>();
+				tail->reserve(WIDTH);
+			}
+
+			tail->push_back(*first);
+			size++;
+		}
+
+		return PersistentVector<T>(size, shift, root, tail);
+	}
+
+private:
+	static const size_t BITS = 5;
+	static const size_t WIDTH = 1 << BITS;
+	static const size_t MASK = WIDTH - 1;
+
+	struct Node {
+		vector<shared_ptr<const Node>> children;
+		vector<T> values;
+	};
+	typedef shared_ptr<const Node> node_ref;
+
+	PersistentVector(const size_t size, const size_t shift,
+			const node_ref root, const shared_ptr<const vector<T>> tail) :
+			m_size(size), m_shift(shift), m_root(root), m_tail(tail) {
+	}
+
+	const size_t GetTailOffset() const {
+		if (m_size < WIDTH) {
+			return 0;
+		}
+
+		return ((m_size - 1) >> BITS) << BITS;
+	}
+
+	const Node* GetLeaf(const size_t index) const {
+		const Node* node = m_root.get();
+		for (size_t level = m_shift; level > 0; level -= BITS) {
+			node = node->children[(index >> level) & MASK].get();
+		}
+		return node;
+	}
+
+	static const node_ref AssociatePath(const size_t level,
+			const node_ref node, const size_t index, const T& value) {
+		auto copy = make_shared<Node>(*node);
+		if (level == 0) {
+			copy->values[index & MASK] = value;
+		} else {
+			size_t child_index = (index >> level) & MASK;
+			copy->children[child_index] = AssociatePath(level - BITS,
+					node->children[child_index], index, value);
+		}
+		return copy;
+	}
+
+	/**
+	 * Push a full tail leaf into the trie, growing the root if it has no room
+	 * left. The size parameter is the element count _including_ the leaf.
+	 */
+	static void PushTail(const size_t size, size_t& shift, node_ref& root,
+			const node_ref leaf) {
+		if ((size >> BITS) > ((size_t) 1 << shift)) {
+			// root overflow
+			auto new_root = make_shared<Node>();
+			new_root->children.push_back(root);
+			new_root->children.push_back(NewPath(shift, leaf));
+			root = new_root;
+			shift += BITS;
+		} else {
+			root = PushLeaf(size, shift, root, leaf);
+		}
+	}
+
+	/**
+	 * Insert a full leaf at the end of the trie. The size parameter is the element
+	 * count _including_ the leaf being inserted.
+	 */
+	static const node_ref PushLeaf(const size_t size, const size_t level,
+			const node_ref parent, const node_ref leaf) {
+		auto copy = make_shared<Node>(*parent);
+		size_t child_index = ((size - 1) >> level) & MASK;
+
+		node_ref insert;
+		if (level == BITS) {
+			insert = leaf;
+		} else if (child_index < parent->children.size()) {
+			insert = PushLeaf(size, level - BITS,
+					parent->children[child_index], leaf);
+		} else {
+			insert = NewPath(level - BITS, leaf);
+		}
+
+		if (child_index < copy->children.size()) {
+			copy->children[child_index] = insert;
+		} else {
+			copy->children.push_back(insert);
+		}
+
+		return copy;
+	}
+
+	static const node_ref NewPath(const size_t level, const node_ref leaf) {
+		if (level == 0) {
+			return leaf;
+		}
+
+		auto node = make_shared<Node>();
+		node->children.push_back(NewPath(level - BITS, leaf));
+		return node;
+	}
+
+	static const node_ref GetEmptyNode() {
+		static const node_ref empty = make_shared<Node>();
+		return empty;
+	}
+
+	static const shared_ptr<const vector<T>> GetEmptyTail() {
+		static const shared_ptr<const vector<T>> empty = make_shared<
+				vector<T>>();
+		return empty;
+	}
+
+	size_t m_size;
+	size_t m_shift;
+	node_ref m_root;
+	shared_ptr<const vector<T>> m_tail;
+};
+
+#endif /* PERSISTENT_VECTOR_H_ */
@@ -0,0 +1,157 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <profiler.h>
+#include <algorithm>
+#include <iomanip>
+#include <statement.h>
+
+bool PROFILING = false;
+
+std::map<Profiler::Key, Profiler::Entry> Profiler::s_functions;
+std::map<Profiler::Key, Profiler::Entry> Profiler::s_statements;
+std::vector<Profiler::Activation> Profiler::s_stack;
+std::map<std::string, Profiler::clock::duration> Profiler::s_collapsed;
+Profiler::Entry Profiler::s_root;
+
+void Profiler::Start(const std::string& name) {
+	PROFILING = true;
+	s_root.name = name;
+	Push(s_root);
+}
+
+void Profiler::Stop(std::ostream& flat, std::ostream& collapsed) {
+	Pop();
+	PROFILING = false;
+
+	flat << "Total time: " << std::fixed << std::setprecision(3)
+			<< std::chrono::duration<double, std::milli>(s_root.total).count()
+			<< " ms" << std::endl << std::endl;
+	WriteEntries(flat, "Functions", s_functions, true);
+	flat << std::endl;
+	WriteEntries(flat, "Statements", s_statements, false);
+
+	for (auto & stack : s_collapsed) {
+		collapsed << stack.first << " "
+				<< std::chrono::duration_cast<std::chrono::microseconds>(
+						stack.second).count() << std::endl;
+	}
+}
+
+const ExecutionResult Profiler::Execute(const Statement& statement,
+		const shared_ptr<ExecutionContext> context,
+		const shared_ptr<ExecutionContext> closure) {
+	auto& entry = GetEntry(s_statements, statement.GetLocation(), "");
+	entry.count++;
+	entry.active++;
+
+	auto start = clock::now();
+	auto result = statement.Execute(context, closure);
+	auto elapsed = clock::now() - start;
+
+	// only the outermost activation of a recursive statement counts towards
+	// its total, so that time is not counted more than once
+	if (--entry.active == 0) {
+		entry.total += elapsed;
+	}
+
+	return result;
+}
+
+Profiler::Entry& Profiler::GetEntry(std::map<Key, Entry>& entries,
+		const yy::location location, const std::string& name) {
+	Key key = { location.begin.filename, location.begin.line,
+			location.begin.column };
+	auto result = entries.find(key);
+	if (result == entries.end()) {
+		Entry entry = { name, location, 0, 0, clock::duration::zero(),
+				clock::duration::zero() };
+		result = entries.insert(std::make_pair(key, entry)).first;
+	}
+
+	return result->second;
+}
+
+void Profiler::Push(Entry& entry) {
+	entry.count++;
+	entry.active++;
+	Activation activation = { &entry, clock::now(), clock::duration::zero() };
+	s_stack.push_back(activation);
+}
+
+void Profiler::Pop() {
+	auto activation = s_stack.back();
+	auto elapsed = clock::now() - activation.start;
+	auto self = elapsed - activation.children;
+
+	std::string stack;
+	for (auto & frame : s_stack) {
+		if (!stack.empty()) {
+			stack += ";";
+		}
+		stack += frame.entry->name;
+	}
+	s_collapsed[stack] += self;
+
+	s_stack.pop_back();
+	if (!s_stack.empty()) {
+		s_stack.back().children += elapsed;
+	}
+
+	auto& entry = *activation.entry;
+	entry.self += self;
+	if (--entry.active == 0) {
+		entry.total += elapsed;
+	}
+}
+
+void Profiler::WriteEntries(std::ostream& out, const std::string& heading,
+		const std::map<Key, Entry>& entries, const bool show_self) {
+	std::vector<const Entry*> sorted;
+	for (auto & entry : entries) {
+		sorted.push_back(&entry.second);
+	}
+	std::stable_sort(sorted.begin(), sorted.end(),
+			[](const Entry* a, const Entry* b) {
+				return a->total > b->total;
+			});
+
+	out << heading << ":" << std::endl;
+	out << std::setw(12) << "calls" << std::setw(14) << "total ms";
+	if (show_self) {
+		out << std::setw(14) << "self ms";
+	}
+	out << "  location" << std::endl;
+
+	for (auto entry : sorted) {
+		auto& begin = entry->location.begin;
+		out << std::setw(12) << entry->count << std::setw(14)
+				<< std::chrono::duration<double, std::milli>(entry->total).count();
+		if (show_self) {
+			out << std::setw(14)
+					<< std::chrono::duration<double, std::milli>(entry->self).count();
+		}
+		out << "  " << (begin.filename ? *begin.filename : "<builtin>") << ":"
+				<< begin.line << ":" << begin.column;
+		if (!entry->name.empty()) {
+			out << " " << entry->name;
+		}
+		out << std::endl;
+	}
+}
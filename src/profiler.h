@@ -0,0 +1,147 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <defaults.h>
+#include <result.h>
+
+class ExecutionContext;
+class Statement;
+
+/**
+ * Set when --profile is given. Instrumented call sites test this flag and
+ * take their ordinary path when it is clear, so profiling costs nothing unless
+ * it is enabled.
+ */
+extern bool PROFILING;
+
+/**
+ * An instrumenting profiler. Records the call count and wall time of each
+ * executed statement and invoked function, keyed by source location.
+ *
+ * Profiling is not thread-safe; it is intended for single-threaded runs.
+ */
+class Profiler {
+public:
+	typedef std::chrono::steady_clock clock;
+
+	/**
+	 * A function invocation. Times the invocation from construction to
+	 * destruction, and attributes any statements executed in between to it.
+	 * Does nothing if profiling is not enabled when it is constructed.
+	 */
+	class Frame {
+	public:
+		Frame(const yy::location& location, const std::string& name) :
+				m_active(PROFILING) {
+			if (m_active) {
+				Push(GetEntry(s_functions, location, name));
+			}
+		}
+
+		~Frame() {
+			if (m_active) {
+				Pop();
+			}
+		}
+
+	private:
+		Frame(const Frame&) = delete;
+		Frame& operator=(const Frame&) = delete;
+
+		const bool m_active;
+	};
+
+	/**
+	 * Begin profiling. The given name labels the outermost frame, to which
+	 * top-level statements are attributed.
+	 */
+	static void Start(const std::string& name);
+
+	/**
+	 * Stop profiling and write the results: a flat profile of functions and
+	 * statements, ordered by total time, and a collapsed-stack profile with one
+	 * line per distinct call stack and its self time in microseconds, as
+	 * consumed by flamegraph tools.
+	 */
+	static void Stop(std::ostream& flat, std::ostream& collapsed);
+
+	/**
+	 * Execute the given statement, recording its wall time.
+	 */
+	static const ExecutionResult Execute(const Statement& statement,
+			const shared_ptr<ExecutionContext> context,
+			const shared_ptr<ExecutionContext> closure);
+
+private:
+	struct Key {
+		const std::string* filename;
+		unsigned int line;
+		unsigned int column;
+
+		bool operator<(const Key& other) const {
+			if (filename != other.filename) {
+				return filename < other.filename;
+			}
+			if (line != other.line) {
+				return line < other.line;
+			}
+			return column < other.column;
+		}
+	};
+
+	struct Entry {
+		std::string name;
+		yy::location location;
+		size_t count;
+		size_t active;
+		clock::duration total;
+		clock::duration self;
+	};
+
+	struct Activation {
+		Entry* entry;
+		clock::time_point start;
+		clock::duration children;
+	};
+
+	static Entry& GetEntry(std::map<Key, Entry>& entries,
+			const yy::location location, const std::string& name);
+
+	static void Push(Entry& entry);
+	static void Pop();
+
+	static void WriteEntries(std::ostream& out, const std::string& heading,
+			const std::map<Key, Entry>& entries, const bool show_self);
+
+	static std::map<Key, Entry> s_functions;
+	static std::map<Key, Entry> s_statements;
+	static std::vector<Activation> s_stack;
+	static std::map<std::string, clock::duration> s_collapsed;
+	static Entry s_root;
+};
+
+#endif /* PROFILER_H_ */
@@ -0,0 +1,106 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <program.h>
+#include <execution_context.h>
+#include <statement_block.h>
+#include <return_statement.h>
+#include <primitive_type_specifier.h>
+
+Execution::Execution(const shared_ptr<ExecutionContext> context,
+		const ExecutionResult& result) :
+		m_context(context), m_result(result) {
+}
+
+const_shared_ptr<bool> Execution::GetBoolean(const string& name) const {
+	return static_pointer_cast<const bool>(
+			GetValue(name, PrimitiveTypeSpecifier::GetBoolean()));
+}
+
+const_shared_ptr<int> Execution::GetInt(const string& name) const {
+	return static_pointer_cast<const int>(
+			GetValue(name, PrimitiveTypeSpecifier::GetInt()));
+}
+
+const_shared_ptr<double> Execution::GetDouble(const string& name) const {
+	return static_pointer_cast<const double>(
+			GetValue(name, PrimitiveTypeSpecifier::GetDouble()));
+}
+
+const_shared_ptr<string> Execution::GetString(const string& name) const {
+	return static_pointer_cast<const string>(
+			GetValue(name, PrimitiveTypeSpecifier::GetString()));
+}
+
+const_shared_ptr<void> Execution::GetValue(const string& name,
+		const_shared_ptr<TypeSpecifier> type_specifier) const {
+	auto symbol = m_context->GetSymbol(name, SHALLOW);
+	if (symbol == Symbol::GetDefaultSymbol()
+			|| *symbol->GetTypeSpecifier() != *type_specifier) {
+		return nullptr;
+	}
+
+	return symbol->GetValue();
+}
+
+Program::Program(const_shared_ptr<StatementBlock> statement_block,
+		const_shared_ptr<file_name_map> file_names,
+		const shared_ptr<ExecutionContext> context,
+		const shared_ptr<ExecutionContext> builtin_context) :
+		m_statement_block(statement_block), m_file_names(file_names), m_context(
+				context), m_builtin_context(builtin_context) {
+}
+
+const_shared_ptr<Execution> Program::Execute() const {
+	return Execute(Bindings());
+}
+
+const_shared_ptr<Execution> Program::Execute(const Bindings& inputs) const {
+	auto context = ExecutionContext::GetRootInstance(m_context);
+	auto type_table = context->GetTypeTable();
+
+	auto errors = ErrorList::GetTerminator();
+	for (auto& input : inputs.GetValues()) {
+		auto name = make_shared<string>(input.first);
+		auto value = input.second;
+
+		// a deep search would find (and assign) builtins of the same name
+		auto symbol = context->GetSymbol(*name, SHALLOW);
+		if (symbol == Symbol::GetDefaultSymbol()) {
+			errors = ErrorList::From(
+					make_shared<Error>(Error::SEMANTIC,
+							Error::UNDECLARED_VARIABLE,
+							GetDefaultLocation().begin, *name), errors);
+			continue;
+		}
+
+		auto set_result = context->SetSymbol(*name, value, *type_table);
+		errors = ErrorList::Concatenate(errors,
+				ToErrorListRef(set_result, GetDefaultLocation(), name,
+						symbol->GetTypeSpecifier(),
+						value->GetTypeSpecifier()));
+	}
+
+	if (!ErrorList::IsTerminator(errors)) {
+		return make_shared<Execution>(context, ExecutionResult(errors));
+	}
+
+	return make_shared<Execution>(context,
+			ReturnStatement::Complete(m_statement_block->Execute(context)));
+}
@@ -0,0 +1,122 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROGRAM_H_
+#define PROGRAM_H_
+
+#include <string>
+#include <defaults.h>
+#include <result.h>
+#include <bindings.h>
+#include <driver.h>
+
+class ExecutionContext;
+class StatementBlock;
+
+/**
+ * The outcome of a single execution of a program: its errors and exit code,
+ * and the top-level variables as the program left them.
+ */
+class Execution {
+public:
+	Execution(const shared_ptr<ExecutionContext> context,
+			const ExecutionResult& result);
+
+	const ErrorListRef GetErrors() const {
+		return m_result.GetErrors();
+	}
+
+	/**
+	 * The status given to exit, or nullptr if the program did not exit.
+	 */
+	const_shared_ptr<int> GetExitCode() const {
+		return m_result.GetExitCode();
+	}
+
+	/**
+	 * Get the value of a top-level variable, or nullptr if there is no such
+	 * variable or it has a different type.
+	 */
+	const_shared_ptr<bool> GetBoolean(const string& name) const;
+	const_shared_ptr<int> GetInt(const string& name) const;
+	const_shared_ptr<double> GetDouble(const string& name) const;
+	const_shared_ptr<string> GetString(const string& name) const;
+
+	const shared_ptr<ExecutionContext> GetContext() const {
+		return m_context;
+	}
+
+private:
+	const_shared_ptr<void> GetValue(const string& name,
+			const_shared_ptr<TypeSpecifier> type_specifier) const;
+
+	const shared_ptr<ExecutionContext> m_context;
+	const ExecutionResult m_result;
+};
+
+/**
+ * A parsed and preprocessed script, ready to be executed any number of times.
+ *
+ * Each execution starts from a fresh copy of the program's top-level
+ * variables, so executions do not see each other's state and may run on
+ * different threads at once. Files opened by a script are the exception:
+ * open file handles are shared by every program in the process.
+ */
+class Program {
+	friend class Interpreter;
+public:
+	const_shared_ptr<Execution> Execute() const;
+
+	/**
+	 * Execute the program with the given input values. Every input must have
+	 * been declared when the program was compiled, with the same type.
+	 */
+	const_shared_ptr<Execution> Execute(const Bindings& inputs) const;
+
+	const_shared_ptr<StatementBlock> GetStatementBlock() const {
+		return m_statement_block;
+	}
+
+private:
+	Program(const_shared_ptr<StatementBlock> statement_block,
+			const_shared_ptr<file_name_map> file_names,
+			const shared_ptr<ExecutionContext> context,
+			const shared_ptr<ExecutionContext> builtin_context);
+
+	const_shared_ptr<StatementBlock> m_statement_block;
+
+	/**
+	 * The names of the files the syntax tree was parsed from, which its
+	 * locations refer to.
+	 */
+	const_shared_ptr<file_name_map> m_file_names;
+
+	/**
+	 * The top-level symbols and types laid out during preprocessing. Only
+	 * copied, never executed in.
+	 */
+	const shared_ptr<ExecutionContext> m_context;
+
+	/**
+	 * The parent of m_context, which only holds a weak reference to it.
+	 */
+	const shared_ptr<ExecutionContext> m_builtin_context;
+};
+
+#endif /* PROGRAM_H_ */
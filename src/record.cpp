@@ -24,11 +24,9 @@
 #include <record_type.h>
 
 const_shared_ptr<Record> Record::GetDefaultInstance(const RecordType& type) {
-	auto symbol_mapping = make_shared<symbol_map>();
-
 	auto type_definition = type.GetDefinition();
 	auto default_symbols = type_definition->GetDefaultSymbolContext(
-			type.GetModifiers(), nullptr);
+			type.GetModifiers(), nullptr, type.GetLayout());
 
 	return make_shared<Record>(default_symbols);
 }
@@ -22,23 +22,38 @@
 
 #include <error.h>
 #include <symbol.h>
+#include <value.h>
+
+struct Invocation;
 
 class Result {
 public:
 	Result(const_shared_ptr<void> data, const ErrorListRef errors) :
 			m_data(data), m_errors(errors) {
-		assert(m_data || m_errors);
+		assert(!m_data.IsEmpty() || m_errors);
+	}
+
+	Result(const Value& data, const ErrorListRef errors) :
+			m_data(data), m_errors(errors) {
+		assert(!m_data.IsEmpty() || m_errors);
 	}
 
 	template<class T> const shared_ptr<const T> GetData() const {
-		if (m_data && ErrorList::IsTerminator(m_errors)) {
-			auto cast = static_pointer_cast<const T>(m_data);
+		if (!m_data.IsEmpty() && ErrorList::IsTerminator(m_errors)) {
+			auto cast = static_pointer_cast<const T>(m_data.ToPointer());
 			return cast;
 		}
 
 		return shared_ptr<const T>();
 	}
 
+	/**
+	 * Get the result value without boxing it.
+	 */
+	const Value& GetTaggedValue() const {
+		return m_data;
+	}
+
 	const ErrorListRef GetErrors() const {
 		return m_errors;
 	}
@@ -49,11 +64,11 @@ public:
 	 * This should be used judiciously; the templated GetData member is almost always a better option.
 	 */
 	const_shared_ptr<void> GetRawData() const {
-		return m_data;
+		return m_data.ToPointer();
 	}
 
 private:
-	const_shared_ptr<void> m_data;
+	const Value m_data;
 	const ErrorListRef m_errors;
 };
 
@@ -127,6 +142,15 @@ public:
 					errors) {
 	}
 
+	/**
+	 * A return whose value is that of the given call. The call is made by the
+	 * function being returned from, in place of the current invocation.
+	 */
+	ExecutionResult(const_shared_ptr<Invocation> tail_call) :
+			ExecutionResult(Symbol::GetDefaultSymbol(), GetDefaultExitCode(),
+					ErrorList::GetTerminator(), tail_call) {
+	}
+
 	virtual ~ExecutionResult() {
 	}
 
@@ -134,7 +158,7 @@ public:
 		return m_return_value
 				!= Symbol::GetDefaultSymbol()
 				|| m_exit_code
-						!= ExecutionResult::GetDefaultExitCode();
+						!= ExecutionResult::GetDefaultExitCode() || m_tail_call;
 	}
 
 	const ErrorListRef GetErrors() const {
@@ -149,21 +173,27 @@ public:
 		return m_return_value;
 	}
 
+	const_shared_ptr<Invocation> GetTailCall() const {
+		return m_tail_call;
+	}
+
 	static plain_shared_ptr<int> GetDefaultExitCode() {
 		return nullptr;
 	}
 
 private:
 	ExecutionResult(const_shared_ptr<Symbol> return_value,
-			const_shared_ptr<int> exit_code, const ErrorListRef errors) :
+			const_shared_ptr<int> exit_code, const ErrorListRef errors,
+			const_shared_ptr<Invocation> tail_call = nullptr) :
 			m_return_value(return_value), m_exit_code(exit_code), m_errors(
-					errors) {
+					errors), m_tail_call(tail_call) {
 
 	}
 
 	const_shared_ptr<Symbol> m_return_value;
 	const_shared_ptr<int> m_exit_code;
 	const ErrorListRef m_errors;
+	const_shared_ptr<Invocation> m_tail_call;
 };
 
 #endif /* RESULT_H_ */
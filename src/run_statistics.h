@@ -0,0 +1,49 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RUN_STATISTICS_H_
+#define RUN_STATISTICS_H_
+
+#include <cstddef>
+#include <ostream>
+
+/**
+ * Resource usage of the current run, reported by --stats so that benchmark
+ * runs can be compared between builds.
+ */
+class RunStatistics {
+public:
+	/**
+	 * The number of allocations made through operator new so far.
+	 */
+	static const size_t GetAllocationCount();
+
+	/**
+	 * The peak resident set size of the process in kilobytes, or zero where
+	 * this is not available.
+	 */
+	static const long GetPeakResidentSetSize();
+
+	/**
+	 * Write the statistics as a single line of space-separated key=value pairs.
+	 */
+	static void Write(std::ostream& out, const double wall_time_ms);
+};
+
+#endif /* RUN_STATISTICS_H_ */
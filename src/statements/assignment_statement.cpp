@@ -33,9 +33,10 @@
 #include <specifiers/type_specifier.h>
 #include <unit_type.h>
 
-AssignmentStatement::AssignmentStatement(const_shared_ptr<Variable> variable,
-		const AssignmentType op_type, const_shared_ptr<Expression> expression) :
-		m_variable(variable), m_op_type(op_type), m_expression(expression) {
+AssignmentStatement::AssignmentStatement(const yy::location location,
+		const_shared_ptr<Variable> variable, const AssignmentType op_type,
+		const_shared_ptr<Expression> expression) :
+		Statement(location), m_variable(variable), m_op_type(op_type), m_expression(expression) {
 }
 
 AssignmentStatement::~AssignmentStatement() {
@@ -66,7 +67,7 @@ const PreprocessResult AssignmentStatement::Preprocess(
 						dynamic_pointer_cast<const BasicVariable>(m_variable);
 				if (basic_variable) {
 					if (!expression_type_specifier->AnalyzeAssignmentTo(
-							symbol_type_specifier, context->GetTypeTable())) {
+							symbol_type_specifier, *context->GetTypeTable())) {
 						yy::location expression_position =
 								m_expression->GetLocation();
 						errors = ErrorList::From(
@@ -88,7 +89,7 @@ const PreprocessResult AssignmentStatement::Preprocess(
 						const_shared_ptr<TypeSpecifier> element_type =
 								array_variable->GetElementType(context);
 						if (!expression_type_specifier->AnalyzeAssignmentTo(
-								element_type, context->GetTypeTable())) {
+								element_type, *context->GetTypeTable())) {
 							yy::location expression_position =
 									m_expression->GetLocation();
 							errors =
@@ -158,7 +159,7 @@ const PreprocessResult AssignmentStatement::Preprocess(
 														expression_type_specifier_result.GetData();
 												if (!expression_type_specifier->AnalyzeAssignmentTo(
 														member_variable_type_specifier,
-														context->GetTypeTable())) {
+														*context->GetTypeTable())) {
 													errors =
 															ErrorList::From(
 																	make_shared<
@@ -419,20 +420,20 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 			switch (basic_type) {
 			case BOOLEAN: {
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<bool>()), op, execution_context,
-						new_value);
+						evaluation->GetTaggedValue().As<bool>(), op,
+						execution_context, new_value);
 				break;
 			}
 			case BYTE: {
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<std::uint8_t>()), op,
+						evaluation->GetTaggedValue().As<std::uint8_t>(), op,
 						execution_context, new_value);
 				break;
 			}
 			case INT: {
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<int>()), op, execution_context,
-						new_value);
+						evaluation->GetTaggedValue().As<int>(), op,
+						execution_context, new_value);
 				break;
 			}
 			default:
@@ -451,8 +452,7 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 		}
 	}
 
-	const_shared_ptr<int> wrapper = make_shared<int>(new_value);
-	return make_shared<Result>(wrapper, errors);
+	return make_shared<Result>(Value(new_value), errors);
 }
 
 const_shared_ptr<Result> AssignmentStatement::do_op(
@@ -485,25 +485,25 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 			switch (basic_type) {
 			case BOOLEAN:
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<bool>()), op, execution_context,
-						new_value);
+						evaluation->GetTaggedValue().As<bool>(), op,
+						execution_context, new_value);
 				break;
 			case BYTE: {
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<std::uint8_t>()), op,
+						evaluation->GetTaggedValue().As<std::uint8_t>(), op,
 						execution_context, new_value);
 				break;
 			}
 			case INT: {
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<int>()), op, execution_context,
-						new_value);
+						evaluation->GetTaggedValue().As<int>(), op,
+						execution_context, new_value);
 				break;
 			}
 			case DOUBLE: {
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<double>()), op, execution_context,
-						new_value);
+						evaluation->GetTaggedValue().As<double>(), op,
+						execution_context, new_value);
 				break;
 			}
 			default:
@@ -522,8 +522,7 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 		}
 	}
 
-	const_shared_ptr<void> wrapper = make_shared<double>(new_value);
-	return make_shared<Result>(wrapper, errors);
+	return make_shared<Result>(Value(new_value), errors);
 }
 
 const_shared_ptr<Result> AssignmentStatement::do_op(
@@ -556,25 +555,25 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 			switch (basic_type) {
 			case BOOLEAN:
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<bool>()), op, execution_context,
-						new_value);
+						evaluation->GetTaggedValue().As<bool>(), op,
+						execution_context, new_value);
 				break;
 			case BYTE: {
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<std::uint8_t>()), op,
+						evaluation->GetTaggedValue().As<std::uint8_t>(), op,
 						execution_context, new_value);
 				break;
 			}
 			case INT: {
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<int>()), op, execution_context,
-						new_value);
+						evaluation->GetTaggedValue().As<int>(), op,
+						execution_context, new_value);
 				break;
 			}
 			case DOUBLE: {
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<double>()), op, execution_context,
-						new_value);
+						evaluation->GetTaggedValue().As<double>(), op,
+						execution_context, new_value);
 				break;
 			}
 			case STRING: {
@@ -633,12 +632,12 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 			switch (basic_type) {
 			case BOOLEAN:
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<bool>()), op, execution_context,
-						new_value);
+						evaluation->GetTaggedValue().As<bool>(), op,
+						execution_context, new_value);
 				break;
 			case BYTE:
 				errors = do_op(variable_name, variable_type, position, value,
-						*(evaluation->GetData<std::uint8_t>()), op,
+						evaluation->GetTaggedValue().As<std::uint8_t>(), op,
 						execution_context, new_value);
 				break;
 			default:
@@ -657,8 +656,7 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 		}
 	}
 
-	auto wrapper = make_shared<std::uint8_t>(new_value);
-	return make_shared<Result>(wrapper, errors);
+	return make_shared<Result>(Value(new_value), errors);
 }
 
 const ExecutionResult AssignmentStatement::Execute(
@@ -35,7 +35,8 @@ class Result;
 
 class AssignmentStatement: public Statement {
 public:
-	AssignmentStatement(const_shared_ptr<Variable> variable,
+	AssignmentStatement(const yy::location location,
+			const_shared_ptr<Variable> variable,
 			const AssignmentType op_type,
 			const_shared_ptr<Expression> expression);
 	virtual ~AssignmentStatement();
@@ -137,7 +137,7 @@ const ExecutionResult ArrayDeclarationStatement::Execute(
 			auto array = initializer_result->GetData<Array>();
 			auto symbol_context = context;
 			SetResult result = symbol_context->SetSymbol(*GetName(), array,
-					context->GetTypeTable());
+					*context->GetTypeTable());
 			errors =
 					ToErrorListRef(result,
 							GetInitializerExpression()->GetLocation(),
@@ -52,7 +52,7 @@ const PreprocessResult ComplexInstantiationStatement::Preprocess(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure,
 		const_shared_ptr<TypeSpecifier> return_type_specifier) const {
-	auto type_result = m_type_specifier->GetType(context->GetTypeTable());
+	auto type_result = m_type_specifier->GetType(*context->GetTypeTable());
 
 	auto errors = type_result->GetErrors();
 	if (ErrorList::IsTerminator(errors)) {
@@ -106,7 +106,7 @@ const_shared_ptr<TypeSpecifier> ComplexInstantiationStatement::GetTypeSpecifier(
 const ExecutionResult ComplexInstantiationStatement::Execute(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure) const {
-	auto type_result = m_type_specifier->GetType(context->GetTypeTable(),
+	auto type_result = m_type_specifier->GetType(*context->GetTypeTable(),
 			RESOLVE);
 
 	auto errors = type_result->GetErrors();
@@ -24,7 +24,7 @@ DeclarationStatement::DeclarationStatement(const yy::location location,
 		const_shared_ptr<Expression> initializer_expression,
 		ModifierListRef modifier_list,
 		const yy::location modifier_list_location) :
-		m_location(location), m_name(name), m_name_location(name_location), m_initializer_expression(
+		Statement(location), m_name(name), m_name_location(name_location), m_initializer_expression(
 				initializer_expression), m_modifier_list(modifier_list), m_modifier_list_location(
 				modifier_list_location) {
 }
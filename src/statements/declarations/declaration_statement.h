@@ -41,10 +41,6 @@ public:
 	virtual const DeclarationStatement* WithInitializerExpression(
 			const_shared_ptr<Expression> expression) const = 0;
 
-	const yy::location GetLocation() const {
-		return m_location;
-	}
-
 	const_shared_ptr<string> GetName() const {
 		return m_name;
 	}
@@ -70,7 +66,6 @@ public:
 	}
 
 private:
-	const yy::location m_location;
 	const_shared_ptr<string> m_name;
 	const yy::location m_name_location;
 	const_shared_ptr<Expression> m_initializer_expression;
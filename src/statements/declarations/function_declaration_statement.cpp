@@ -90,7 +90,7 @@ const PreprocessResult FunctionDeclarationStatement::Preprocess(
 
 				while (!TypeSpecifierList::IsTerminator(subject)) {
 					auto data = subject->GetData();
-					auto parameter_type_result = data->GetType(type_table);
+					auto parameter_type_result = data->GetType(*type_table);
 
 					auto parameter_errors = parameter_type_result->GetErrors();
 					if (!ErrorList::IsTerminator(parameter_errors)) {
@@ -114,7 +114,7 @@ const PreprocessResult FunctionDeclarationStatement::Preprocess(
 							variant->GetDeclaration()->GetParameterList());
 					while (!TypeSpecifierList::IsTerminator(subject)) {
 						auto data = subject->GetData();
-						auto parameter_type_result = data->GetType(type_table);
+						auto parameter_type_result = data->GetType(*type_table);
 
 						auto parameter_errors =
 								parameter_type_result->GetErrors();
@@ -168,7 +168,7 @@ const PreprocessResult FunctionDeclarationStatement::Preprocess(
 							if (ErrorList::IsTerminator(errors)) {
 								auto assignment_analysis =
 										expression_type_specifier->AnalyzeAssignmentTo(
-												m_type_specifier, type_table);
+												m_type_specifier, *type_table);
 								if (assignment_analysis == EQUIVALENT) {
 									// passed validation; insert into output context
 									InsertResult insert_result =
@@ -76,7 +76,7 @@ const PreprocessResult InferredDeclarationStatement::Preprocess(
 		assert(expression_type_specifier != PrimitiveTypeSpecifier::GetNone());
 
 		auto type_table = context->GetTypeTable();
-		auto type_result = expression_type_specifier->GetType(type_table);
+		auto type_result = expression_type_specifier->GetType(*type_table);
 		errors = ErrorList::Concatenate(errors, type_result->GetErrors());
 		if (ErrorList::IsTerminator(errors)) {
 			auto type = type_result->GetData<TypeDefinition>();
@@ -106,7 +106,7 @@ const ExecutionResult InferredDeclarationStatement::Execute(
 		auto expression_type_specifier =
 				expression_type_specifier_result.GetData();
 		auto type_table = context->GetTypeTable();
-		auto type_result = expression_type_specifier->GetType(type_table);
+		auto type_result = expression_type_specifier->GetType(*type_table);
 
 		auto type_errors = type_result->GetErrors();
 		if (ErrorList::IsTerminator(type_errors)) {
@@ -50,11 +50,11 @@ const PreprocessResult MaybeDeclarationStatement::Preprocess(
 
 	auto type_table = context->GetTypeTable();
 	auto root_specifier = m_type_specifier->GetBaseTypeSpecifier();
-	auto root_type_result = root_specifier->GetType(type_table);
+	auto root_type_result = root_specifier->GetType(*type_table);
 	errors = root_type_result->GetErrors();
 	if (ErrorList::IsTerminator(errors)) {
 		plain_shared_ptr<Sum> value = make_shared<Sum>(TypeTable::GetNilName(),
-				TypeTable::GetNilType()->GetValue());
+				TypeTable::GetNilTagId(), TypeTable::GetNilType()->GetValue());
 		auto initializer = GetInitializerExpression();
 		if (initializer) {
 			auto initializer_type_specifier_result =
@@ -85,17 +85,18 @@ const PreprocessResult MaybeDeclarationStatement::Preprocess(
 										value =
 												make_shared<Sum>(
 														MaybeTypeSpecifier::VARIANT_NAME,
+														MaybeTypeSpecifier::VARIANT_TAG_ID,
 														result->GetRawData());
 
 										auto type = m_type_specifier->GetType(
-												type_table, RESOLVE)->GetData<
+												*type_table, RESOLVE)->GetData<
 												SumType>();
 									}
 								}
 							} else {
 								value = static_pointer_cast<const Sum>(
 										m_type_specifier->DefaultValue(
-												type_table));
+												*type_table));
 							}
 						}
 					}
@@ -170,6 +171,7 @@ const ExecutionResult MaybeDeclarationStatement::Execute(
 								//widening conversion
 								value = make_shared<Sum>(
 										MaybeTypeSpecifier::VARIANT_NAME,
+										MaybeTypeSpecifier::VARIANT_TAG_ID,
 										result->GetRawData());
 							}
 						}
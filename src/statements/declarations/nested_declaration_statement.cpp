@@ -51,13 +51,13 @@ const PreprocessResult NestedDeclarationStatement::Preprocess(
 	auto existing = context->GetSymbol(GetName(), SHALLOW);
 	if (existing == nullptr || existing == Symbol::GetDefaultSymbol()) {
 		auto type_table = context->GetTypeTable();
-		auto type_result = m_type_specifier->GetType(type_table);
+		auto type_result = m_type_specifier->GetType(*type_table);
 
 		errors = type_result->GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
 			auto type = type_result->GetData<TypeDefinition>();
-			shared_ptr<const Symbol> symbol = type->GetSymbol(type_table,
-					m_type_specifier, type->GetDefaultValue(type_table));
+			shared_ptr<const Symbol> symbol = type->GetSymbol(*type_table,
+					m_type_specifier, type->GetDefaultValue(*type_table));
 			auto initializer_expression = GetInitializerExpression();
 			if (initializer_expression) {
 				errors = initializer_expression->Validate(context);
@@ -68,7 +68,7 @@ const PreprocessResult NestedDeclarationStatement::Preprocess(
 
 					errors = result->GetErrors();
 					if (ErrorList::IsTerminator(errors)) {
-						symbol = type->GetSymbol(type_table, m_type_specifier,
+						symbol = type->GetSymbol(*type_table, m_type_specifier,
 								result->GetData<void>());
 					}
 				}
@@ -80,7 +80,7 @@ const PreprocessResult PrimitiveDeclarationStatement::Preprocess(
 						expression_type_specifier);
 				if (expression_as_primitive == nullptr
 						|| !expression_as_primitive->AnalyzeAssignmentTo(
-								m_type_specifier, type_table)) {
+								m_type_specifier, *type_table)) {
 					//the type specifier isn't primitive
 					//-or-
 					//we cannot assign a value of the expression type to the variable type
@@ -98,13 +98,13 @@ const PreprocessResult PrimitiveDeclarationStatement::Preprocess(
 			//we purposefully ignore type specifier result errors here, as the initializer expression was validated at the top of the function
 		}
 
-		auto type_result = m_type_specifier->GetType(type_table);
+		auto type_result = m_type_specifier->GetType(*type_table);
 
 		auto type_errors = type_result->GetErrors();
 		if (ErrorList::IsTerminator(type_errors)) {
 			auto type = type_result->GetData<TypeDefinition>();
-			auto value = type->GetDefaultValue(type_table);
-			symbol = type->GetSymbol(type_table, m_type_specifier, value);
+			auto value = type->GetDefaultValue(*type_table);
+			symbol = type->GetSymbol(*type_table, m_type_specifier, value);
 		} else {
 			errors = ErrorList::Concatenate(errors, type_errors);
 		}
@@ -66,8 +66,9 @@ const PreprocessResult SumDeclarationStatement::Preprocess(
 	auto type_table = context->GetTypeTable();
 
 	if (!type_table->ContainsType(*m_type)) {
-		const_shared_ptr<Sum> default_value = make_shared<Sum>(
-				make_shared<string>("placeholder tag"), make_shared<int>(0));
+		auto placeholder_tag = make_shared<string>("placeholder tag");
+		const_shared_ptr<Sum> default_value = make_shared<Sum>(placeholder_tag,
+				Sum::InternTag(*placeholder_tag), make_shared<int>(0));
 		auto placeholder_symbol = make_shared<Symbol>(m_type, default_value);
 		auto placeholder_maybe_result = MaybeType::Build(closure,
 				GetTypeSpecifier());
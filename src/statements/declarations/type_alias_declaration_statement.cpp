@@ -97,7 +97,7 @@ TypedResult<Symbol> TypeAliasDeclarationStatement::GetTypeConstructor(
 					GetDefaultLocation()));
 
 	const_shared_ptr<ReturnStatement> return_statement = make_shared<
-			ReturnStatement>(return_expression);
+			ReturnStatement>(GetDefaultLocation(), return_expression);
 
 	const StatementListRef statement_list = StatementList::From(
 			return_statement, StatementList::GetTerminator());
@@ -23,12 +23,13 @@
 #include <error.h>
 #include <execution_context.h>
 
-ExitStatement::ExitStatement() :
-		m_exit_expression(nullptr) {
+ExitStatement::ExitStatement(const yy::location location) :
+		Statement(location), m_exit_expression(nullptr) {
 }
 
-ExitStatement::ExitStatement(const_shared_ptr<Expression> exit_expression) :
-		m_exit_expression(exit_expression) {
+ExitStatement::ExitStatement(const yy::location location,
+		const_shared_ptr<Expression> exit_expression) :
+		Statement(location), m_exit_expression(exit_expression) {
 }
 
 ExitStatement::~ExitStatement() {
@@ -56,7 +57,7 @@ const PreprocessResult ExitStatement::Preprocess(
 			if (expression_as_primitive == nullptr
 					|| !(expression_as_primitive->AnalyzeAssignmentTo(
 							PrimitiveTypeSpecifier::GetInt(),
-							context->GetTypeTable()))) {
+							*context->GetTypeTable()))) {
 				yy::location position = m_exit_expression->GetLocation();
 				errors = ErrorList::From(
 						make_shared<Error>(Error::SEMANTIC,
@@ -27,8 +27,9 @@ class Error;
 
 class ExitStatement: public Statement {
 public:
-	ExitStatement();
-	ExitStatement(const_shared_ptr<Expression> exit_expression);
+	ExitStatement(const yy::location location);
+	ExitStatement(const yy::location location,
+			const_shared_ptr<Expression> exit_expression);
 	virtual ~ExitStatement();
 
 	virtual const PreprocessResult Preprocess(
@@ -28,20 +28,24 @@
 #include <symbol_table.h>
 #include <execution_context.h>
 #include <specifiers/type_specifier.h>
+#include <bytecode_compiler.h>
+#include <virtual_machine.h>
 
-ForStatement::ForStatement(const_shared_ptr<AssignmentStatement> initial,
+ForStatement::ForStatement(const yy::location location,
+		const_shared_ptr<AssignmentStatement> initial,
 		const_shared_ptr<Expression> loop_expression,
 		const_shared_ptr<AssignmentStatement> loop_assignment,
 		const_shared_ptr<StatementBlock> statement_block) :
-		ForStatement(static_pointer_cast<const Statement>(initial),
+		ForStatement(location, static_pointer_cast<const Statement>(initial),
 				loop_expression, loop_assignment, statement_block) {
 }
 
-ForStatement::ForStatement(const_shared_ptr<DeclarationStatement> initial,
+ForStatement::ForStatement(const yy::location location,
+		const_shared_ptr<DeclarationStatement> initial,
 		const_shared_ptr<Expression> loop_expression,
 		const_shared_ptr<AssignmentStatement> loop_assignment,
 		const_shared_ptr<StatementBlock> statement_block) :
-		ForStatement(static_pointer_cast<const Statement>(initial),
+		ForStatement(location, static_pointer_cast<const Statement>(initial),
 				loop_expression, loop_assignment, statement_block) {
 }
 
@@ -79,7 +83,7 @@ const PreprocessResult ForStatement::Preprocess(
 			auto loop_expression_analysis =
 					loop_expression_type_specifier->AnalyzeAssignmentTo(
 							PrimitiveTypeSpecifier::GetInt(),
-							context->GetTypeTable());
+							*context->GetTypeTable());
 			if (loop_expression_analysis == EQUIVALENT
 					|| loop_expression_analysis == UNAMBIGUOUS) {
 				// use block context for closure so internal function closures are correct
@@ -106,6 +110,17 @@ const PreprocessResult ForStatement::Preprocess(
 const ExecutionResult ForStatement::Execute(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure) const {
+	if (EXECUTION_ENGINE == VIRTUAL_MACHINE) {
+		call_once(m_compiled, [this, &context]() {
+			m_bytecode = BytecodeCompiler::Compile(*this, context);
+		});
+
+		if (m_bytecode
+				&& VirtualMachine::CanExecute(*m_bytecode, context)) {
+			return VirtualMachine::Execute(*m_bytecode, context);
+		}
+	}
+
 	auto execution_context = ExecutionContext::GetRuntimeInstance(
 			m_block_context, context);
 
@@ -122,7 +137,7 @@ const ExecutionResult ForStatement::Execute(
 	auto evaluation = m_loop_expression->Evaluate(execution_context, closure);
 	errors = evaluation->GetErrors();
 	if (ErrorList::IsTerminator(errors)) {
-		while (*(evaluation->GetData<bool>())) {
+		while (evaluation->GetTaggedValue().As<bool>()) {
 			if (m_statement_block) {
 				// use execution context as closure so internal functions close over the correct context
 				auto iteration_result = m_statement_block->Execute(
@@ -157,13 +172,16 @@ const ExecutionResult ForStatement::Execute(
 	return ExecutionResult(errors);
 }
 
-ForStatement::ForStatement(const_shared_ptr<Statement> initial,
+ForStatement::ForStatement(const yy::location location,
+		const_shared_ptr<Statement> initial,
 		const_shared_ptr<Expression> loop_expression,
 		const_shared_ptr<AssignmentStatement> loop_assignment,
 		const_shared_ptr<StatementBlock> statement_block) :
-		m_initial(initial), m_loop_expression(loop_expression), m_loop_assignment(
-				loop_assignment), m_statement_block(statement_block), m_block_context(
-				make_shared<ExecutionContext>(Modifier::Type::MUTABLE)) {
+		Statement(location), m_initial(initial), m_loop_expression(
+				loop_expression), m_loop_assignment(loop_assignment), m_statement_block(
+				statement_block), m_block_context(
+				make_shared<ExecutionContext>(Modifier::Type::MUTABLE)), m_bytecode(
+				nullptr) {
 	assert(loop_expression);
 	assert(loop_assignment);
 }
@@ -20,9 +20,11 @@
 #ifndef FOR_STATEMENT_H_
 #define FOR_STATEMENT_H_
 
+#include <mutex>
 #include "statement.h"
 
 class AssignmentStatement;
+class Bytecode;
 class DeclarationStatement;
 class Expression;
 class StatementBlock;
@@ -31,11 +33,13 @@ class TypeSpecifier;
 
 class ForStatement: public Statement {
 public:
-	ForStatement(const_shared_ptr<AssignmentStatement> initial,
+	ForStatement(const yy::location location,
+			const_shared_ptr<AssignmentStatement> initial,
 			const_shared_ptr<Expression> loop_expression,
 			const_shared_ptr<AssignmentStatement> loop_assignment,
 			const_shared_ptr<StatementBlock> statement_block);
-	ForStatement(const_shared_ptr<DeclarationStatement> initial,
+	ForStatement(const yy::location location,
+			const_shared_ptr<DeclarationStatement> initial,
 			const_shared_ptr<Expression> loop_expression,
 			const_shared_ptr<AssignmentStatement> loop_assignment,
 			const_shared_ptr<StatementBlock> statement_block);
@@ -50,8 +54,25 @@ public:
 			const shared_ptr<ExecutionContext> context,
 			const shared_ptr<ExecutionContext> closure) const;
 
+	const_shared_ptr<Statement> GetInitial() const {
+		return m_initial;
+	}
+
+	const_shared_ptr<Expression> GetLoopExpression() const {
+		return m_loop_expression;
+	}
+
+	const_shared_ptr<AssignmentStatement> GetLoopAssignment() const {
+		return m_loop_assignment;
+	}
+
+	const_shared_ptr<StatementBlock> GetStatementBlock() const {
+		return m_statement_block;
+	}
+
 private:
-	ForStatement(const_shared_ptr<Statement> initial,
+	ForStatement(const yy::location location,
+			const_shared_ptr<Statement> initial,
 			const_shared_ptr<Expression> loop_expression,
 			const_shared_ptr<AssignmentStatement> loop_assignment,
 			const_shared_ptr<StatementBlock> statement_block);
@@ -61,6 +82,9 @@ private:
 	const_shared_ptr<AssignmentStatement> m_loop_assignment;
 	const_shared_ptr<StatementBlock> m_statement_block;
 	shared_ptr<ExecutionContext> m_block_context;
+	// compiled on first execution when the virtual machine engine is selected; null if compilation failed
+	mutable shared_ptr<const Bytecode> m_bytecode;
+	mutable once_flag m_compiled;
 };
 
 #endif /* FOR_STATEMENT_H_ */
@@ -30,6 +30,12 @@
 #include <basic_variable.h>
 #include <variable_expression.h>
 #include <unit_type.h>
+#include <utils.h>
+#include <primitive_type_specifier.h>
+#include <function_type_specifier.h>
+#include <profiler.h>
+#include <parallel.h>
+#include <value.h>
 
 const_shared_ptr<std::string> ForeachStatement::DATA_NAME = make_shared<
 		std::string>("data");
@@ -37,13 +43,15 @@ const_shared_ptr<std::string> ForeachStatement::DATA_NAME = make_shared<
 const_shared_ptr<std::string> ForeachStatement::NEXT_NAME = make_shared<
 		std::string>("next");
 
-ForeachStatement::ForeachStatement(
+ForeachStatement::ForeachStatement(const yy::location location,
 		const_shared_ptr<string> evaluation_identifier,
 		const_shared_ptr<Expression> expression,
-		const_shared_ptr<StatementBlock> statement_block) :
-		m_evaluation_identifier(evaluation_identifier), m_expression(
-				expression), m_statement_block(statement_block), m_block_context(
-				make_shared<ExecutionContext>(Modifier::Type::MUTABLE)) {
+		const_shared_ptr<StatementBlock> statement_block, const bool parallel) :
+		Statement(location), m_evaluation_identifier(
+				evaluation_identifier), m_expression(expression), m_statement_block(
+				statement_block), m_block_context(
+				make_shared<ExecutionContext>(Modifier::Type::MUTABLE)), m_parallel(
+				parallel) {
 }
 
 ForeachStatement::~ForeachStatement() {
@@ -72,7 +80,7 @@ const PreprocessResult ForeachStatement::Preprocess(
 					expression_type_specifier_result.GetData();
 
 			auto expression_type_result = expression_type_specifier->GetType(
-					type_table, RESOLVE);
+					*type_table, RESOLVE);
 			auto expression_type_errors = expression_type_result->GetErrors();
 			if (ErrorList::IsTerminator(expression_type_errors)) {
 				auto expression_type = expression_type_result->GetData<
@@ -125,7 +133,7 @@ const PreprocessResult ForeachStatement::Preprocess(
 							auto maybe_type_relation =
 									member_base_specifier->AnalyzeAssignmentTo(
 											expression_type_specifier,
-											context->GetTypeTable());
+											*context->GetTypeTable());
 							if (maybe_type_relation == EQUIVALENT) {
 								auto default_value =
 										expression_type->GetDefaultValue(
@@ -147,7 +155,7 @@ const PreprocessResult ForeachStatement::Preprocess(
 													complex_expression_type_specifier,
 													GetDefaultLocation());
 									auto default_symbol = data_type->GetSymbol(
-											context->GetTypeTable(),
+											*context->GetTypeTable(),
 											data_type_specifier, default_value);
 									m_block_context->InsertSymbol(
 											*m_evaluation_identifier,
@@ -202,6 +210,10 @@ const PreprocessResult ForeachStatement::Preprocess(
 		errors = expression_type_specifier_errors;
 	}
 
+	if (m_parallel) {
+		errors = ErrorList::Concatenate(errors, PreprocessReductions(context));
+	}
+
 	auto block_preprocess_result = m_statement_block->Preprocess(
 			m_block_context, return_type_specifier);
 	return_coverage = block_preprocess_result.GetReturnCoverage();
@@ -215,9 +227,6 @@ const PreprocessResult ForeachStatement::Preprocess(
 const ExecutionResult ForeachStatement::Execute(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure) const {
-	auto execution_context = ExecutionContext::GetRuntimeInstance(
-			m_block_context, context);
-
 	auto errors = ErrorList::GetTerminator();
 
 	auto expression_type_specifier_result = m_expression->GetTypeSpecifier(
@@ -232,8 +241,9 @@ const ExecutionResult ForeachStatement::Execute(
 		auto eval = m_expression->Evaluate(context, closure);
 		errors = ErrorList::Concatenate(errors, eval->GetErrors());
 		if (ErrorList::IsTerminator(errors)) {
-			auto raw_value = eval->GetRawData();
-			auto tag = make_shared<const string>("BEGIN THE LOOP");
+			plain_shared_ptr<void> raw_value = eval->GetRawData();
+			plain_shared_ptr<string> tag = make_shared<const string>(
+					"BEGIN THE LOOP");
 
 			plain_shared_ptr<ComplexTypeSpecifier> source_type_specifier;
 			auto as_maybe_specifier = dynamic_pointer_cast<
@@ -251,15 +261,38 @@ const ExecutionResult ForeachStatement::Execute(
 						const ComplexTypeSpecifier>(expression_type_specifier);
 			}
 
+			if (m_parallel) {
+				vector<plain_shared_ptr<Symbol>> items;
+				while (ErrorList::IsTerminator(errors)
+						&& !SameName(*tag, *TypeTable::GetNilName())) {
+					auto record = static_pointer_cast<const Record>(raw_value);
+					assert(record);
+					items.push_back(
+							record->GetDefinition()->GetSymbol(
+									ForeachStatement::DATA_NAME));
+					errors = Advance(record, source_type_specifier, context,
+							closure, tag, raw_value);
+				}
+
+				if (ErrorList::IsTerminator(errors)) {
+					return ExecuteParallel(items, context);
+				}
+
+				return ExecutionResult(errors);
+			}
+
+			auto execution_context = ExecutionContext::GetRuntimeInstance(
+					m_block_context, context);
+
 			while (ErrorList::IsTerminator(errors)
-					&& *tag != *TypeTable::GetNilName()) {
+					&& !SameName(*tag, *TypeTable::GetNilName())) {
 				auto record = static_pointer_cast<const Record>(raw_value);
 				assert(record);
 				auto data_symbol = record->GetDefinition()->GetSymbol(
 						ForeachStatement::DATA_NAME);
 				auto set_result = execution_context->SetSymbol(
 						*m_evaluation_identifier, data_symbol,
-						context->GetTypeTable());
+						*context->GetTypeTable());
 				assert(set_result == SET_SUCCESS);
 
 				auto execution_result = m_statement_block->Execute(
@@ -274,37 +307,8 @@ const ExecutionResult ForeachStatement::Execute(
 					return execution_result;
 				}
 
-				auto definition = record->GetDefinition();
-				auto next_member = definition->GetSymbol(
-						ForeachStatement::NEXT_NAME);
-
-				plain_shared_ptr<Sum> next_value = nullptr;
-				auto member_type_specifier = next_member->GetTypeSpecifier();
-				auto as_function_type_specifier = dynamic_pointer_cast<
-						const FunctionTypeSpecifier>(member_type_specifier);
-				if (as_function_type_specifier) {
-					auto function_eval = EvaluateMemberFunction(record,
-							source_type_specifier, ForeachStatement::NEXT_NAME,
-							context, closure);
-
-					auto function_eval_errors = function_eval->GetErrors();
-					if (ErrorList::IsTerminator(function_eval_errors)) {
-						next_value = function_eval->GetData<Sum>();
-						assert(next_value);
-						tag = next_value->GetTag();
-						raw_value = next_value->GetValue();
-					} else {
-						errors = ErrorList::Concatenate(errors,
-								function_eval_errors);
-					}
-				} else {
-					next_value = static_pointer_cast<const Sum>(
-							next_member->GetValue());
-					assert(next_value);
-
-					tag = next_value->GetTag();
-					raw_value = next_value->GetValue();
-				}
+				errors = Advance(record, source_type_specifier, context,
+						closure, tag, raw_value);
 			}
 		}
 	}
@@ -312,6 +316,176 @@ const ExecutionResult ForeachStatement::Execute(
 	return ExecutionResult(errors);
 }
 
+const ErrorListRef ForeachStatement::Advance(const_shared_ptr<Record> record,
+		const_shared_ptr<ComplexTypeSpecifier> source_type_specifier,
+		const shared_ptr<ExecutionContext> context,
+		const shared_ptr<ExecutionContext> closure,
+		plain_shared_ptr<string>& tag, plain_shared_ptr<void>& raw_value) {
+	auto definition = record->GetDefinition();
+	auto next_member = definition->GetSymbol(ForeachStatement::NEXT_NAME);
+
+	plain_shared_ptr<Sum> next_value = nullptr;
+	auto member_type_specifier = next_member->GetTypeSpecifier();
+	auto as_function_type_specifier = dynamic_pointer_cast<
+			const FunctionTypeSpecifier>(member_type_specifier);
+	if (as_function_type_specifier) {
+		auto function_eval = EvaluateMemberFunction(record,
+				source_type_specifier, ForeachStatement::NEXT_NAME, context,
+				closure);
+
+		auto function_eval_errors = function_eval->GetErrors();
+		if (!ErrorList::IsTerminator(function_eval_errors)) {
+			return function_eval_errors;
+		}
+
+		next_value = function_eval->GetData<Sum>();
+	} else {
+		next_value = static_pointer_cast<const Sum>(next_member->GetValue());
+	}
+
+	assert(next_value);
+	tag = next_value->GetTag();
+	raw_value = next_value->GetValue();
+	return ErrorList::GetTerminator();
+}
+
+const ErrorListRef ForeachStatement::PreprocessReductions(
+		const shared_ptr<ExecutionContext> context) const {
+	m_reductions.clear();
+	auto errors = EffectAnalysis::AnalyzeLoop(*m_evaluation_identifier,
+			m_statement_block, m_reductions);
+
+	for (auto& reduction : m_reductions) {
+		auto symbol = context->GetSymbol(*reduction.name, DEEP);
+		if (symbol == Symbol::GetDefaultSymbol()) {
+			// reported as undeclared when the body is preprocessed
+			continue;
+		}
+
+		auto type_specifier = symbol->GetTypeSpecifier();
+		auto is_number = *type_specifier == *PrimitiveTypeSpecifier::GetInt()
+				|| *type_specifier == *PrimitiveTypeSpecifier::GetDouble();
+		auto is_string = *type_specifier
+				== *PrimitiveTypeSpecifier::GetString();
+		if (is_number || (is_string && reduction.op == PLUS)) {
+			// each task accumulates into its own copy of the variable
+			m_block_context->InsertSymbol(*reduction.name, symbol);
+		} else {
+			errors = ErrorList::From(
+					make_shared<Error>(Error::SEMANTIC,
+							Error::PARALLEL_INVALID_REDUCTION,
+							reduction.location.begin, *reduction.name,
+							"only int and double variables can be added to or multiplied, and string variables appended to"),
+					errors);
+		}
+	}
+
+	return errors;
+}
+
+const ExecutionResult ForeachStatement::ExecuteParallel(
+		const vector<plain_shared_ptr<Symbol>>& items,
+		const shared_ptr<ExecutionContext> context) const {
+	auto count = items.size();
+	if (count == 0) {
+		return ExecutionResult();
+	}
+
+	// a few chunks per thread, so that threads that finish early can take
+	// over the remaining work; the profiler is not thread-safe
+	auto chunk_count = PROFILING ? 1 : Parallel::GetThreadCount() * 4;
+	if (chunk_count > count) {
+		chunk_count = count;
+	}
+
+	auto type_table = context->GetTypeTable();
+	vector<shared_ptr<ExecutionContext>> chunk_contexts;
+	vector<ErrorListRef> chunk_errors(chunk_count, ErrorList::GetTerminator());
+	for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+		auto chunk_context = ExecutionContext::GetRuntimeInstance(
+				m_block_context, context);
+		for (auto& reduction : m_reductions) {
+			auto name = *reduction.name;
+			auto type_specifier =
+					chunk_context->GetSymbol(name, SHALLOW)->GetTypeSpecifier();
+			if (*type_specifier == *PrimitiveTypeSpecifier::GetInt()) {
+				chunk_context->SetSymbol(name,
+						make_shared<int>(reduction.op == MULTIPLY ? 1 : 0),
+						*type_table);
+			} else if (*type_specifier
+					== *PrimitiveTypeSpecifier::GetDouble()) {
+				chunk_context->SetSymbol(name,
+						make_shared<double>(reduction.op == MULTIPLY ? 1 : 0),
+						*type_table);
+			} else {
+				chunk_context->SetSymbol(name, make_shared<string>(""),
+						*type_table);
+			}
+		}
+		chunk_contexts.push_back(chunk_context);
+	}
+
+	Parallel::Run(chunk_count, [&](const size_t chunk) {
+		auto chunk_context = chunk_contexts[chunk];
+		auto end = (chunk + 1) * count / chunk_count;
+		for (size_t i = chunk * count / chunk_count;
+				i < end && ErrorList::IsTerminator(chunk_errors[chunk]); i++) {
+			auto set_result = chunk_context->SetSymbol(*m_evaluation_identifier,
+					items[i], *type_table);
+			assert(set_result == SET_SUCCESS);
+
+			chunk_errors[chunk] =
+					m_statement_block->Execute(chunk_context).GetErrors();
+		}
+	});
+
+	for (auto& errors : chunk_errors) {
+		if (!ErrorList::IsTerminator(errors)) {
+			return ExecutionResult(errors);
+		}
+	}
+
+	// combine the partial results in item order
+	for (auto& reduction : m_reductions) {
+		auto name = *reduction.name;
+		auto symbol = context->GetSymbol(name, DEEP);
+		auto type_specifier = symbol->GetTypeSpecifier();
+		Value value;
+		if (*type_specifier == *PrimitiveTypeSpecifier::GetInt()) {
+			auto total = *static_pointer_cast<const int>(symbol->GetValue());
+			for (auto& chunk_context : chunk_contexts) {
+				auto partial = *static_pointer_cast<const int>(
+						chunk_context->GetSymbol(name, SHALLOW)->GetValue());
+				total = reduction.op == MULTIPLY ?
+						total * partial : total + partial;
+			}
+			value = Value(total);
+		} else if (*type_specifier == *PrimitiveTypeSpecifier::GetDouble()) {
+			auto total = *static_pointer_cast<const double>(symbol->GetValue());
+			for (auto& chunk_context : chunk_contexts) {
+				auto partial = *static_pointer_cast<const double>(
+						chunk_context->GetSymbol(name, SHALLOW)->GetValue());
+				total = reduction.op == MULTIPLY ?
+						total * partial : total + partial;
+			}
+			value = Value(total);
+		} else {
+			auto total = *static_pointer_cast<const string>(symbol->GetValue());
+			for (auto& chunk_context : chunk_contexts) {
+				total += *static_pointer_cast<const string>(
+						chunk_context->GetSymbol(name, SHALLOW)->GetValue());
+			}
+			value = Value(const_shared_ptr<void>(make_shared<string>(total)));
+		}
+
+		auto set_result = context->SetSymbol(name, type_specifier, value,
+				*type_table);
+		assert(set_result == SET_SUCCESS);
+	}
+
+	return ExecutionResult();
+}
+
 const_shared_ptr<Result> ForeachStatement::EvaluateMemberFunction(
 		const_shared_ptr<Record> record,
 		const_shared_ptr<ComplexTypeSpecifier> record_type_specifier,
@@ -349,7 +523,7 @@ const_shared_ptr<Result> ForeachStatement::EvaluateMemberFunction(
 						parameter_declaration->GetTypeSpecifier();
 				auto declaration_type_result =
 						declaration_type_specifier->GetType(
-								closure->GetTypeTable(), RETURN);
+								*closure->GetTypeTable(), RETURN);
 
 				auto type_lookup_errors = declaration_type_result->GetErrors();
 				if (ErrorList::IsTerminator(type_lookup_errors)) {
@@ -358,9 +532,10 @@ const_shared_ptr<Result> ForeachStatement::EvaluateMemberFunction(
 
 					// set symbol
 					auto maybe_wrapper = make_shared<Sum>(
-							MaybeTypeSpecifier::VARIANT_NAME, record);
+							MaybeTypeSpecifier::VARIANT_NAME,
+							MaybeTypeSpecifier::VARIANT_TAG_ID, record);
 					auto symbol = declaration_type->GetSymbol(
-							closure->GetTypeTable(), declaration_type_specifier,
+							*closure->GetTypeTable(), declaration_type_specifier,
 							maybe_wrapper);
 					auto insert_result = invocation_context->InsertSymbol(
 							*parameter_declaration->GetName(), symbol);
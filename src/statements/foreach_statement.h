@@ -21,17 +21,21 @@
 #define STATEMENTS_FOREACH_STATEMENT_H_
 
 #include <statement.h>
+#include <effect_analysis.h>
 
 class Expression;
 class StatementBlock;
 class Record;
 class ComplexTypeSpecifier;
+class Symbol;
 
 class ForeachStatement: public Statement {
 public:
-	ForeachStatement(const_shared_ptr<string> evaluation_identifier,
+	ForeachStatement(const yy::location location,
+			const_shared_ptr<string> evaluation_identifier,
 			const_shared_ptr<Expression> expression,
-			const_shared_ptr<StatementBlock> statement_block);
+			const_shared_ptr<StatementBlock> statement_block,
+			const bool parallel = false);
 	virtual ~ForeachStatement();
 
 	virtual const PreprocessResult Preprocess(
@@ -50,14 +54,54 @@ public:
 			const shared_ptr<ExecutionContext> execution_context,
 			const shared_ptr<ExecutionContext> closure);
 
+	const_shared_ptr<string> GetEvaluationIdentifier() const {
+		return m_evaluation_identifier;
+	}
+
+	const_shared_ptr<Expression> GetExpression() const {
+		return m_expression;
+	}
+
+	const_shared_ptr<StatementBlock> GetStatementBlock() const {
+		return m_statement_block;
+	}
+
+	const bool IsParallel() const {
+		return m_parallel;
+	}
+
 	static const_shared_ptr<std::string> DATA_NAME;
 	static const_shared_ptr<std::string> NEXT_NAME;
 
 private:
+	const ErrorListRef PreprocessReductions(
+			const shared_ptr<ExecutionContext> context) const;
+
+	/**
+	 * Run the body once per item on the thread pool. The items are collected
+	 * first; each task runs a contiguous chunk of them in its own context,
+	 * with every reduction variable starting from its identity, and the
+	 * partial results are combined in order once all tasks have finished.
+	 */
+	const ExecutionResult ExecuteParallel(
+			const vector<plain_shared_ptr<Symbol>>& items,
+			const shared_ptr<ExecutionContext> context) const;
+
+	/**
+	 * Move to the next item of the source, evaluating its 'next' member.
+	 */
+	static const ErrorListRef Advance(const_shared_ptr<Record> record,
+			const_shared_ptr<ComplexTypeSpecifier> source_type_specifier,
+			const shared_ptr<ExecutionContext> context,
+			const shared_ptr<ExecutionContext> closure,
+			plain_shared_ptr<string>& tag, plain_shared_ptr<void>& raw_value);
+
 	const_shared_ptr<string> m_evaluation_identifier;
 	const_shared_ptr<Expression> m_expression;
 	const_shared_ptr<StatementBlock> m_statement_block;
 	shared_ptr<ExecutionContext> m_block_context;
+	const bool m_parallel;
+	mutable vector<EffectAnalysis::Reduction> m_reductions;
 };
 
 #endif /* STATEMENTS_FOREACH_STATEMENT_H_ */
@@ -28,17 +28,21 @@
 #include <execution_context.h>
 #include <return_statement.h>
 
-IfStatement::IfStatement(const_shared_ptr<Expression> expression,
+IfStatement::IfStatement(const yy::location location,
+		const_shared_ptr<Expression> expression,
 		const_shared_ptr<StatementBlock> block) :
-		IfStatement(expression, block, nullptr) {
+		IfStatement(location, expression, block, nullptr) {
 }
 
-IfStatement::IfStatement(const_shared_ptr<Expression> expression,
+IfStatement::IfStatement(const yy::location location,
+		const_shared_ptr<Expression> expression,
 		const_shared_ptr<StatementBlock> block,
 		const_shared_ptr<StatementBlock> else_block) :
-		m_expression(expression), m_block(block), m_else_block(else_block), m_block_context(
+		Statement(location), m_expression(expression), m_block(block), m_else_block(
+				else_block), m_block_context(
 				make_shared<ExecutionContext>(Modifier::Type::MUTABLE)), m_else_block_context(
-				make_shared<ExecutionContext>(Modifier::Type::MUTABLE)) {
+				make_shared<ExecutionContext>(Modifier::Type::MUTABLE)), m_condition(
+				Optimizer::DYNAMIC) {
 }
 
 IfStatement::~IfStatement() {
@@ -63,9 +67,19 @@ const PreprocessResult IfStatement::Preprocess(
 			auto expression_analysis =
 					expression_type_specifier->AnalyzeAssignmentTo(
 							PrimitiveTypeSpecifier::GetInt(),
-							context->GetTypeTable());
+							*context->GetTypeTable());
 			if (expression_analysis == EQUIVALENT
 					|| expression_analysis == UNAMBIGUOUS) {
+				// both branches are preprocessed regardless, so that errors in
+				// an unreachable branch are still reported
+				m_condition = Optimizer::GetCondition(*m_expression, context);
+				if (m_condition == Optimizer::ALWAYS_TRUE && m_else_block) {
+					Optimizer::Trace(GetLocation(),
+							"removed unreachable else branch");
+				} else if (m_condition == Optimizer::ALWAYS_FALSE) {
+					Optimizer::Trace(GetLocation(),
+							"removed unreachable if branch");
+				}
 
 				// the preprocessed statement block context must persist, as it will contain initialized variables, etc.
 				// thus we have the context member variables, but these cannot be linked to a context until preprocessing begins
@@ -114,9 +128,12 @@ const PreprocessResult IfStatement::Preprocess(
 const ExecutionResult IfStatement::Execute(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure) const {
-	auto evaluation = m_expression->Evaluate(context, closure);
-	// NOTE: we are relying on our preprocessing passing to guarantee that the previous evaluation returned no errors
-	bool test = *(evaluation->GetData<bool>());
+	bool test = m_condition == Optimizer::ALWAYS_TRUE;
+	if (m_condition == Optimizer::DYNAMIC) {
+		auto evaluation = m_expression->Evaluate(context, closure);
+		// NOTE: we are relying on our preprocessing passing to guarantee that the previous evaluation returned no errors
+		test = evaluation->GetTaggedValue().As<bool>();
+	}
 
 	if (test) {
 		auto execution_context = ExecutionContext::GetRuntimeInstance(
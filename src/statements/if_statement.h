@@ -21,15 +21,18 @@
 #define IF_STATEMENT_H_
 
 #include "statement.h"
+#include <optimizer.h>
 
 class Expression;
 class StatementBlock;
 
 class IfStatement: public Statement {
 public:
-	IfStatement(const_shared_ptr<Expression> expression,
+	IfStatement(const yy::location location,
+			const_shared_ptr<Expression> expression,
 			const_shared_ptr<StatementBlock> block);
-	IfStatement(const_shared_ptr<Expression> expression,
+	IfStatement(const yy::location location,
+			const_shared_ptr<Expression> expression,
 			const_shared_ptr<StatementBlock> block,
 			const_shared_ptr<StatementBlock> else_block);
 	virtual ~IfStatement();
@@ -38,6 +41,14 @@ public:
 		return m_expression;
 	}
 
+	const_shared_ptr<StatementBlock> GetBlock() const {
+		return m_block;
+	}
+
+	const_shared_ptr<StatementBlock> GetElseBlock() const {
+		return m_else_block;
+	}
+
 	virtual const PreprocessResult Preprocess(
 			const shared_ptr<ExecutionContext> context,
 			const shared_ptr<ExecutionContext> closure,
@@ -53,6 +64,11 @@ private:
 	const_shared_ptr<StatementBlock> m_else_block;
 	shared_ptr<ExecutionContext> m_block_context;
 	shared_ptr<ExecutionContext> m_else_block_context;
+
+	/**
+	 * Set during preprocessing if the condition is constant.
+	 */
+	mutable Optimizer::Condition m_condition;
 };
 
 #endif /* IF_STATEMENT_H_ */
@@ -23,11 +23,12 @@
 #include <variable.h>
 #include <variable_expression.h>
 
-InvokeStatement::InvokeStatement(const_shared_ptr<Variable> variable,
+InvokeStatement::InvokeStatement(const yy::location location,
+		const_shared_ptr<Variable> variable,
 		ArgumentListRef argument_list,
 		const yy::location argument_list_position) :
-		m_variable(variable), m_argument_list(argument_list), m_argument_list_position(
-				argument_list_position), m_expression(
+		Statement(location), m_variable(variable), m_argument_list(
+				argument_list), m_argument_list_position(argument_list_position), m_expression(
 				InvokeExpression::BuildInvokeExpression(
 						m_variable->GetLocation(),
 						make_shared<VariableExpression>(
@@ -27,7 +27,8 @@ class Variable;
 
 class InvokeStatement: public Statement {
 public:
-	InvokeStatement(const_shared_ptr<Variable> variable,
+	InvokeStatement(const yy::location location,
+			const_shared_ptr<Variable> variable,
 			ArgumentListRef argument_list,
 			const yy::location argument_list_position);
 	virtual ~InvokeStatement();
@@ -41,6 +42,10 @@ public:
 			const shared_ptr<ExecutionContext> context,
 			const shared_ptr<ExecutionContext> closure) const;
 
+	const_shared_ptr<Expression> GetExpression() const {
+		return m_expression;
+	}
+
 private:
 	const_shared_ptr<Variable> m_variable;
 	ArgumentListRef m_argument_list;
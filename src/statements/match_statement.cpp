@@ -32,14 +32,15 @@
 #include <maybe_type_specifier.h>
 #include <unit_type.h>
 #include <return_statement.h>
+#include <map>
 
 MatchStatement::MatchStatement(const yy::location statement_location,
 		const_shared_ptr<Expression> source_expression,
 		const MatchListRef match_list, const yy::location match_list_location) :
-		m_statement_location(statement_location), m_source_expression(
+		Statement(statement_location), m_source_expression(
 				source_expression), m_match_list(match_list), m_match_list_location(
 				match_list_location), m_match_contexts(
-				GenerateMatchContexts(match_list)) {
+				GenerateMatchContexts(match_list)), m_dispatch_base(0) {
 	assert(m_match_contexts);
 }
 
@@ -63,7 +64,7 @@ const PreprocessResult MatchStatement::Preprocess(
 					expression_type_specifier_result.GetData();
 
 			auto expression_type_result = expression_type_specifier->GetType(
-					context->GetTypeTable(), RESOLVE);
+					*context->GetTypeTable(), RESOLVE);
 
 			errors = expression_type_result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
@@ -85,10 +86,12 @@ const PreprocessResult MatchStatement::Preprocess(
 					assert(source_sum_specifier);
 
 					auto match_names = make_shared<std::set<std::string>>();
+					std::map<std::string, plain_shared_ptr<MatchCase>> match_cases;
 
 					shared_ptr<const StatementBlock> default_match_block =
 							nullptr;
 					shared_ptr<ExecutionContext> default_match_context = nullptr;
+					plain_shared_ptr<MatchCase> default_match_case = nullptr;
 
 					auto match_list = m_match_list;
 					auto match_context = m_match_contexts;
@@ -108,6 +111,9 @@ const PreprocessResult MatchStatement::Preprocess(
 
 							default_match_context = matched_context;
 							default_match_block = match_body;
+							default_match_case = shared_ptr<MatchCase>(
+									new MatchCase { match, nullptr,
+											matched_context });
 						} else {
 							auto variant_type = type_definition->GetType<
 									TypeDefinition>(match_name, SHALLOW,
@@ -140,11 +146,16 @@ const PreprocessResult MatchStatement::Preprocess(
 													*type_definition);
 									const_shared_ptr<Symbol> default_symbol =
 											variant_type->GetSymbol(
-													context->GetTypeTable(),
+													*context->GetTypeTable(),
 													variant_type_specifier,
 													default_value);
 									matched_context->InsertSymbol(*alias_name,
 											default_symbol);
+									match_cases[*match_name] = shared_ptr<
+											MatchCase>(
+											new MatchCase { match,
+													variant_type_specifier,
+													matched_context });
 
 									matched_context->LinkToParent(context);
 									// use match context as closure context so match variables are defined in closure
@@ -238,7 +249,7 @@ const PreprocessResult MatchStatement::Preprocess(
 							errors = ErrorList::From(
 									make_shared<Error>(Error::SEMANTIC,
 											Error::INCOMPLETE_MATCH,
-											m_statement_location.begin, result),
+											GetLocation().begin, result),
 									errors);
 						}
 					} else if (default_match_block) {
@@ -246,7 +257,36 @@ const PreprocessResult MatchStatement::Preprocess(
 						errors = ErrorList::From(
 								make_shared<Error>(Error::SEMANTIC,
 										Error::EXTRANEOUS_DEFAULT_MATCH,
-										m_statement_location.begin), errors);
+										GetLocation().begin), errors);
+					}
+
+					if (ErrorList::IsTerminator(errors)
+							&& !variant_names->empty()) {
+						// build the jump table that Execute dispatches through
+						vector<std::pair<size_t, plain_shared_ptr<MatchCase>>> entries;
+						for (auto& variant_name : *variant_names) {
+							auto match_case = match_cases.find(variant_name);
+							entries.push_back(
+									std::make_pair(
+											Sum::InternTag(variant_name),
+											match_case != match_cases.end() ?
+													match_case->second :
+													default_match_case));
+						}
+
+						auto base = entries.front().first;
+						auto limit = base;
+						for (auto& entry : entries) {
+							base = std::min(base, entry.first);
+							limit = std::max(limit, entry.first);
+						}
+
+						m_dispatch_table.assign(limit - base + 1, nullptr);
+						for (auto& entry : entries) {
+							m_dispatch_table[entry.first - base] = entry.second;
+						}
+						m_dispatch_base = base;
+						m_source_type_specifier = expression_type_specifier;
 					}
 				} else {
 					errors = ErrorList::From(
@@ -266,142 +306,41 @@ const PreprocessResult MatchStatement::Preprocess(
 const ExecutionResult MatchStatement::Execute(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure) const {
-	auto expression_type_specifier_result =
-			m_source_expression->GetTypeSpecifier(context);
+	auto result = m_source_expression->Evaluate(context, closure);
 
-	auto errors = expression_type_specifier_result.GetErrors();
+	auto errors = result->GetErrors();
 	auto return_value = Symbol::GetDefaultSymbol();
 	if (ErrorList::IsTerminator(errors)) {
-		auto expression_type_specifier =
-				expression_type_specifier_result.GetData();
-
-		auto expression_type_result = expression_type_specifier->GetType(
-				context->GetTypeTable());
-
-		errors = expression_type_result->GetErrors();
-		if (ErrorList::IsTerminator(errors)) {
-			auto expression_type = expression_type_result->GetData<
-					TypeDefinition>();
-
-			auto sum_type = dynamic_pointer_cast<const SumType>(
-					expression_type);
-			if (sum_type) {
-				auto source_sum_specifier = dynamic_pointer_cast<
-						const ComplexTypeSpecifier>(expression_type_specifier);
-				assert(source_sum_specifier);
-
-				auto result = m_source_expression->Evaluate(context, closure);
-				errors = result->GetErrors();
-
-				if (ErrorList::IsTerminator(errors)) {
-					auto as_sum = result->GetData<Sum>(); //TODO: validate the assumption that this result yields a sum
-					auto tag = *as_sum->GetTag();
-
-					shared_ptr<const StatementBlock> default_match_block =
-							nullptr;
-					shared_ptr<ExecutionContext> default_match_context = nullptr;
-
-					bool matched = false;
-					auto match_list_subject = m_match_list;
-					auto match_context = m_match_contexts;
-					while (!MatchList::IsTerminator(match_list_subject)) {
-						auto match = match_list_subject->GetData();
-						auto match_name = *match->GetName();
-						auto match_body = match->GetBlock();
-
-						if (match_name == tag) {
-							matched = true;
-							auto variant_type =
-									sum_type->GetDefinition()->GetType<
-											TypeDefinition>(match_name, SHALLOW,
-											RETURN);
-							if (variant_type) {
-								auto matched_context = match_context->GetData();
-
-								auto execution_context =
-										ExecutionContext::GetRuntimeInstance(
-												matched_context, context);
-
-								plain_shared_ptr<TypeSpecifier> variant_type_specifier;
-								auto as_alias = dynamic_pointer_cast<
-										const AliasDefinition>(variant_type);
-								if (as_alias) {
-									variant_type_specifier =
-											as_alias->GetOriginal();
-								} else {
-									variant_type_specifier =
-											variant_type->GetTypeSpecifier(
-													match->GetName(),
-													source_sum_specifier,
-													GetDefaultLocation());
-								}
-
-								auto alias_name = *(match->GetAlias());
-								auto set_result = execution_context->SetSymbol(
-										alias_name, variant_type_specifier,
-										as_sum->GetValue(),
-										context->GetTypeTable());
-								assert(set_result == SET_SUCCESS);
-
-								// use execution context for closure so internal function closures are correct
-								auto block_result = match_body->Execute(
-										execution_context, execution_context);
-								return_value = block_result.GetReturnValue();
-								errors = ErrorList::Concatenate(errors,
-										block_result.GetErrors());
-							} else {
-								errors =
-										ErrorList::From(
-												make_shared<Error>(
-														Error::SEMANTIC,
-														Error::UNDECLARED_TYPE,
-														match->GetNameLocation().begin,
-														expression_type_specifier->ToString()
-																+ "."
-																+ match_name),
-												errors);
-							}
-							break;
-						} else if (match_name == *Match::DEFAULT_MATCH_NAME) {
-							auto matched_context = match_context->GetData();
-
-							default_match_context = matched_context;
-							default_match_block = match_body;
-						}
-
-						match_context = match_context->GetNext();
-						match_list_subject = match_list_subject->GetNext();
-					}
+		auto as_sum = result->GetData<Sum>(); //TODO: validate the assumption that this result yields a sum
+		auto match_case = GetMatchCase(as_sum->GetTagId());
+		if (match_case) {
+			auto execution_context = ExecutionContext::GetRuntimeInstance(
+					match_case->context, context);
+
+			if (match_case->variant_type_specifier) {
+				auto alias_name = match_case->match->GetAlias();
+				auto set_result = execution_context->SetSymbol(*alias_name,
+						match_case->variant_type_specifier,
+						Value(as_sum->GetValue()), *context->GetTypeTable());
+				assert(set_result == SET_SUCCESS);
+			}
 
-					if (!matched) {
-						if (default_match_block) {
-							auto execution_context =
-									ExecutionContext::GetRuntimeInstance(
-											default_match_context, context);
-
-							auto block_result = default_match_block->Execute(
-									execution_context, execution_context);
-							return_value = block_result.GetReturnValue();
-							errors = ErrorList::Concatenate(errors,
-									block_result.GetErrors());
-						} else {
-							errors =
-									ErrorList::From(
-											make_shared<Error>(Error::RUNTIME,
-													Error::MATCH_FAILURE,
-													m_source_expression->GetLocation().begin,
-													expression_type_specifier->ToString()),
-											errors);
-						}
-					}
-				}
-			} else {
-				errors = ErrorList::From(
-						make_shared<Error>(Error::SEMANTIC,
-								Error::MATCH_REQUIRES_SUM,
-								m_source_expression->GetLocation().begin,
-								expression_type_specifier->ToString()), errors);
+			// use execution context for closure so internal function closures are correct
+			auto block_result = match_case->match->GetBlock()->Execute(
+					execution_context, execution_context);
+			if (block_result.GetTailCall()) {
+				return block_result;
 			}
+
+			return_value = block_result.GetReturnValue();
+			errors = ErrorList::Concatenate(errors, block_result.GetErrors());
+		} else {
+			errors = ErrorList::From(
+					make_shared<Error>(Error::RUNTIME, Error::MATCH_FAILURE,
+							m_source_expression->GetLocation().begin,
+							m_source_type_specifier ?
+									m_source_type_specifier->ToString() :
+									*as_sum->GetTag()), errors);
 		}
 	}
 
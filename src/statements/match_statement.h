@@ -22,6 +22,7 @@
 
 #include <statement.h>
 #include <match.h>
+#include <vector>
 
 class Expression;
 
@@ -36,10 +37,6 @@ public:
 			const yy::location match_list_location);
 	virtual ~MatchStatement();
 
-	const yy::location GetStatementLocation() const {
-		return m_statement_location;
-	}
-
 	const const_shared_ptr<Expression> GetSourceExpression() const {
 		return m_source_expression;
 	}
@@ -65,11 +62,37 @@ public:
 			const MatchListRef match_list);
 
 private:
-	const yy::location m_statement_location;
+	/**
+	 * Everything needed to run one arm of the match, resolved during
+	 * preprocessing. The default arm has no variant type specifier.
+	 */
+	struct MatchCase {
+		plain_shared_ptr<Match> match;
+		plain_shared_ptr<TypeSpecifier> variant_type_specifier;
+		shared_ptr<ExecutionContext> context;
+	};
+
+	const_shared_ptr<MatchCase> GetMatchCase(const size_t tag_id) const {
+		auto index = tag_id - m_dispatch_base;
+		if (tag_id >= m_dispatch_base && index < m_dispatch_table.size()) {
+			return m_dispatch_table[index];
+		}
+
+		return nullptr;
+	}
+
 	const_shared_ptr<Expression> m_source_expression;
 	const MatchListRef m_match_list;
 	const yy::location m_match_list_location;
 	const MatchContextListRef m_match_contexts;
+
+	/**
+	 * Match arms indexed by interned variant tag, offset by the lowest tag id
+	 * of the source sum type.
+	 */
+	mutable vector<plain_shared_ptr<MatchCase>> m_dispatch_table;
+	mutable size_t m_dispatch_base;
+	mutable plain_shared_ptr<TypeSpecifier> m_source_type_specifier;
 };
 
 #endif /* STATEMENTS_MATCH_STATEMENT_H_ */
@@ -21,8 +21,9 @@
 #include "print_statement.h"
 #include <defaults.h>
 
-PrintStatement::PrintStatement(const_shared_ptr<Expression> expression) :
-		m_expression(expression) {
+PrintStatement::PrintStatement(const yy::location location,
+		const_shared_ptr<Expression> expression) :
+		Statement(location), m_expression(expression) {
 }
 
 PrintStatement::~PrintStatement() {
@@ -42,8 +43,12 @@ const ExecutionResult PrintStatement::Execute(
 	auto string_result = m_expression->ToString(context);
 	auto errors = string_result.GetErrors();
 	if (ErrorList::IsTerminator(errors)) {
-		std::cout << *(string_result.GetData()) << "\n";
+		Print(*(string_result.GetData()));
 	}
 
 	return ExecutionResult(errors);
 }
+
+void PrintStatement::Print(const string& text) {
+	std::cout << text << "\n";
+}
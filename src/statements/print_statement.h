@@ -26,7 +26,8 @@ class Expression;
 
 class PrintStatement: public Statement {
 public:
-	PrintStatement(const_shared_ptr<Expression> expression);
+	PrintStatement(const yy::location location,
+			const_shared_ptr<Expression> expression);
 	virtual ~PrintStatement();
 
 	virtual const PreprocessResult Preprocess(
@@ -42,6 +43,11 @@ public:
 		return m_expression;
 	}
 
+	/**
+	 * Write a line of program output.
+	 */
+	static void Print(const string& text);
+
 private:
 	const_shared_ptr<Expression> m_expression;
 };
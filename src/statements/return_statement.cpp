@@ -24,9 +24,14 @@
 #include <sum_type_specifier.h>
 #include <unit_type.h>
 #include <function_type_specifier.h>
-
-ReturnStatement::ReturnStatement(const_shared_ptr<Expression> expression) :
-		m_expression(expression) {
+#include <invoke_expression.h>
+#include <function.h>
+#include <function_declaration.h>
+#include <profiler.h>
+
+ReturnStatement::ReturnStatement(const yy::location location,
+		const_shared_ptr<Expression> expression) :
+		Statement(location), m_expression(expression) {
 }
 
 ReturnStatement::~ReturnStatement() {
@@ -37,6 +42,7 @@ const PreprocessResult ReturnStatement::Preprocess(
 		const shared_ptr<ExecutionContext> closure,
 		const_shared_ptr<TypeSpecifier> return_type_specifier) const {
 	auto errors = m_expression->Validate(context);
+	m_tail_call = nullptr;
 
 	if (ErrorList::IsTerminator(errors)) {
 		auto expression_type_specifier_result = m_expression->GetTypeSpecifier(
@@ -48,7 +54,7 @@ const PreprocessResult ReturnStatement::Preprocess(
 
 			auto assignment_analysis =
 					expression_type_specifier->AnalyzeAssignmentTo(
-							return_type_specifier, context->GetTypeTable());
+							return_type_specifier, *context->GetTypeTable());
 			if (assignment_analysis == AnalysisResult::AMBIGUOUS) {
 				errors = ErrorList::From(
 						make_shared<Error>(Error::SEMANTIC,
@@ -61,6 +67,12 @@ const PreprocessResult ReturnStatement::Preprocess(
 						make_shared<Error>(Error::SEMANTIC,
 								Error::FUNCTION_RETURN_MISMATCH,
 								m_expression->GetLocation().begin), errors);
+			} else if (assignment_analysis == AnalysisResult::EQUIVALENT
+					&& typeid(*m_expression) == typeid(InvokeExpression)) {
+				// builtins such as open and close derive from InvokeExpression,
+				// but do not invoke a function
+				m_tail_call = static_pointer_cast<const InvokeExpression>(
+						m_expression);
 			}
 		}
 	}
@@ -71,6 +83,16 @@ const PreprocessResult ReturnStatement::Preprocess(
 const ExecutionResult ReturnStatement::Execute(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure) const {
+	if (m_tail_call && !PROFILING) {
+		auto invocation_result = m_tail_call->Bind(context, closure);
+		auto errors = invocation_result.GetErrors();
+		if (ErrorList::IsTerminator(errors)) {
+			return ExecutionResult(invocation_result.GetData());
+		}
+
+		return ExecutionResult(errors);
+	}
+
 	auto result = m_expression->Evaluate(context, closure);
 
 	auto errors = result->GetErrors();
@@ -80,25 +102,46 @@ const ExecutionResult ReturnStatement::Execute(
 
 		errors = expression_type_specifier_result.GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
-			auto expression_type_specifier =
-					expression_type_specifier_result.GetData();
-
-			auto weakenable = dynamic_pointer_cast<const ComplexTypeSpecifier>(
-					expression_type_specifier)
-					|| dynamic_pointer_cast<const ArrayTypeSpecifier>(
-							expression_type_specifier)
-					|| dynamic_pointer_cast<const FunctionTypeSpecifier>(
-							expression_type_specifier);
 			return ExecutionResult(
-					const_shared_ptr<Symbol>(
-							new Symbol(expression_type_specifier,
-									result->GetRawData(), weakenable)));
+					MakeReturnValue(expression_type_specifier_result.GetData(),
+							result->GetRawData()));
 		}
 	}
 
 	return ExecutionResult(errors);
 }
 
+const ExecutionResult ReturnStatement::Complete(
+		const ExecutionResult& result) {
+	auto tail_call = result.GetTailCall();
+	if (!tail_call) {
+		return result;
+	}
+
+	auto return_type_specifier =
+			tail_call->variant->GetDeclaration()->GetReturnTypeSpecifier();
+	auto value = Function::Execute(tail_call);
+	auto errors = value->GetErrors();
+	if (!ErrorList::IsTerminator(errors)) {
+		return ExecutionResult(errors);
+	}
+
+	return ExecutionResult(
+			MakeReturnValue(return_type_specifier, value->GetRawData()));
+}
+
+const_shared_ptr<Symbol> ReturnStatement::MakeReturnValue(
+		const_shared_ptr<TypeSpecifier> type_specifier,
+		const_shared_ptr<void> value) {
+	auto weakenable = dynamic_pointer_cast<const ComplexTypeSpecifier>(
+			type_specifier)
+			|| dynamic_pointer_cast<const ArrayTypeSpecifier>(type_specifier)
+			|| dynamic_pointer_cast<const FunctionTypeSpecifier>(
+					type_specifier);
+	return const_shared_ptr<Symbol>(
+			new Symbol(type_specifier, value, weakenable));
+}
+
 const PreprocessResult::ReturnCoverage ReturnStatement::CoverageTransition(
 		PreprocessResult::ReturnCoverage current,
 		PreprocessResult::ReturnCoverage input, bool is_start) {
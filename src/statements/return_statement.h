@@ -23,10 +23,13 @@
 #include <statement.h>
 
 class Expression;
+class InvokeExpression;
+class TypeSpecifier;
 
 class ReturnStatement: public Statement {
 public:
-	ReturnStatement(const_shared_ptr<Expression> expression);
+	ReturnStatement(const yy::location location,
+			const_shared_ptr<Expression> expression);
 	virtual ~ReturnStatement();
 
 	virtual const PreprocessResult Preprocess(
@@ -42,8 +45,29 @@ public:
 			PreprocessResult::ReturnCoverage current,
 			PreprocessResult::ReturnCoverage input, bool is_start);
 
+	/**
+	 * Run any tail call the result holds to completion, yielding an ordinary
+	 * return value. Statement lists that are not function bodies (e.g. the
+	 * root block) must complete their results before inspecting them.
+	 */
+	static const ExecutionResult Complete(const ExecutionResult& result);
+
+	const_shared_ptr<Expression> GetExpression() const {
+		return m_expression;
+	}
+
 private:
+	static const_shared_ptr<Symbol> MakeReturnValue(
+			const_shared_ptr<TypeSpecifier> type_specifier,
+			const_shared_ptr<void> value);
+
 	const_shared_ptr<Expression> m_expression;
+	/**
+	 * Set during preprocessing if the returned expression is an invocation
+	 * whose result needs no conversion, in which case it is executed by the
+	 * enclosing function's trampoline instead of recursively.
+	 */
+	mutable plain_shared_ptr<InvokeExpression> m_tail_call;
 };
 
 #endif /* STATEMENTS_RETURN_STATEMENT_H_ */
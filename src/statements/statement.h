@@ -30,11 +30,16 @@ class TypeSpecifier;
 
 class Statement {
 public:
-	Statement() {
+	Statement(const yy::location location) :
+			m_location(location) {
 	}
 	virtual ~Statement() {
 	}
 
+	const yy::location GetLocation() const {
+		return m_location;
+	}
+
 	/**
 	 * Pre-process the statement. Here the symbol table is populated, and semantic verification is carried out.
 	 */
@@ -49,6 +54,9 @@ public:
 	virtual const ExecutionResult Execute(
 			const shared_ptr<ExecutionContext> context,
 			const shared_ptr<ExecutionContext> closure) const = 0;
+
+private:
+	const yy::location m_location;
 };
 
 typedef const LinkedList<const Statement, NO_DUPLICATES> StatementList;
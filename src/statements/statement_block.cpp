@@ -25,6 +25,7 @@
 #include <specifiers/type_specifier.h>
 #include <return_statement.h>
 #include <if_statement.h>
+#include <profiler.h>
 
 using namespace std;
 
@@ -78,7 +79,11 @@ const ExecutionResult StatementBlock::Execute(
 	auto subject = m_statements;
 	while (!StatementList::IsTerminator(subject)) {
 		const_shared_ptr<Statement> statement = subject->GetData();
-		auto execution_result = statement->Execute(context, closure_context);
+		auto execution_result =
+				PROFILING ?
+						Profiler::Execute(*statement, context,
+								closure_context) :
+						statement->Execute(context, closure_context);
 
 		if (!ErrorList::IsTerminator(execution_result.GetErrors())
 				|| execution_result.NeedsReturn()) {
@@ -50,6 +50,10 @@ public:
 		return m_location;
 	}
 
+	const StatementListRef GetStatements() const {
+		return m_statements;
+	}
+
 private:
 	StatementListRef m_statements;
 	const yy::location m_location;
@@ -22,12 +22,16 @@
 #include <execution_context.h>
 #include <return_statement.h>
 #include <while_statement.h>
+#include <bytecode_compiler.h>
+#include <virtual_machine.h>
 
-WhileStatement::WhileStatement(const_shared_ptr<Expression> expression,
+WhileStatement::WhileStatement(const yy::location location,
+		const_shared_ptr<Expression> expression,
 		const_shared_ptr<StatementBlock> block, WhileMode mode) :
-		m_expression(expression), m_block(block), m_block_context(
+		Statement(location), m_expression(expression), m_block(block), m_block_context(
 				make_shared<ExecutionContext>(Modifier::Type::MUTABLE)), m_mode(
-				mode) {
+				mode), m_bytecode(nullptr), m_condition(
+				Optimizer::DYNAMIC) {
 }
 
 WhileStatement::~WhileStatement() {
@@ -52,9 +56,16 @@ const PreprocessResult WhileStatement::Preprocess(
 			auto expression_analysis =
 					expression_type_specifier->AnalyzeAssignmentTo(
 							PrimitiveTypeSpecifier::GetInt(),
-							context->GetTypeTable());
+							*context->GetTypeTable());
 			if (expression_analysis == EQUIVALENT
 					|| expression_analysis == UNAMBIGUOUS) {
+				m_condition = Optimizer::GetCondition(*m_expression, context);
+				if (m_condition == Optimizer::ALWAYS_FALSE) {
+					Optimizer::Trace(GetLocation(),
+							m_mode == DO_WHILE ?
+									"removed loop; body runs once" :
+									"removed loop that never runs");
+				}
 
 				// the preprocessed statement block context must persist, as it will contain initialized variables, etc.
 				// thus we have the context member variables, but these cannot be linked to a context until preprocessing begins
@@ -85,6 +96,21 @@ const PreprocessResult WhileStatement::Preprocess(
 const ExecutionResult WhileStatement::Execute(
 		const shared_ptr<ExecutionContext> context,
 		const shared_ptr<ExecutionContext> closure) const {
+	if (m_condition == Optimizer::ALWAYS_FALSE && m_mode == WHILE) {
+		return ExecutionResult();
+	}
+
+	if (EXECUTION_ENGINE == VIRTUAL_MACHINE) {
+		call_once(m_compiled, [this, &context]() {
+			m_bytecode = BytecodeCompiler::Compile(*this, context);
+		});
+
+		if (m_bytecode
+				&& VirtualMachine::CanExecute(*m_bytecode, context)) {
+			return VirtualMachine::Execute(*m_bytecode, context);
+		}
+	}
+
 	auto execution_context = ExecutionContext::GetRuntimeInstance(
 			m_block_context, context);
 
@@ -95,7 +121,13 @@ const ExecutionResult WhileStatement::Execute(
 		}
 	}
 
-	while (*(m_expression->Evaluate(context, closure)->GetData<bool>())) {
+	if (m_condition == Optimizer::ALWAYS_FALSE) {
+		return ExecutionResult();
+	}
+
+	while (m_condition == Optimizer::ALWAYS_TRUE
+			|| m_expression->Evaluate(context, closure)->GetTaggedValue().As<
+					bool>()) {
 		auto execution_result = m_block->Execute(execution_context, closure);
 		if (execution_result.NeedsReturn()) {
 			return execution_result;
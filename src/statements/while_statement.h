@@ -20,8 +20,11 @@
 #ifndef STATEMENTS_WHILE_STATEMENT_H_
 #define STATEMENTS_WHILE_STATEMENT_H_
 
+#include <mutex>
 #include "statement.h"
+#include <optimizer.h>
 
+class Bytecode;
 class Expression;
 class StatementBlock;
 
@@ -31,7 +34,8 @@ public:
 		WHILE, DO_WHILE
 	};
 
-	WhileStatement(const_shared_ptr<Expression> expression,
+	WhileStatement(const yy::location location,
+			const_shared_ptr<Expression> expression,
 			const_shared_ptr<StatementBlock> block, WhileMode mode);
 	virtual ~WhileStatement();
 
@@ -52,11 +56,23 @@ public:
 		return m_expression;
 	}
 
+	const WhileMode GetMode() const {
+		return m_mode;
+	}
+
 private:
 	const_shared_ptr<Expression> m_expression;
 	const_shared_ptr<StatementBlock> m_block;
 	shared_ptr<ExecutionContext> m_block_context;
 	const WhileMode m_mode;
+	// compiled on first execution when the virtual machine engine is selected; null if compilation failed
+	mutable shared_ptr<const Bytecode> m_bytecode;
+	mutable once_flag m_compiled;
+
+	/**
+	 * Set during preprocessing if the condition is constant.
+	 */
+	mutable Optimizer::Condition m_condition;
 };
 
 #endif /* STATEMENTS_WHILE_STATEMENT_H_ */
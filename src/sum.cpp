@@ -24,9 +24,12 @@
 #include <sum_type.h>
 #include <record_type.h>
 #include <unit_type.h>
+#include <mutex>
+#include <unordered_map>
 
-Sum::Sum(const_shared_ptr<std::string> tag, const_shared_ptr<void> value) :
-		m_tag(tag), m_value(value) {
+Sum::Sum(const_shared_ptr<std::string> tag, const size_t tag_id,
+		const_shared_ptr<void> value) :
+		m_tag(tag), m_tag_id(tag_id), m_value(value) {
 	assert(m_tag && *m_tag != "");
 	assert(m_value);
 }
@@ -34,6 +37,15 @@ Sum::Sum(const_shared_ptr<std::string> tag, const_shared_ptr<void> value) :
 Sum::~Sum() {
 }
 
+const size_t Sum::InternTag(const std::string& tag) {
+	static std::mutex mutex;
+	static std::unordered_map<std::string, size_t> tags;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto result = tags.insert(std::make_pair(tag, tags.size()));
+	return result.first->second;
+}
+
 const string Sum::ToString(const SumType& type, const TypeTable& type_table,
 		const Indent& indent) const {
 	ostringstream buffer;
@@ -53,6 +65,7 @@ const_shared_ptr<Sum> Sum::GetDefaultInstance(const SumType& type) {
 	auto variant_type = type_table->GetType<TypeDefinition>(variant_name,
 			SHALLOW, RESOLVE);
 	auto default_value = variant_type->GetDefaultValue(*type_table);
-	auto result = make_shared<Sum>(variant_name, default_value);
+	auto result = make_shared<Sum>(variant_name, type.GetFirstVariantTagId(),
+			default_value);
 	return result;
 }
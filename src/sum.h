@@ -27,7 +27,13 @@ class SumType;
 
 class Sum {
 public:
-	Sum(const_shared_ptr<std::string> tag, const_shared_ptr<void> value);
+	/**
+	 * Create a sum value. The tag id must be the one InternTag assigns to the
+	 * tag; callers take it from the sum type or from a well-known constant,
+	 * so that building a value does not have to intern its tag.
+	 */
+	Sum(const_shared_ptr<std::string> tag, const size_t tag_id,
+			const_shared_ptr<void> value);
 	virtual ~Sum();
 
 	static const_shared_ptr<Sum> GetDefaultInstance(const SumType& type);
@@ -40,11 +46,29 @@ public:
 		return m_tag;
 	}
 
+	/**
+	 * The interned form of this sum's tag. See InternTag.
+	 */
+	const size_t GetTagId() const {
+		return m_tag_id;
+	}
+
+	/**
+	 * Map a variant name to a small integer that is unique to that name for
+	 * the lifetime of the process. Sum types intern their variant names when
+	 * they are built, so the ids of a type's variants are usually adjacent.
+	 *
+	 * This function is thread-safe, but takes a process-wide lock; it is meant
+	 * for building types, not values.
+	 */
+	static const size_t InternTag(const std::string& tag);
+
 	const string ToString(const SumType& type, const TypeTable& type_table,
 			const Indent& indent) const;
 
 private:
 	const_shared_ptr<std::string> m_tag;
+	const size_t m_tag_id;
 	const_shared_ptr<void> m_value;
 };
 
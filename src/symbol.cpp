@@ -39,23 +39,19 @@
 #include <memory>
 
 Symbol::Symbol(const_shared_ptr<bool> value) :
-		Symbol(PrimitiveTypeSpecifier::GetBoolean(),
-				static_pointer_cast<const void>(value), false) {
+		Symbol(PrimitiveTypeSpecifier::GetBoolean(), Value(*value), false) {
 }
 
 Symbol::Symbol(const_shared_ptr<int> value) :
-		Symbol(PrimitiveTypeSpecifier::GetInt(),
-				static_pointer_cast<const void>(value), false) {
+		Symbol(PrimitiveTypeSpecifier::GetInt(), Value(*value), false) {
 }
 
 Symbol::Symbol(const_shared_ptr<const std::uint8_t> value) :
-		Symbol(PrimitiveTypeSpecifier::GetByte(),
-				static_pointer_cast<const void>(value), false) {
+		Symbol(PrimitiveTypeSpecifier::GetByte(), Value(*value), false) {
 }
 
 Symbol::Symbol(const_shared_ptr<double> value) :
-		Symbol(PrimitiveTypeSpecifier::GetDouble(),
-				static_pointer_cast<const void>(value), false) {
+		Symbol(PrimitiveTypeSpecifier::GetDouble(), Value(*value), false) {
 }
 
 Symbol::Symbol(const_shared_ptr<string> value) :
@@ -95,11 +91,17 @@ Symbol::Symbol(const_shared_ptr<TypeSpecifier> type,
 
 Symbol::Symbol(const_shared_ptr<TypeSpecifier> type_specifier,
 		const_shared_ptr<void> value, const bool weakenable) :
+		Symbol(type_specifier, Value(value), weak_ptr<const void>(),
+				weakenable) {
+}
+
+Symbol::Symbol(const_shared_ptr<TypeSpecifier> type_specifier,
+		const Value& value, const bool weakenable) :
 		Symbol(type_specifier, value, weak_ptr<const void>(), weakenable) {
 }
 
 Symbol::Symbol(const_shared_ptr<TypeSpecifier> type_specifier,
-		const_shared_ptr<void> value, weak_ptr<const void> weak_value,
+		const Value& value, weak_ptr<const void> weak_value,
 		const bool weakenable) :
 		m_type_specifier(type_specifier), m_value(value), m_weak_ref(
 				weak_value), m_weakenable(weakenable) {
@@ -107,21 +109,21 @@ Symbol::Symbol(const_shared_ptr<TypeSpecifier> type_specifier,
 	assert(type_specifier != PrimitiveTypeSpecifier::GetNone());
 
 	if (weakenable)
-		assert(value);
+		assert(!value.IsEmpty());
 
 	// value and weak value are mutually exclusive
-	if (value) {
+	if (!value.IsEmpty()) {
 		assert(!weak_value.lock());
 	}
 
 	if (weak_value.lock()) {
-		assert(!value);
+		assert(value.IsEmpty());
 	}
 }
 
 const_shared_ptr<Symbol> Symbol::WithValue(
-		const_shared_ptr<TypeSpecifier> type_specifier,
-		const_shared_ptr<void> value, const TypeTable& type_table) const {
+		const_shared_ptr<TypeSpecifier> type_specifier, const Value& value,
+		const TypeTable& type_table) const {
 	if (type_specifier->AnalyzeAssignmentTo(this->m_type_specifier, type_table)
 			!= EQUIVALENT) {
 		return GetDefaultSymbol();
@@ -133,7 +135,7 @@ const_shared_ptr<Symbol> Symbol::WithValue(
 
 const string Symbol::ToString(const TypeTable& type_table,
 		const Indent& indent) const {
-	return ToString(m_type_specifier, m_value, type_table, indent);
+	return ToString(m_type_specifier, GetValue(), type_table, indent);
 }
 
 const_shared_ptr<Symbol> Symbol::GetDefaultSymbol() {
@@ -179,8 +181,8 @@ const_shared_ptr<Symbol> Symbol::GetNilSymbol() {
 const_shared_ptr<Symbol> Symbol::WeakenReference(
 		const_shared_ptr<Symbol> original) {
 	if (original->m_weakenable) {
-		auto instance = new Symbol(original->m_type_specifier, nullptr,
-				weak_ptr<const void>(original->m_value), false);
+		auto instance = new Symbol(original->m_type_specifier, Value(),
+				weak_ptr<const void>(original->m_value.ToPointer()), false);
 		return const_shared_ptr<Symbol>(instance);
 	} else {
 		return original;
@@ -188,11 +190,21 @@ const_shared_ptr<Symbol> Symbol::WeakenReference(
 }
 
 const_shared_ptr<void> Symbol::GetValue() const {
-	if (m_value) {
-		return m_value;
+	if (!m_value.IsEmpty()) {
+		return m_value.ToPointer();
 	} else {
 		auto lock = m_weak_ref.lock();
 		assert(lock); // fail loudly if we make a reference to a disposed value
 		return lock;
 	}
 }
+
+const Value Symbol::GetTaggedValue() const {
+	if (!m_value.IsEmpty()) {
+		return m_value;
+	} else {
+		auto lock = m_weak_ref.lock();
+		assert(lock); // fail loudly if we make a reference to a disposed value
+		return Value(lock);
+	}
+}
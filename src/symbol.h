@@ -26,6 +26,7 @@
 #include <defaults.h>
 #include <type.h>
 #include <indent.h>
+#include <value.h>
 
 using namespace std;
 
@@ -67,6 +68,11 @@ public:
 
 	const_shared_ptr<void> GetValue() const;
 
+	/**
+	 * Get the symbol's value without boxing it.
+	 */
+	const Value GetTaggedValue() const;
+
 	static const_shared_ptr<Symbol> GetDefaultSymbol();
 
 	static const_shared_ptr<Symbol> GetNilSymbol();
@@ -88,17 +94,18 @@ public:
 protected:
 	Symbol(const_shared_ptr<TypeSpecifier> type_specifier,
 			const_shared_ptr<void> value, const bool m_weakenable);
-	Symbol(const_shared_ptr<TypeSpecifier> type_specifier,
-			const_shared_ptr<void> value, weak_ptr<const void> weak_value,
-			const bool weakenable);
+	Symbol(const_shared_ptr<TypeSpecifier> type_specifier, const Value& value,
+			const bool m_weakenable);
+	Symbol(const_shared_ptr<TypeSpecifier> type_specifier, const Value& value,
+			weak_ptr<const void> weak_value, const bool weakenable);
 
 	virtual const_shared_ptr<Symbol> WithValue(
 			const_shared_ptr<TypeSpecifier> type_specifier,
-			const_shared_ptr<void> value, const TypeTable& type_table) const;
+			const Value& value, const TypeTable& type_table) const;
 
 private:
 	const_shared_ptr<TypeSpecifier> m_type_specifier;
-	const_shared_ptr<void> m_value;
+	const Value m_value;
 	weak_ptr<const void> m_weak_ref;
 	const bool m_weakenable;
 };
@@ -84,7 +84,7 @@ SymbolContext::~SymbolContext() {
 
 const_shared_ptr<Symbol> SymbolContext::GetSymbol(
 		const string& identifier) const {
-	if (identifier == *TypeTable::GetNilName()) {
+	if (SameName(identifier, *TypeTable::GetNilName())) {
 		return Symbol::GetNilSymbol();
 	}
 
@@ -124,82 +124,78 @@ const void SymbolContext::print(ostream &os, const TypeTable& type_table,
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<bool> value, const TypeTable& type_table) {
 	return SetSymbol(identifier, PrimitiveTypeSpecifier::GetBoolean(),
-			static_pointer_cast<const void>(value), type_table);
+			Value(*value), type_table);
 }
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<std::uint8_t> value, const TypeTable& type_table) {
 	return SetSymbol(identifier, PrimitiveTypeSpecifier::GetByte(),
-			static_pointer_cast<const void>(value), type_table);
+			Value(*value), type_table);
 }
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<int> value, const TypeTable& type_table) {
 	return SetSymbol(identifier, PrimitiveTypeSpecifier::GetInt(),
-			static_pointer_cast<const void>(value), type_table);
+			Value(*value), type_table);
 }
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<double> value, const TypeTable& type_table) {
 	return SetSymbol(identifier, PrimitiveTypeSpecifier::GetDouble(),
-			static_pointer_cast<const void>(value), type_table);
+			Value(*value), type_table);
 }
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<string> value, const TypeTable& type_table) {
 	return SetSymbol(identifier, PrimitiveTypeSpecifier::GetString(),
-			static_pointer_cast<const void>(value), type_table);
+			Value(value), type_table);
 }
 
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<ComplexTypeSpecifier> type,
 		const_shared_ptr<Unit> value, const TypeTable& type_table) {
-	return SetSymbol(identifier, type, static_pointer_cast<const void>(value),
-			type_table);
+	return SetSymbol(identifier, type, Value(value), type_table);
 }
 
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<ComplexTypeSpecifier> type,
 		const_shared_ptr<Record> value, const TypeTable& type_table) {
-	return SetSymbol(identifier, type, static_pointer_cast<const void>(value),
-			type_table);
+	return SetSymbol(identifier, type, Value(value), type_table);
 }
 
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<Array> value, const TypeTable& type_table) {
 	return SetSymbol(identifier, value->GetTypeSpecifier(),
-			static_pointer_cast<const void>(value), type_table);
+			Value(value), type_table);
 }
 
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<Function> value, const TypeTable& type_table) {
 	return SetSymbol(identifier, value->GetTypeSpecifier(),
-			static_pointer_cast<const void>(value), type_table);
+			Value(value), type_table);
 }
 
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<ComplexTypeSpecifier> type,
 		const_shared_ptr<Sum> value, const TypeTable& type_table) {
-	return SetSymbol(identifier, type, static_pointer_cast<const void>(value),
-			type_table);
+	return SetSymbol(identifier, type, Value(value), type_table);
 }
 
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<MaybeTypeSpecifier> type, const_shared_ptr<Sum> value,
 		const TypeTable& type_table) {
-	return SetSymbol(identifier, type, static_pointer_cast<const void>(value),
-			type_table);
+	return SetSymbol(identifier, type, Value(value), type_table);
 }
 
 SetResult SymbolContext::SetSymbol(const string& identifier,
 		const_shared_ptr<Symbol> new_value, const TypeTable& type_table) {
 	return SetSymbol(identifier, new_value->GetTypeSpecifier(),
-			new_value->GetValue(), type_table);
+			new_value->GetTaggedValue(), type_table);
 }
 
 SetResult SymbolContext::SetSymbol(const string& identifier,
-		const_shared_ptr<TypeSpecifier> type_specifier,
-		const_shared_ptr<void> value, const TypeTable& type_table) {
-	auto result = m_table->find(identifier);
+		const_shared_ptr<TypeSpecifier> type_specifier, const Value& value,
+		const TypeTable& type_table) {
+	auto slot = m_table->GetSlot(identifier);
 
-	if (result != m_table->end()) {
-		auto existing_symbol = result->second;
+	if (slot != symbol_map::NO_SLOT) {
+		auto existing_symbol = m_table->GetSymbol(slot, identifier);
 		if (existing_symbol->GetTypeSpecifier()->AnalyzeAssignmentTo(
 				type_specifier, type_table) == EQUIVALENT) {
 			if (!(m_modifiers & Modifier::MUTABLE)) {
@@ -208,11 +204,7 @@ SetResult SymbolContext::SetSymbol(const string& identifier,
 				auto new_symbol = existing_symbol->WithValue(type_specifier,
 						value, type_table);
 
-				//TODO: error checking
-				m_table->erase(identifier);
-				m_table->insert(
-						std::pair<const string, const_shared_ptr<Symbol>>(
-								identifier, new_symbol));
+				m_table->SetSymbol(slot, new_symbol);
 
 				return SET_SUCCESS;
 			}
@@ -233,7 +225,7 @@ volatile_shared_ptr<SymbolContext> SymbolContext::GetDefault() {
 volatile_shared_ptr<SymbolContext> SymbolContext::Clone() const {
 	return volatile_shared_ptr<SymbolContext>(
 			new SymbolContext(m_modifiers,
-					make_shared<symbol_map>(m_table->begin(), m_table->end())));
+					make_shared<symbol_map>(*m_table)));
 }
 
 SymbolContext::SymbolContext(const SymbolContext& other) :
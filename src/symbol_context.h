@@ -25,6 +25,7 @@
 #include <map>
 #include <modifier.h>
 #include <symbol.h>
+#include <symbol_map.h>
 
 class Record;
 class Function;
@@ -45,13 +46,7 @@ const ErrorListRef ToErrorListRef(const SetResult result,
 		const_shared_ptr<TypeSpecifier> symbol_type,
 		const_shared_ptr<TypeSpecifier> value_type);
 
-struct comparator {
-	bool operator()(const string& lhs, const string& rhs) const {
-		return lhs < rhs;
-	}
-};
-
-typedef map<const string, plain_shared_ptr<Symbol>, comparator> symbol_map;
+typedef SymbolMap symbol_map;
 
 class SymbolContext {
 public:
@@ -77,6 +72,15 @@ public:
 			const_shared_ptr<string> identifier) const;
 	const_shared_ptr<Symbol> GetSymbol(const string& identifier) const;
 
+	/**
+	 * Get the symbol stored at the given slot, or nullptr if the slot does not
+	 * hold a symbol with the given name.
+	 */
+	const_shared_ptr<Symbol> GetSymbol(const size_t slot,
+			const string& identifier) const {
+		return m_table->GetSymbol(slot, identifier);
+	}
+
 	SetResult SetSymbol(const string& identifier, const_shared_ptr<bool> value,
 			const TypeTable& type_table);
 	SetResult SetSymbol(const string& identifier,
@@ -107,19 +111,20 @@ public:
 	SetResult SetSymbol(const string& identifier,
 			const_shared_ptr<Symbol> value, const TypeTable& type_table);
 
+	virtual SetResult SetSymbol(const string& identifier,
+			const_shared_ptr<TypeSpecifier> type, const Value& value,
+			const TypeTable& type_table);
+
 	static volatile_shared_ptr<SymbolContext> GetDefault();
 
 protected:
-	const shared_ptr<symbol_map> GetTable() const {
+	const shared_ptr<symbol_map>& GetTable() const {
 		return m_table;
 	}
 
 	SymbolContext(const Modifier::Type modifiers,
 			const shared_ptr<symbol_map> values);
 
-	virtual SetResult SetSymbol(const string& identifier,
-			const_shared_ptr<TypeSpecifier> type, const_shared_ptr<void> value,
-			const TypeTable& type_table);
 private:
 	const Modifier::Type m_modifiers;
 	const shared_ptr<symbol_map> m_table;
@@ -0,0 +1,250 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYMBOL_MAP_H_
+#define SYMBOL_MAP_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <assert.h>
+#include <defaults.h>
+#include <symbol.h>
+#include <utils.h>
+
+using namespace std;
+
+/**
+ * A symbol table that stores its entries in a flat vector of slots.
+ *
+ * Slots are assigned in insertion order and never move, so a slot index
+ * computed against one table is also valid for any copy of it. Iteration is
+ * in name order, which keeps debug output stable.
+ *
+ * Copies share the layout until one of them inserts a new name, so copying a
+ * table (e.g. to create a function's execution context) only copies the slots.
+ *
+ * Slots that hold weakenable symbols are tracked as they are written, so that
+ * weakening a table does not have to scan all of it.
+ */
+class SymbolMap {
+public:
+	typedef pair<const string, plain_shared_ptr<Symbol>> value_type;
+	typedef vector<value_type> slot_list;
+	typedef map<string, size_t> index_map;
+
+	static const size_t NO_SLOT = numeric_limits<size_t>::max();
+
+	/**
+	 * The names of a table's slots: an index from name to slot, and the
+	 * interned name held by each slot, so that reads by slot can check the
+	 * name by address.
+	 */
+	class Layout {
+	public:
+		const size_t Add(const string& name) {
+			auto slot = m_names.size();
+			m_index.insert(pair<string, size_t>(name, slot));
+			m_names.push_back(Intern(name).get());
+			return slot;
+		}
+
+		const index_map& GetIndex() const {
+			return m_index;
+		}
+
+		const string* GetName(const size_t slot) const {
+			return m_names[slot];
+		}
+
+		const size_t size() const {
+			return m_names.size();
+		}
+
+	private:
+		index_map m_index;
+		vector<const string*> m_names;
+	};
+
+	SymbolMap() {
+	}
+
+	/**
+	 * Create a table with a precomputed layout. The slots must be given in the
+	 * order the layout assigns them; the layout is shared, not copied.
+	 */
+	SymbolMap(const shared_ptr<Layout> layout, const slot_list& slots) :
+			m_slots(slots), m_layout(layout) {
+		assert(m_layout && m_layout->size() == m_slots.size());
+		for (size_t slot = 0; slot < m_slots.size(); slot++) {
+			Track(slot);
+		}
+	}
+
+	class iterator {
+	public:
+		iterator() :
+				m_slots(nullptr) {
+		}
+
+		iterator(slot_list* slots, const index_map::const_iterator position) :
+				m_slots(slots), m_position(position) {
+		}
+
+		value_type& operator*() const {
+			return (*m_slots)[m_position->second];
+		}
+
+		value_type* operator->() const {
+			return &(*m_slots)[m_position->second];
+		}
+
+		iterator& operator++() {
+			++m_position;
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator result = *this;
+			++m_position;
+			return result;
+		}
+
+		bool operator==(const iterator& other) const {
+			return m_position == other.m_position;
+		}
+
+		bool operator!=(const iterator& other) const {
+			return m_position != other.m_position;
+		}
+
+	private:
+		slot_list* m_slots;
+		index_map::const_iterator m_position;
+	};
+
+	iterator begin() {
+		return iterator(&m_slots, GetIndex().begin());
+	}
+
+	iterator end() {
+		return iterator(&m_slots, GetIndex().end());
+	}
+
+	iterator find(const string& name) {
+		return iterator(&m_slots, GetIndex().find(name));
+	}
+
+	const size_t size() const {
+		return m_slots.size();
+	}
+
+	/**
+	 * Insert a new entry. Invalidates existing iterators.
+	 */
+	pair<iterator, bool> insert(const value_type& value) {
+		auto existing = GetIndex().find(value.first);
+		if (existing != GetIndex().end()) {
+			return pair<iterator, bool>(iterator(&m_slots, existing), false);
+		}
+
+		if (!m_layout) {
+			m_layout = make_shared<Layout>();
+		} else if (m_layout.use_count() > 1) {
+			m_layout = make_shared<Layout>(*m_layout);
+		}
+
+		auto slot = m_layout->Add(value.first);
+		m_slots.push_back(value);
+		Track(slot);
+
+		return pair<iterator, bool>(
+				iterator(&m_slots, GetIndex().find(value.first)), true);
+	}
+
+	const size_t GetSlot(const string& name) const {
+		auto& index = GetIndex();
+		auto result = index.find(name);
+		if (result != index.end()) {
+			return result->second;
+		} else {
+			return NO_SLOT;
+		}
+	}
+
+	/**
+	 * Get the symbol stored at the given slot, or nullptr if the slot does not
+	 * hold a symbol with the given name.
+	 *
+	 * Names from source are interned, so they are matched by address; only
+	 * names synthesized at runtime fall back to comparing contents.
+	 */
+	plain_shared_ptr<Symbol> GetSymbol(const size_t slot,
+			const string& name) const {
+		if (slot < m_slots.size()
+				&& (m_layout->GetName(slot) == &name
+						|| m_slots[slot].first == name)) {
+			return m_slots[slot].second;
+		}
+
+		return nullptr;
+	}
+
+	void SetSymbol(const size_t slot, const_shared_ptr<Symbol> symbol) {
+		m_slots[slot].second = symbol;
+		Track(slot);
+	}
+
+	/**
+	 * Replace every weakenable symbol stored since the last call with its
+	 * weakened form. Only those slots are visited, so this is cheap enough to
+	 * run on every block exit.
+	 */
+	void WeakenReferences() {
+		for (auto slot : m_weakenable) {
+			auto& symbol = m_slots[slot].second;
+			if (symbol->IsWeakenable()) {
+				symbol = Symbol::WeakenReference(symbol);
+			}
+		}
+		m_weakenable.clear();
+	}
+
+private:
+	void Track(const size_t slot) {
+		if (m_slots[slot].second->IsWeakenable()
+				&& std::find(m_weakenable.begin(), m_weakenable.end(), slot)
+						== m_weakenable.end()) {
+			m_weakenable.push_back(slot);
+		}
+	}
+
+	const index_map& GetIndex() const {
+		static const index_map empty;
+		return m_layout ? m_layout->GetIndex() : empty;
+	}
+
+	slot_list m_slots;
+	shared_ptr<Layout> m_layout;
+	vector<size_t> m_weakenable;
+};
+
+#endif /* SYMBOL_MAP_H_ */
@@ -26,6 +26,8 @@
 #include <maybe_type.h>
 #include <memory>
 #include <symbol_context.h>
+#include <utils.h>
+#include <sum.h>
 
 TypeTable::TypeTable(const shared_ptr<TypeTable> parent) :
 		TypeTable(make_shared<type_map>(), parent) {
@@ -174,10 +176,12 @@ const bool TypeTable::ContainsType(const string& name) {
 
 volatile_shared_ptr<SymbolContext> TypeTable::GetDefaultSymbolContext(
 		const Modifier::Type modifiers,
-		const_shared_ptr<ComplexTypeSpecifier> container) const {
-	volatile_shared_ptr<SymbolTable> result = make_shared<SymbolTable>(
-			modifiers);
+		const_shared_ptr<ComplexTypeSpecifier> container,
+		const shared_ptr<SymbolMap::Layout> layout) const {
+	auto slot_layout = layout ? layout : make_shared<SymbolMap::Layout>();
 
+	SymbolMap::slot_list slots;
+	slots.reserve(m_table->size());
 	for (const auto &entry : *m_table) {
 		auto name = entry.first;
 		auto type = entry.second;
@@ -188,11 +192,15 @@ volatile_shared_ptr<SymbolContext> TypeTable::GetDefaultSymbolContext(
 		auto default_symbol = type->GetSymbol(*this, type_specifier,
 				default_value);
 
-		InsertResult insert_result = result->InsertSymbol(name, default_symbol);
-		assert(insert_result == INSERT_SUCCESS);
+		if (!layout) {
+			slot_layout->Add(name);
+		}
+		assert(slot_layout->GetIndex().at(name) == slots.size());
+		slots.push_back(SymbolMap::value_type(name, default_symbol));
 	}
 
-	return result;
+	return make_shared<SymbolTable>(modifiers,
+			make_shared<symbol_map>(slot_layout, slots));
 }
 
 const_shared_ptr<std::set<std::string>> TypeTable::GetTypeNames() const {
@@ -206,9 +214,13 @@ const_shared_ptr<std::set<std::string>> TypeTable::GetTypeNames() const {
 	return result;
 }
 
-const_shared_ptr<std::string> TypeTable::GetNilName() {
-	const static const_shared_ptr<std::string> value = make_shared<string>(
-			"nil");
+const_shared_ptr<std::string>& TypeTable::GetNilName() {
+	const static const_shared_ptr<std::string> value = Intern("nil");
+	return value;
+}
+
+const size_t TypeTable::GetNilTagId() {
+	const static size_t value = Sum::InternTag(*GetNilName());
 	return value;
 }
 
@@ -27,6 +27,7 @@
 #include <complex_type_specifier.h>
 #include <search_type.h>
 #include <modifier.h>
+#include <symbol_map.h>
 
 class TypeDefinition;
 class SymbolContext;
@@ -44,7 +45,7 @@ class Indent;
  */
 class TypeTable {
 public:
-	TypeTable(const shared_ptr<TypeTable> parent = nullptr);
+	explicit TypeTable(const shared_ptr<TypeTable> parent = nullptr);
 	TypeTable(const shared_ptr<type_map> table,
 			const shared_ptr<TypeTable> parent = nullptr);
 
@@ -58,6 +59,14 @@ public:
 	void AddType(const string& name,
 			const_shared_ptr<TypeDefinition> definition);
 
+	/**
+	 * True if no types are declared directly in this table. Types are only
+	 * added while preprocessing, so this does not change at runtime.
+	 */
+	const bool IsEmpty() const {
+		return m_table->empty();
+	}
+
 	template<class T> const shared_ptr<const T> GetType(
 			const_shared_ptr<ComplexTypeSpecifier> type_specifier,
 			const SearchType search_type,
@@ -145,9 +154,15 @@ public:
 		RemoveTypeDefinition<T>(*name);
 	}
 
+	/**
+	 * Build a symbol context holding the default value of every entry. If a
+	 * layout is given, the context shares it rather than building its own
+	 * index; the layout must assign slots in name order.
+	 */
 	volatile_shared_ptr<SymbolContext> GetDefaultSymbolContext(
 			const Modifier::Type modifiers,
-			const_shared_ptr<ComplexTypeSpecifier> container) const;
+			const_shared_ptr<ComplexTypeSpecifier> container,
+			const shared_ptr<SymbolMap::Layout> layout = nullptr) const;
 
 	const bool ContainsType(const ComplexTypeSpecifier& type_specifier);
 
@@ -171,7 +186,8 @@ public:
 
 	const_shared_ptr<std::set<std::string>> GetTypeNames() const;
 
-	static const_shared_ptr<std::string> GetNilName();
+	static const_shared_ptr<std::string>& GetNilName();
+	static const size_t GetNilTagId();
 	static const_shared_ptr<UnitType> GetNilType();
 	static const_shared_ptr<ComplexTypeSpecifier> GetNilTypeSpecifier();
 
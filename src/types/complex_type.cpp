@@ -45,17 +45,17 @@ const_shared_ptr<Result> ComplexType::PreprocessSymbol(
 					initializer);
 		}
 	} else {
-		auto type_result = type_specifier->GetType(type_table);
+		auto type_result = type_specifier->GetType(*type_table);
 		errors = type_result->GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
 			auto type = type_result->GetData<TypeDefinition>();
-			value = type->GetDefaultValue(type_table);
+			value = type->GetDefaultValue(*type_table);
 		}
 	}
 
 	if (ErrorList::IsTerminator(errors)) {
 		//we've been able to get a good initial value (that is, no errors have occurred)
-		symbol = GetSymbol(type_table, type_specifier, value);
+		symbol = GetSymbol(*type_table, type_specifier, value);
 	}
 
 	return make_shared<Result>(symbol, errors);
@@ -99,7 +99,7 @@ const_shared_ptr<StatementBlock> FunctionType::GetDefaultStatementBlock(
 	const_shared_ptr<ConstantExpression> return_expression =
 			ConstantExpression::GetDefaultExpression(return_type, type_table);
 	const_shared_ptr<ReturnStatement> default_return_statement = make_shared<
-			ReturnStatement>(return_expression);
+			ReturnStatement>(GetDefaultLocation(), return_expression);
 	const StatementListRef default_list = StatementList::From(
 			default_return_statement, StatementList::GetTerminator());
 
@@ -24,12 +24,16 @@
 #include <sum.h>
 #include <maybe_declaration_statement.h>
 #include <type_alias_declaration_statement.h>
+#include <utils.h>
 
 MaybeType::MaybeType(const_shared_ptr<TypeTable> type_table,
 		const_shared_ptr<string> first_variant_name,
 		const_shared_ptr<SymbolTable> constructors,
 		const_shared_ptr<TypeSpecifier> base_type_specifier) :
-		SumType(type_table, first_variant_name, constructors, nullptr), m_base_type_specifier(
+		SumType(type_table, first_variant_name, constructors, nullptr, {
+				{ *TypeTable::GetNilName(), TypeTable::GetNilTagId() }, {
+						*MaybeTypeSpecifier::VARIANT_NAME,
+						MaybeTypeSpecifier::VARIANT_TAG_ID } }), m_base_type_specifier(
 				base_type_specifier) {
 }
 
@@ -39,7 +43,8 @@ MaybeType::~MaybeType() {
 const_shared_ptr<void> MaybeType::GetDefaultValue(
 		const TypeTable& type_table) const {
 	auto value = TypeTable::GetNilType()->GetDefaultValue(type_table);
-	return make_shared<Sum>(TypeTable::GetNilName(), value);
+	return make_shared<Sum>(TypeTable::GetNilName(), TypeTable::GetNilTagId(),
+			value);
 }
 
 const std::string MaybeType::ValueToString(const TypeTable& type_table,
@@ -48,8 +53,8 @@ const std::string MaybeType::ValueToString(const TypeTable& type_table,
 	auto sum_instance = static_pointer_cast<const Sum>(value);
 	auto tag = sum_instance->GetTag();
 	buffer << "{" << *tag << "}";
-	if (*tag == *TypeTable::GetNilName()) {
-	} else if (*tag == *MaybeTypeSpecifier::VARIANT_NAME) {
+	if (SameName(*tag, *TypeTable::GetNilName())) {
+	} else if (SameName(*tag, *MaybeTypeSpecifier::VARIANT_NAME)) {
 		auto type_result = m_base_type_specifier->GetType(type_table, RESOLVE);
 		if (ErrorList::IsTerminator(type_result->GetErrors())) {
 			auto type = type_result->GetData<TypeDefinition>();
@@ -71,9 +76,9 @@ const std::string MaybeType::GetValueSeparator(const Indent& indent,
 	auto sum_instance = static_cast<const Sum*>(value);
 
 	auto tag = sum_instance->GetTag();
-	if (*tag == *MaybeTypeSpecifier::VARIANT_NAME) {
+	if (SameName(*tag, *MaybeTypeSpecifier::VARIANT_NAME)) {
 		buffer << "\n" << indent + 1;
-	} else if (*tag == *TypeTable::GetNilName()) {
+	} else if (SameName(*tag, *TypeTable::GetNilName())) {
 		buffer << " ";
 	}
 	return buffer.str();
@@ -40,7 +40,12 @@
 RecordType::RecordType(const_shared_ptr<TypeTable> definition,
 		const Modifier::Type modifiers, const_shared_ptr<MaybeType> maybe_type) :
 		m_definition(definition), m_modifiers(modifiers), m_maybe_type(
-				maybe_type) {
+				maybe_type), m_layout(make_shared<SymbolMap::Layout>()) {
+	// lay members out in name order, which is how default instances visit them
+	auto names = m_definition->GetTypeNames();
+	for (auto& name : *names) {
+		m_layout->Add(name);
+	}
 }
 
 const_shared_ptr<TypeDefinition> RecordType::GetMember(
@@ -48,6 +53,16 @@ const_shared_ptr<TypeDefinition> RecordType::GetMember(
 	return m_definition->GetType<TypeDefinition>(name, SHALLOW, RETURN);
 }
 
+const size_t RecordType::GetSlot(const std::string& name) const {
+	auto& index = m_layout->GetIndex();
+	auto result = index.find(name);
+	if (result != index.end()) {
+		return result->second;
+	}
+
+	return SymbolMap::NO_SLOT;
+}
+
 RecordType::~RecordType() {
 }
 
@@ -112,7 +127,7 @@ const ErrorListRef RecordType::Build(const_shared_ptr<string> name,
 			auto declaration_type_specifier = declaration->GetTypeSpecifier();
 			auto declaration_errors =
 					declaration_type_specifier->ValidateDeclaration(
-							output_type_table, declaration->GetNameLocation());
+							*output_type_table, declaration->GetNameLocation());
 
 			auto existing_member_type = type_table->GetType<TypeDefinition>(
 					member_name, SHALLOW, RETURN);
@@ -166,7 +181,7 @@ const ErrorListRef RecordType::Build(const_shared_ptr<string> name,
 								auto bare_statement_block =
 										FunctionType::GetDefaultStatementBlock(
 												variant_definition->GetDeclaration()->GetReturnTypeSpecifier(),
-												output_type_table);
+												*output_type_table);
 								auto bare_variant =
 										make_shared<FunctionVariant>(
 												variant_definition->GetLocation(),
@@ -219,7 +234,7 @@ const ErrorListRef RecordType::Build(const_shared_ptr<string> name,
 								symbol->GetTypeSpecifier();
 
 						auto symbol_type_result = type_specifier->GetType(
-								output_type_table);
+								*output_type_table);
 						auto symbol_type_errors =
 								symbol_type_result->GetErrors();
 						if (ErrorList::IsTerminator(symbol_type_errors)) {
@@ -291,7 +306,7 @@ const ErrorListRef RecordType::Build(const_shared_ptr<string> name,
 						split_declaration_subject_data->GetTypeSpecifier();
 				auto declaration_errors =
 						declaration_type_specifier->ValidateDeclaration(
-								output_type_table,
+								*output_type_table,
 								split_declaration_subject_data->GetNameLocation());
 
 				const shared_ptr<symbol_map> values = make_shared<symbol_map>();
@@ -405,7 +420,7 @@ const_shared_ptr<Result> RecordType::PreprocessSymbolCore(
 				initializer_expression_type_result.GetData();
 		auto initializer_analysis =
 				initializer_expression_type->AnalyzeAssignmentTo(type_specifier,
-						execution_context->GetTypeTable());
+						*execution_context->GetTypeTable());
 		if (initializer_analysis == EQUIVALENT) {
 			if (initializer->IsConstant()) {
 				const_shared_ptr<Result> result = initializer->Evaluate(
@@ -449,9 +464,9 @@ const SetResult RecordType::InstantiateCore(
 	auto instance = static_pointer_cast<const Record>(data);
 
 	if (value_type_specifier->AnalyzeAssignmentTo(type_specifier,
-			execution_context->GetTypeTable())) {
+			*execution_context->GetTypeTable())) {
 		auto set_result = execution_context->SetSymbol(instance_name,
-				type_specifier, instance, execution_context->GetTypeTable());
+				type_specifier, instance, *execution_context->GetTypeTable());
 		return set_result;
 	} else {
 		return SetResult::INCOMPATIBLE_TYPE;
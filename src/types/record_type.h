@@ -44,6 +44,16 @@ public:
 
 	const_shared_ptr<TypeDefinition> GetMember(const std::string& name) const;
 
+	/**
+	 * The slot that holds the named member in instances of this type, or
+	 * SymbolMap::NO_SLOT if there is no such member.
+	 */
+	const size_t GetSlot(const std::string& name) const;
+
+	const shared_ptr<SymbolMap::Layout> GetLayout() const {
+		return m_layout;
+	}
+
 	virtual const_shared_ptr<void> GetMemberDefaultValue(
 			const_shared_ptr<std::string> member_name) const;
 
@@ -118,6 +128,7 @@ private:
 	const_shared_ptr<TypeTable> m_definition;
 	const Modifier::Type m_modifiers;
 	const_shared_ptr<MaybeType> m_maybe_type;
+	const shared_ptr<SymbolMap::Layout> m_layout;
 };
 
 #endif /* COMPOUND_TYPE_H_ */
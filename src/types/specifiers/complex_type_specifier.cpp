@@ -24,6 +24,7 @@
 #include <unit_type.h>
 #include <stack>
 #include <placeholder_type.h>
+#include <utils.h>
 
 const_shared_ptr<ComplexTypeSpecifier> ComplexTypeSpecifier::Build(
 		const_shared_ptr<ComplexTypeSpecifier> parent,
@@ -160,15 +161,7 @@ const AnalysisResult ComplexTypeSpecifier::AnalyzeAssignmentTo(
 						resolved_other);
 		if (as_complex) {
 			try {
-				auto container = GetContainer();
-				auto other_container = as_complex->GetContainer();
-				if (container && other_container
-						&& *container == *other_container
-						&& as_complex->GetTypeName()->compare(*GetTypeName())
-								== 0) {
-					return AnalysisResult::EQUIVALENT;
-				} else if (as_complex->GetTypeName()->compare(*GetTypeName())
-						== 0) {
+				if (SameName(*as_complex->GetTypeName(), *GetTypeName())) {
 					return AnalysisResult::EQUIVALENT;
 				}
 
@@ -192,7 +185,7 @@ bool ComplexTypeSpecifier::operator ==(const TypeSpecifier& other) const {
 		const ComplexTypeSpecifier& as_complex =
 				dynamic_cast<const ComplexTypeSpecifier&>(other);
 		return CompareContainers(as_complex)
-				&& *GetTypeName() == *as_complex.GetTypeName();
+				&& SameName(*GetTypeName(), *as_complex.GetTypeName());
 	} catch (std::bad_cast& e) {
 		return false;
 	}
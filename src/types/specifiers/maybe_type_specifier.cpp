@@ -24,9 +24,12 @@
 #include <unit_type.h>
 #include <placeholder_type.h>
 #include <sum.h>
+#include <utils.h>
 
-const_shared_ptr<std::string> MaybeTypeSpecifier::VARIANT_NAME = make_shared<
-		std::string>("value");
+const_shared_ptr<std::string> MaybeTypeSpecifier::VARIANT_NAME = Intern(
+		"value");
+const size_t MaybeTypeSpecifier::VARIANT_TAG_ID = Sum::InternTag(
+		*VARIANT_NAME);
 
 MaybeTypeSpecifier::MaybeTypeSpecifier(
 		const_shared_ptr<TypeSpecifier> base_type_specifier,
@@ -100,7 +103,7 @@ const AnalysisResult MaybeTypeSpecifier::AnalyzeWidening(
 
 const_shared_ptr<void> MaybeTypeSpecifier::DefaultValue(
 		const TypeTable& type_table) const {
-	return make_shared<Sum>(TypeTable::GetNilName(),
+	return make_shared<Sum>(TypeTable::GetNilName(), TypeTable::GetNilTagId(),
 			TypeTable::GetNilType()->GetDefaultValue(type_table));
 }
 
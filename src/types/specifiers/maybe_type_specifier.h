@@ -54,6 +54,7 @@ public:
 			const TypeTable& type_table) const;
 
 	static const_shared_ptr<std::string> VARIANT_NAME;
+	static const size_t VARIANT_TAG_ID;
 
 private:
 	const_shared_ptr<TypeSpecifier> m_base_type_specifier;
@@ -18,6 +18,7 @@
  */
 
 #include <alias_definition.h>
+#include <array_type_specifier.h>
 #include <expression.h>
 #include <linked_list.h>
 #include <location.hh>
@@ -90,6 +91,7 @@ const_shared_ptr<Result> SumType::Build(
 			definition, TEMPORARY, output->GetDepth() + 1);
 
 	auto constructors = make_shared<ExecutionContext>(Modifier::Type::MUTABLE);
+	tag_id_map tag_ids;
 
 	DeclarationListRef subject = member_declarations;
 	while (!DeclarationList::IsTerminator(subject)) {
@@ -109,6 +111,7 @@ const_shared_ptr<Result> SumType::Build(
 		if (ErrorList::IsTerminator(errors)) {
 			auto declaration = subject->GetData();
 			auto variant_name = declaration->GetName();
+			tag_ids[*variant_name] = Sum::InternTag(*variant_name);
 
 			auto as_unit = dynamic_pointer_cast<const UnitDeclarationStatement>(
 					declaration);
@@ -183,7 +186,7 @@ const_shared_ptr<Result> SumType::Build(
 							const ComplexTypeSpecifier>(alias_type_specifier);
 					if (original_as_complex) {
 						auto original_name_result =
-								original_as_complex->GetType(closure_type_table,
+								original_as_complex->GetType(*closure_type_table,
 										RETURN);
 						auto original_name_result_errors =
 								original_name_result->GetErrors();
@@ -198,6 +201,14 @@ const_shared_ptr<Result> SumType::Build(
 									original_name_result_errors);
 						}
 					}
+
+					auto original_as_array = dynamic_pointer_cast<
+							const ArrayTypeSpecifier>(alias_type_specifier);
+					if (original_as_array) {
+						auto alias = make_shared<AliasDefinition>(
+								closure_type_table, original_as_array, DIRECT);
+						definition->AddType(alias_type_name, alias);
+					}
 				} else {
 					errors = ErrorList::From(
 							make_shared<Error>(Error::SEMANTIC,
@@ -219,7 +230,7 @@ const_shared_ptr<Result> SumType::Build(
 			auto type = const_shared_ptr<SumType>(
 					new SumType(definition,
 							member_declarations->GetData()->GetName(),
-							constructors, maybe_type));
+							constructors, maybe_type, tag_ids));
 			return make_shared<Result>(type, errors);
 		}
 	}
@@ -291,7 +302,7 @@ const_shared_ptr<Result> SumType::PreprocessSymbolCore(
 		const_shared_ptr<Expression> initializer) const {
 	auto type_table = execution_context->GetTypeTable();
 	plain_shared_ptr<const Sum> instance = static_pointer_cast<const Sum>(
-			GetDefaultValue(type_table));
+			GetDefaultValue(*type_table));
 	plain_shared_ptr<Symbol> symbol = Symbol::GetDefaultSymbol();
 
 	auto initializer_expression_type_specifier_result =
@@ -303,11 +314,11 @@ const_shared_ptr<Result> SumType::PreprocessSymbolCore(
 				initializer_expression_type_specifier_result.GetData();
 		auto conversion_analysis =
 				initializer_expression_type_specifier->AnalyzeAssignmentTo(
-						type_specifier, execution_context->GetTypeTable());
+						type_specifier, *execution_context->GetTypeTable());
 		if (conversion_analysis == EQUIVALENT) {
 			auto expression_type_result =
 					initializer_expression_type_specifier->GetType(
-							execution_context->GetTypeTable(), RESOLVE);
+							*execution_context->GetTypeTable(), RESOLVE);
 
 			errors = expression_type_result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
@@ -336,7 +347,7 @@ const_shared_ptr<Result> SumType::PreprocessSymbolCore(
 					auto variant_name = MapSpecifierToVariant(*type_specifier,
 							*initializer_expression_type_specifier);
 					instance = make_shared<Sum>(variant_name,
-							result->GetRawData());
+							GetTagId(*variant_name), result->GetRawData());
 				}
 			}
 		} else if (conversion_analysis == AMBIGUOUS) {
@@ -427,7 +438,7 @@ const SetResult SumType::InstantiateCore(
 		const_shared_ptr<TypeSpecifier> value_type_specifier,
 		const std::string& instance_name, const_shared_ptr<void> data) const {
 	auto value_type_result = value_type_specifier->GetType(
-			execution_context->GetTypeTable(), RESOLVE);
+			*execution_context->GetTypeTable(), RESOLVE);
 
 	plain_shared_ptr<Sum> instance = nullptr;
 	auto errors = value_type_result->GetErrors();
@@ -443,14 +454,14 @@ const SetResult SumType::InstantiateCore(
 			if (conversion_result == UNAMBIGUOUS) {
 				auto tag = MapSpecifierToVariant(*type_specifier,
 						*value_type_specifier);
-				instance = make_shared<const Sum>(tag, data);
+				instance = make_shared<const Sum>(tag, GetTagId(*tag), data);
 			} else {
 				return INCOMPATIBLE_TYPE;
 			}
 		}
 
 		auto set_result = execution_context->SetSymbol(instance_name,
-				type_specifier, instance, execution_context->GetTypeTable());
+				type_specifier, instance, *execution_context->GetTypeTable());
 		return set_result;
 	} else {
 		return INCOMPATIBLE_TYPE;
@@ -34,12 +34,15 @@ class SumTypeSpecifier;
 
 class SumType: public ComplexType {
 public:
+	typedef std::map<std::string, size_t> tag_id_map;
+
 	SumType(const_shared_ptr<TypeTable> type_table,
 			const_shared_ptr<string> first_variant_name,
 			const_shared_ptr<SymbolTable> constructors,
-			const_shared_ptr<MaybeType> maybe_type) :
+			const_shared_ptr<MaybeType> maybe_type, const tag_id_map& tag_ids) :
 			m_definition(type_table), m_first_variant_name(first_variant_name), m_constructors(
-					constructors), m_maybe_type(maybe_type) {
+					constructors), m_maybe_type(maybe_type), m_tag_ids(
+					tag_ids), m_first_variant_tag_id(m_tag_ids.at(*first_variant_name)) {
 	}
 
 	virtual ~SumType() {
@@ -84,6 +87,17 @@ public:
 		return m_first_variant_name;
 	}
 
+	const size_t GetFirstVariantTagId() const {
+		return m_first_variant_tag_id;
+	}
+
+	/**
+	 * The tag id of the named variant, assigned when this type was built.
+	 */
+	const size_t GetTagId(const std::string& variant_name) const {
+		return m_tag_ids.at(variant_name);
+	}
+
 	const_shared_ptr<SymbolTable> GetConstructors() const {
 		return m_constructors;
 	}
@@ -126,6 +140,8 @@ private:
 	const_shared_ptr<string> m_first_variant_name;
 	const_shared_ptr<SymbolTable> m_constructors;
 	const_shared_ptr<MaybeType> m_maybe_type;
+	const tag_id_map m_tag_ids;
+	const size_t m_first_variant_tag_id;
 };
 
 #endif /* SUM_TYPE_H_ */
@@ -117,7 +117,7 @@ const_shared_ptr<Result> UnitType::PreprocessSymbolCore(
 				initializer_expression_type_result.GetData();
 		auto initializer_analysis =
 				initializer_expression_type->AnalyzeAssignmentTo(type_specifier,
-						execution_context->GetTypeTable());
+						*execution_context->GetTypeTable());
 		if (initializer_analysis == EQUIVALENT) {
 			instance = m_value;
 		} else {
@@ -145,9 +145,9 @@ const SetResult UnitType::InstantiateCore(
 	auto instance = static_pointer_cast<const Unit>(data);
 
 	if (value_type_specifier->AnalyzeAssignmentTo(type_specifier,
-			execution_context->GetTypeTable())) {
+			*execution_context->GetTypeTable())) {
 		auto set_result = execution_context->SetSymbol(instance_name,
-				type_specifier, instance, execution_context->GetTypeTable());
+				type_specifier, instance, *execution_context->GetTypeTable());
 		return set_result;
 	} else {
 		return SetResult::INCOMPATIBLE_TYPE;
@@ -20,6 +20,8 @@
 #include "utils.h"
 #include <sstream>
 #include <iomanip>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 
@@ -103,3 +105,18 @@ const_shared_ptr<string_list> Unique(const_shared_ptr<string_list> list) {
 
 	return out;
 }
+
+const_shared_ptr<string> Intern(const string& value) {
+	static std::mutex mutex;
+	static std::unordered_map<string, plain_shared_ptr<string>> strings;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto existing = strings.find(value);
+	if (existing != strings.end()) {
+		return existing->second;
+	}
+
+	auto result = make_shared<const string>(value);
+	strings.insert(make_pair(value, result));
+	return result;
+}
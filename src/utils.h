@@ -48,4 +48,20 @@ const_shared_ptr<string_list> Tokenize(const string& str,
  * Get unique strings without changing the order of the list
  */
 const_shared_ptr<string_list> Unique(const_shared_ptr<string_list> list);
+
+/**
+ * Get the process-wide instance of the given string. Interning the same
+ * contents twice yields the same object, so interned names can be compared
+ * by address. Interned strings are never released; this is meant for
+ * identifiers and type names, not for runtime data.
+ */
+const_shared_ptr<string> Intern(const string& value);
+
+/**
+ * Compare two names, skipping the comparison of their contents if they are
+ * the same (e.g. interned) object.
+ */
+inline const bool SameName(const string& a, const string& b) {
+	return &a == &b || a == b;
+}
 #endif /* UTILS_H_ */
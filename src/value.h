@@ -0,0 +1,265 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VALUE_H_
+#define VALUE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <assert.h>
+#include <defaults.h>
+#include <type.h>
+
+/**
+ * A runtime value. Booleans, bytes, ints and doubles are stored inline;
+ * everything else (strings, arrays, records, sums, functions) is held by
+ * reference.
+ *
+ * A primitive may also arrive by reference from code that still deals in
+ * shared_ptr<const void>; As<T>() reads either representation, and
+ * ToPointer() boxes inline values for such code.
+ */
+class Value {
+public:
+	Value() :
+			m_storage(EMPTY), m_payload() {
+	}
+
+	explicit Value(const bool value) :
+			m_storage(INLINE_BOOLEAN), m_payload() {
+		m_bool = value;
+	}
+
+	explicit Value(const std::uint8_t value) :
+			m_storage(INLINE_BYTE), m_payload() {
+		m_byte = value;
+	}
+
+	explicit Value(const int value) :
+			m_storage(INLINE_INT), m_payload() {
+		m_int = value;
+	}
+
+	explicit Value(const double value) :
+			m_storage(INLINE_DOUBLE), m_payload() {
+		m_double = value;
+	}
+
+	explicit Value(const_shared_ptr<void> value) :
+			m_storage(value ? POINTER : EMPTY), m_payload() {
+		if (value) {
+			new (&m_pointer) pointer_type(value);
+		}
+	}
+
+	Value(const Value& other) :
+			m_storage(other.m_storage) {
+		Copy(other);
+	}
+
+	// moves steal the pointer without touching its reference count, so
+	// growing a vector of values costs no atomic operations
+	Value(Value&& other) noexcept :
+			m_storage(other.m_storage) {
+		Move(other);
+	}
+
+	~Value() {
+		Release();
+	}
+
+	Value& operator=(const Value& other) {
+		if (this != &other) {
+			Release();
+			m_storage = other.m_storage;
+			Copy(other);
+		}
+		return *this;
+	}
+
+	Value& operator=(Value&& other) noexcept {
+		if (this != &other) {
+			Release();
+			m_storage = other.m_storage;
+			Move(other);
+		}
+		return *this;
+	}
+
+	const bool operator==(const Value& other) const {
+		if (m_storage != other.m_storage) {
+			return false;
+		}
+
+		switch (m_storage) {
+		case INLINE_BOOLEAN:
+			return m_bool == other.m_bool;
+		case INLINE_BYTE:
+			return m_byte == other.m_byte;
+		case INLINE_INT:
+			return m_int == other.m_int;
+		case INLINE_DOUBLE:
+			return m_double == other.m_double;
+		case POINTER:
+			return m_pointer == other.m_pointer;
+		case EMPTY:
+		default:
+			return true;
+		}
+	}
+
+	const bool operator!=(const Value& other) const {
+		return !(*this == other);
+	}
+
+	const bool IsEmpty() const {
+		return m_storage == EMPTY;
+	}
+
+	/**
+	 * Read the value as the given type. The caller is responsible for knowing
+	 * the static type of the value.
+	 *
+	 * Inline storage is zero-filled, so reading a primitive as a different
+	 * primitive (e.g. an int-valued boolean assignment) reads the low-order
+	 * bytes, just as dereferencing a pointer to the original would have.
+	 */
+	template<class T> const T& As() const {
+		assert(m_storage == POINTER);
+		return *static_cast<const T*>(m_pointer.get());
+	}
+
+	/**
+	 * Get the value as a reference-counted pointer, boxing inline values.
+	 */
+	const_shared_ptr<void> ToPointer() const {
+		switch (m_storage) {
+		case INLINE_BOOLEAN:
+			return make_shared<bool>(m_bool);
+		case INLINE_BYTE:
+			return make_shared<std::uint8_t>(m_byte);
+		case INLINE_INT:
+			return make_shared<int>(m_int);
+		case INLINE_DOUBLE:
+			return make_shared<double>(m_double);
+		case POINTER:
+			return m_pointer;
+		case EMPTY:
+		default:
+			return nullptr;
+		}
+	}
+
+	/**
+	 * Build a value from a pointer whose static type is known, storing
+	 * primitives inline.
+	 */
+	static const Value FromPointer(const_shared_ptr<void> value,
+			const BasicType type) {
+		if (!value) {
+			return Value();
+		}
+
+		switch (type) {
+		case BOOLEAN:
+			return Value(*static_pointer_cast<const bool>(value));
+		case BYTE:
+			return Value(*static_pointer_cast<const std::uint8_t>(value));
+		case INT:
+			return Value(*static_pointer_cast<const int>(value));
+		case DOUBLE:
+			return Value(*static_pointer_cast<const double>(value));
+		default:
+			return Value(value);
+		}
+	}
+
+private:
+	enum Storage {
+		EMPTY,
+		INLINE_BOOLEAN,
+		INLINE_BYTE,
+		INLINE_INT,
+		INLINE_DOUBLE,
+		POINTER
+	};
+
+	// the whole payload is copied for inline values, so every byte of it is
+	// initialized whatever the storage
+	void Copy(const Value& other) {
+		if (m_storage == POINTER) {
+			new (&m_pointer) pointer_type(other.m_pointer);
+		} else {
+			std::memcpy(m_payload, other.m_payload, sizeof(m_payload));
+		}
+	}
+
+	// leaves the other value empty
+	void Move(Value& other) {
+		if (m_storage == POINTER) {
+			new (&m_pointer) pointer_type(std::move(other.m_pointer));
+			other.m_pointer.~pointer_type();
+		} else {
+			std::memcpy(m_payload, other.m_payload, sizeof(m_payload));
+		}
+		other.m_storage = EMPTY;
+		std::memset(other.m_payload, 0, sizeof(other.m_payload));
+	}
+
+	void Release() {
+		if (m_storage == POINTER) {
+			m_pointer.~pointer_type();
+		}
+	}
+
+	typedef plain_shared_ptr<void> pointer_type;
+
+	Storage m_storage;
+	union {
+		bool m_bool;
+		std::uint8_t m_byte;
+		int m_int;
+		double m_double;
+		plain_shared_ptr<void> m_pointer;
+		unsigned char m_payload[sizeof(pointer_type)];
+	};
+};
+
+template<> inline const bool& Value::As<bool>() const {
+	return m_storage == POINTER ?
+			*static_cast<const bool*>(m_pointer.get()) : m_bool;
+}
+
+template<> inline const std::uint8_t& Value::As<std::uint8_t>() const {
+	return m_storage == POINTER ?
+			*static_cast<const std::uint8_t*>(m_pointer.get()) : m_byte;
+}
+
+template<> inline const int& Value::As<int>() const {
+	return m_storage == POINTER ?
+			*static_cast<const int*>(m_pointer.get()) : m_int;
+}
+
+template<> inline const double& Value::As<double>() const {
+	return m_storage == POINTER ?
+			*static_cast<const double*>(m_pointer.get()) : m_double;
+}
+
+#endif /* VALUE_H_ */
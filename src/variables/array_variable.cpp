@@ -76,7 +76,7 @@ const_shared_ptr<string> ArrayVariable::ToString(
 
 	auto errors = evaluation->GetErrors();
 	if (ErrorList::IsTerminator(errors)) {
-		buffer << *(evaluation->GetData<int>());
+		buffer << evaluation->GetTaggedValue().As<int>();
 	} else {
 		buffer << "EVALUATION ERROR";
 	}
@@ -103,7 +103,7 @@ const_shared_ptr<ArrayVariable::ValidationResult> ArrayVariable::ValidateOperati
 		if (ErrorList::IsTerminator(errors)) {
 			auto base_type_specifier = base_type_specifier_result.GetData();
 			auto base_type_result = base_type_specifier->GetType(
-					context->GetTypeTable());
+					*context->GetTypeTable());
 
 			errors = base_type_result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
@@ -123,7 +123,7 @@ const_shared_ptr<ArrayVariable::ValidationResult> ArrayVariable::ValidateOperati
 						auto index_analysis =
 								index_expression_type->AnalyzeAssignmentTo(
 										PrimitiveTypeSpecifier::GetInt(),
-										context->GetTypeTable());
+										*context->GetTypeTable());
 						auto expression_location = m_expression->GetLocation();
 						if (index_analysis == EQUIVALENT
 								|| index_analysis == UNAMBIGUOUS) {
@@ -199,23 +199,23 @@ const_shared_ptr<Result> ArrayVariable::Evaluate(
 					array->GetElementTypeSpecifier();
 			if (element_type_specifier->AnalyzeAssignmentTo(
 					PrimitiveTypeSpecifier::GetBoolean(),
-					context->GetTypeTable()) == EQUIVALENT) {
+					*context->GetTypeTable()) == EQUIVALENT) {
 				result_value = array->GetValue<bool>(index, *type_table);
 			} else if (element_type_specifier->AnalyzeAssignmentTo(
-					PrimitiveTypeSpecifier::GetInt(), context->GetTypeTable())
+					PrimitiveTypeSpecifier::GetInt(), *context->GetTypeTable())
 					== EQUIVALENT) {
 				result_value = array->GetValue<int>(index, *type_table);
 			} else if (element_type_specifier->AnalyzeAssignmentTo(
 					PrimitiveTypeSpecifier::GetDouble(),
-					context->GetTypeTable()) == EQUIVALENT) {
+					*context->GetTypeTable()) == EQUIVALENT) {
 				result_value = array->GetValue<double>(index, *type_table);
 			} else if (element_type_specifier->AnalyzeAssignmentTo(
 					PrimitiveTypeSpecifier::GetString(),
-					context->GetTypeTable()) == EQUIVALENT) {
+					*context->GetTypeTable()) == EQUIVALENT) {
 				result_value = array->GetValue<string>(index, *type_table);
 			} else {
 				auto element_type_result = element_type_specifier->GetType(
-						context->GetTypeTable(), RESOLVE);
+						*context->GetTypeTable(), RESOLVE);
 
 				errors = element_type_result->GetErrors();
 				if (ErrorList::IsTerminator(errors)) {
@@ -297,12 +297,30 @@ const ErrorListRef ArrayVariable::AssignValue(
 
 					errors = result->GetErrors();
 					if (ErrorList::IsTerminator(errors)) {
+						//boolean operations are computed as ints
 						errors = SetSymbolCore(context,
-								result->GetData<bool>());
+								make_shared<bool>(
+										result->GetTaggedValue().As<int>()
+												!= 0));
 						break;
 					}
 					break;
 				}
+				case BYTE: {
+					const_shared_ptr<std::uint8_t> value = array->GetValue<
+							std::uint8_t>(index, *type_table);
+					const_shared_ptr<Result> result =
+							AssignmentStatement::do_op(variable_name,
+									element_type, GetLocation().begin, *value,
+									expression, op, context);
+
+					errors = result->GetErrors();
+					if (ErrorList::IsTerminator(errors)) {
+						errors = SetSymbolCore(context,
+								result->GetTaggedValue().ToPointer());
+					}
+					break;
+				}
 				case INT: {
 					const_shared_ptr<int> value = array->GetValue<int>(index,
 							*type_table);
@@ -359,7 +377,7 @@ const ErrorListRef ArrayVariable::AssignValue(
 					if (ErrorList::IsTerminator(errors)) {
 						auto element_type_result =
 								element_type_specifier->GetType(
-										context->GetTypeTable(), RESOLVE);
+										*context->GetTypeTable(), RESOLVE);
 
 						errors = element_type_result->GetErrors();
 						if (ErrorList::IsTerminator(errors)) {
@@ -464,7 +482,7 @@ const_shared_ptr<TypeSpecifier> ArrayVariable::GetElementType(
 	if (ErrorList::IsTerminator(errors)) {
 		auto base_type_specifier = base_type_specifier_result.GetData();
 		auto base_type_result = base_type_specifier->GetType(
-				context->GetTypeTable());
+				*context->GetTypeTable());
 
 		auto errors = base_type_result->GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
@@ -499,24 +517,24 @@ const ErrorListRef ArrayVariable::SetSymbolCore(
 
 		if (element_type_specifier->AnalyzeAssignmentTo(
 				PrimitiveTypeSpecifier::GetBoolean(),
-				context->GetTypeTable())) {
+				*context->GetTypeTable())) {
 			new_array = array->WithValue<bool>(index,
 					static_pointer_cast<const bool>(value), *type_table);
 		} else if (element_type_specifier->AnalyzeAssignmentTo(
-				PrimitiveTypeSpecifier::GetInt(), context->GetTypeTable())) {
+				PrimitiveTypeSpecifier::GetInt(), *context->GetTypeTable())) {
 			new_array = array->WithValue<int>(index,
 					static_pointer_cast<const int>(value), *type_table);
 		} else if (element_type_specifier->AnalyzeAssignmentTo(
-				PrimitiveTypeSpecifier::GetDouble(), context->GetTypeTable())) {
+				PrimitiveTypeSpecifier::GetDouble(), *context->GetTypeTable())) {
 			new_array = array->WithValue<double>(index,
 					static_pointer_cast<const double>(value), *type_table);
 		} else if (element_type_specifier->AnalyzeAssignmentTo(
-				PrimitiveTypeSpecifier::GetString(), context->GetTypeTable())) {
+				PrimitiveTypeSpecifier::GetString(), *context->GetTypeTable())) {
 			new_array = array->WithValue<string>(index,
 					static_pointer_cast<const string>(value), *type_table);
 		} else {
 			auto element_type_result = element_type_specifier->GetType(
-					context->GetTypeTable(), RESOLVE);
+					*context->GetTypeTable(), RESOLVE);
 
 			errors = element_type_result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
@@ -563,7 +581,7 @@ const ErrorListRef ArrayVariable::Validate(
 		if (ErrorList::IsTerminator(errors)) {
 			auto index_expression_type = index_expression_type_result.GetData();
 			auto index_analysis = index_expression_type->AnalyzeAssignmentTo(
-					PrimitiveTypeSpecifier::GetInt(), context->GetTypeTable());
+					PrimitiveTypeSpecifier::GetInt(), *context->GetTypeTable());
 			if (index_analysis == EQUIVALENT || index_analysis == UNAMBIGUOUS) {
 				auto base_type_specifier_result =
 						m_base_variable->GetTypeSpecifier(context);
@@ -573,7 +591,7 @@ const ErrorListRef ArrayVariable::Validate(
 					auto base_type_specifier =
 							base_type_specifier_result.GetData();
 					auto base_type_result = base_type_specifier->GetType(
-							context->GetTypeTable());
+							*context->GetTypeTable());
 
 					errors = base_type_result->GetErrors();
 					if (ErrorList::IsTerminator(errors)) {
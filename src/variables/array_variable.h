@@ -59,6 +59,14 @@ public:
 			const_shared_ptr<Expression> expression,
 			const AssignmentType op) const;
 
+	const_shared_ptr<Variable> GetBaseVariable() const {
+		return m_base_variable;
+	}
+
+	const_shared_ptr<Expression> GetExpression() const {
+		return m_expression;
+	}
+
 protected:
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
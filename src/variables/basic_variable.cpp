@@ -75,7 +75,8 @@ const_shared_ptr<Result> BasicVariable::Evaluate(
 		const shared_ptr<ExecutionContext> context) const {
 	ErrorListRef errors = ErrorList::GetTerminator();
 
-	const_shared_ptr<Symbol> symbol = context->GetSymbol(GetName(), DEEP);
+	const_shared_ptr<Symbol> symbol = context->GetSymbol(*GetName(),
+			m_address);
 	auto result_symbol = Symbol::GetDefaultSymbol();
 
 	if (symbol && symbol != Symbol::GetDefaultSymbol()) {
@@ -87,7 +88,7 @@ const_shared_ptr<Result> BasicVariable::Evaluate(
 	}
 
 	const_shared_ptr<Result> result = make_shared<Result>(
-			result_symbol ? result_symbol->GetValue() : nullptr, errors);
+			result_symbol ? result_symbol->GetTaggedValue() : Value(), errors);
 	return result;
 }
 
@@ -108,79 +109,87 @@ const ErrorListRef BasicVariable::AssignValue(
 	//TODO: clean up this horrific casting logic
 	auto variable_name = GetName();
 
-	auto symbol = output_context->GetSymbol(variable_name, DEEP);
+	auto symbol = output_context->GetSymbol(*variable_name, m_address);
 	assert(symbol != Symbol::GetDefaultSymbol());
 
 	auto symbol_type_specifier = symbol->GetTypeSpecifier();
 
 	auto symbol_type_result = symbol_type_specifier->GetType(
-			output_context->GetTypeTable(), RESOLVE);
+			*output_context->GetTypeTable(), RESOLVE);
 	auto errors = symbol_type_result->GetErrors();
 	if (!ErrorList::IsTerminator(errors)) {
 		return errors;
 	}
 
 	auto symbol_type = symbol_type_result->GetData<TypeDefinition>();
-	auto symbol_value = symbol->GetValue();
 
 	const_shared_ptr<PrimitiveType> as_primitive = dynamic_pointer_cast<
 			const PrimitiveType>(symbol_type);
 	if (as_primitive) {
+		// only primitives read the old value; anything else may be a weakened
+		// reference whose value has already been released
+		auto symbol_value = symbol->GetTaggedValue();
 		const BasicType basic_type = as_primitive->GetType();
 		switch (basic_type) {
 		case BOOLEAN: {
 			const_shared_ptr<Result> result = AssignmentStatement::do_op(
 					variable_name, basic_type, GetLocation().begin,
-					*(static_pointer_cast<const bool>(symbol_value)), expression,
-					op, context);
+					symbol_value.As<bool>(), expression, op, context);
 
 			errors = result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
-				errors = SetSymbol(output_context, result->GetData<bool>());
+				//boolean operations are computed as ints
+				errors = SetValue(output_context,
+						PrimitiveTypeSpecifier::GetBoolean(),
+						Value(result->GetTaggedValue().As<int>() != 0));
 			}
 			break;
 		}
 		case BYTE: {
 			const_shared_ptr<Result> result = AssignmentStatement::do_op(
 					variable_name, basic_type, GetLocation().begin,
-					*(static_pointer_cast<const std::uint8_t>(symbol_value)),
+					symbol_value.As<std::uint8_t>(),
 					expression, op, context);
 			errors = result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
-				errors = SetSymbol(output_context,
-						result->GetData<std::uint8_t>());
+				errors = SetValue(output_context,
+						PrimitiveTypeSpecifier::GetByte(),
+						result->GetTaggedValue());
 			}
 			break;
 		}
 		case INT: {
 			const_shared_ptr<Result> result = AssignmentStatement::do_op(
 					variable_name, basic_type, GetLocation().begin,
-					*(static_pointer_cast<const int>(symbol_value)), expression,
-					op, context);
+					symbol_value.As<int>(), expression, op, context);
 
 			errors = result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
-				errors = SetSymbol(output_context, result->GetData<int>());
+				errors = SetValue(output_context,
+						PrimitiveTypeSpecifier::GetInt(),
+						result->GetTaggedValue());
 			}
 			break;
 		}
 		case DOUBLE: {
 			const_shared_ptr<Result> result = AssignmentStatement::do_op(
 					variable_name, basic_type, GetLocation().begin,
-					*(static_pointer_cast<const double>(symbol_value)),
+					symbol_value.As<double>(),
 					expression, op, context);
 
 			errors = result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
-				errors = SetSymbol(output_context, result->GetData<double>());
+				errors = SetValue(output_context,
+						PrimitiveTypeSpecifier::GetDouble(),
+						result->GetTaggedValue());
 			}
 			break;
 		}
 		case STRING: {
 			const_shared_ptr<Result> result = AssignmentStatement::do_op(
 					variable_name, basic_type, GetLocation().begin,
-					static_pointer_cast<const string>(symbol_value), expression,
-					op, context);
+					static_pointer_cast<const string>(symbol_value.ToPointer()),
+					expression, op, context);
 			errors = result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
 				errors = SetSymbol(output_context, result->GetData<string>());
@@ -299,7 +308,7 @@ const ErrorListRef BasicVariable::AssignValue(
 					auto assignment_analysis =
 							expression_type_specifier->AnalyzeAssignmentTo(
 									symbol_type_specifier,
-									context->GetTypeTable());
+									*context->GetTypeTable());
 
 					if (assignment_analysis == EQUIVALENT) {
 						new_sum = expression_evaluation->GetData<Sum>();
@@ -308,12 +317,13 @@ const ErrorListRef BasicVariable::AssignValue(
 								expression_evaluation->GetRawData();
 						if (expression_type_specifier->AnalyzeAssignmentTo(
 								TypeTable::GetNilTypeSpecifier(),
-								context->GetTypeTable()) == EQUIVALENT) {
+								*context->GetTypeTable()) == EQUIVALENT) {
 							new_sum = make_shared<Sum>(TypeTable::GetNilName(),
-									data);
+									TypeTable::GetNilTagId(), data);
 						} else {
 							new_sum = make_shared<Sum>(
-									MaybeTypeSpecifier::VARIANT_NAME, data);
+									MaybeTypeSpecifier::VARIANT_NAME,
+									MaybeTypeSpecifier::VARIANT_TAG_ID, data);
 						}
 					} else if (assignment_analysis == UNAMBIGUOUS_NESTED) {
 						//do the requisite widening
@@ -322,7 +332,7 @@ const ErrorListRef BasicVariable::AssignValue(
 						auto base_type_specifier =
 								as_maybe->GetBaseTypeSpecifier();
 						auto base_type_result = base_type_specifier->GetType(
-								context->GetTypeTable(), RESOLVE);
+								*context->GetTypeTable(), RESOLVE);
 
 						auto base_type_errors = base_type_result->GetErrors();
 						if (ErrorList::IsTerminator(base_type_errors)) {
@@ -340,14 +350,16 @@ const ErrorListRef BasicVariable::AssignValue(
 												*sum_type_specifier,
 												*expression_type_specifier);
 								assert(*base_tag != "");
-								data = make_shared<Sum>(base_tag, data);
+								data = make_shared<Sum>(base_tag,
+										base_as_sum->GetTagId(*base_tag), data);
 							} else {
 								//TODO: generalize this widening conversion process to more than sum types
 								assert(false);
 							}
 
 							new_sum = make_shared<Sum>(
-									MaybeTypeSpecifier::VARIANT_NAME, data);
+									MaybeTypeSpecifier::VARIANT_NAME,
+									MaybeTypeSpecifier::VARIANT_TAG_ID, data);
 						} else {
 							errors = ErrorList::Concatenate(errors,
 									base_type_errors);
@@ -383,7 +395,7 @@ const ErrorListRef BasicVariable::AssignValue(
 							//look up the symbol type in the _source_ context instead of the output context
 							auto symbol_type_outside_result =
 									symbol_type_specifier->GetType(
-											context->GetTypeTable(), RESOLVE);
+											*context->GetTypeTable(), RESOLVE);
 
 							if (!ErrorList::IsTerminator(
 									symbol_type_outside_result->GetErrors())) {
@@ -398,7 +410,7 @@ const ErrorListRef BasicVariable::AssignValue(
 						auto assignment_analysis =
 								expression_type_specifier->AnalyzeAssignmentTo(
 										fully_qualified_symbol_type_specifier,
-										output_context->GetTypeTable());
+										*output_context->GetTypeTable());
 						if (assignment_analysis == EQUIVALENT) {
 							new_sum = expression_evaluation->GetData<Sum>();
 						} else if (assignment_analysis == UNAMBIGUOUS) {
@@ -406,6 +418,7 @@ const ErrorListRef BasicVariable::AssignValue(
 									*fully_qualified_symbol_type_specifier,
 									*expression_type_specifier);
 							new_sum = make_shared<Sum>(tag,
+									as_sum->GetTagId(*tag),
 									expression_evaluation->GetRawData());
 						} else {
 							errors =
@@ -433,12 +446,22 @@ const ErrorListRef BasicVariable::AssignValue(
 	return errors;
 }
 
+const ErrorListRef BasicVariable::SetValue(
+		const shared_ptr<ExecutionContext> context,
+		const_shared_ptr<TypeSpecifier> type, const Value& value) const {
+	auto symbol = context->GetSymbol(*GetName(), m_address);
+	return ToErrorListRef(
+			context->SetSymbol(*GetName(), type, value,
+					*context->GetTypeTable()), symbol->GetTypeSpecifier(),
+			type);
+}
+
 const ErrorListRef BasicVariable::SetSymbol(
 		const shared_ptr<ExecutionContext> context,
 		const_shared_ptr<bool> value) const {
 	auto symbol = context->GetSymbol(*GetName(), DEEP);
 	return ToErrorListRef(
-			context->SetSymbol(*GetName(), value, context->GetTypeTable()),
+			context->SetSymbol(*GetName(), value, *context->GetTypeTable()),
 			symbol->GetTypeSpecifier(), PrimitiveTypeSpecifier::GetBoolean());
 }
 
@@ -447,7 +470,7 @@ const ErrorListRef BasicVariable::SetSymbol(
 		const_shared_ptr<std::uint8_t> value) const {
 	auto symbol = context->GetSymbol(*GetName(), DEEP);
 	return ToErrorListRef(
-			context->SetSymbol(*GetName(), value, context->GetTypeTable()),
+			context->SetSymbol(*GetName(), value, *context->GetTypeTable()),
 			symbol->GetTypeSpecifier(), PrimitiveTypeSpecifier::GetByte());
 }
 
@@ -456,7 +479,7 @@ const ErrorListRef BasicVariable::SetSymbol(
 		const_shared_ptr<int> value) const {
 	auto symbol = context->GetSymbol(*GetName(), DEEP);
 	return ToErrorListRef(
-			context->SetSymbol(*GetName(), value, context->GetTypeTable()),
+			context->SetSymbol(*GetName(), value, *context->GetTypeTable()),
 			symbol->GetTypeSpecifier(), PrimitiveTypeSpecifier::GetInt());
 }
 
@@ -465,7 +488,7 @@ const ErrorListRef BasicVariable::SetSymbol(
 		const_shared_ptr<double> value) const {
 	auto symbol = context->GetSymbol(*GetName(), DEEP);
 	return ToErrorListRef(
-			context->SetSymbol(*GetName(), value, context->GetTypeTable()),
+			context->SetSymbol(*GetName(), value, *context->GetTypeTable()),
 			symbol->GetTypeSpecifier(), PrimitiveTypeSpecifier::GetDouble());
 }
 
@@ -474,7 +497,7 @@ const ErrorListRef BasicVariable::SetSymbol(
 		const_shared_ptr<string> value) const {
 	auto symbol = context->GetSymbol(*GetName(), DEEP);
 	return ToErrorListRef(
-			context->SetSymbol(*GetName(), value, context->GetTypeTable()),
+			context->SetSymbol(*GetName(), value, *context->GetTypeTable()),
 			symbol->GetTypeSpecifier(), PrimitiveTypeSpecifier::GetString());
 }
 
@@ -483,7 +506,7 @@ const ErrorListRef BasicVariable::SetSymbol(
 		const_shared_ptr<Array> value) const {
 	auto symbol = context->GetSymbol(*GetName(), DEEP);
 	return ToErrorListRef(
-			context->SetSymbol(*GetName(), value, context->GetTypeTable()),
+			context->SetSymbol(*GetName(), value, *context->GetTypeTable()),
 			symbol->GetTypeSpecifier(), value->GetTypeSpecifier());
 }
 
@@ -494,7 +517,7 @@ const ErrorListRef BasicVariable::SetSymbol(
 	auto symbol = context->GetSymbol(*GetName(), DEEP);
 	return ToErrorListRef(
 			context->SetSymbol(*GetName(), type, value,
-					context->GetTypeTable()), symbol->GetTypeSpecifier(), type);
+					*context->GetTypeTable()), symbol->GetTypeSpecifier(), type);
 }
 
 const ErrorListRef BasicVariable::SetSymbol(
@@ -504,7 +527,7 @@ const ErrorListRef BasicVariable::SetSymbol(
 	auto symbol = context->GetSymbol(*GetName(), DEEP);
 	return ToErrorListRef(
 			context->SetSymbol(*GetName(), type, value,
-					context->GetTypeTable()), symbol->GetTypeSpecifier(), type);
+					*context->GetTypeTable()), symbol->GetTypeSpecifier(), type);
 }
 
 const ErrorListRef BasicVariable::SetSymbol(
@@ -512,7 +535,7 @@ const ErrorListRef BasicVariable::SetSymbol(
 		const_shared_ptr<Function> value) const {
 	auto symbol = context->GetSymbol(*GetName(), DEEP);
 	return ToErrorListRef(
-			context->SetSymbol(*GetName(), value, context->GetTypeTable()),
+			context->SetSymbol(*GetName(), value, *context->GetTypeTable()),
 			symbol->GetTypeSpecifier(), value->GetTypeSpecifier());
 }
 
@@ -523,7 +546,7 @@ const ErrorListRef BasicVariable::SetSymbol(
 	auto symbol = context->GetSymbol(*GetName(), DEEP);
 	return ToErrorListRef(
 			context->SetSymbol(*GetName(), type, value,
-					context->GetTypeTable()), symbol->GetTypeSpecifier(), type);
+					*context->GetTypeTable()), symbol->GetTypeSpecifier(), type);
 }
 
 const_shared_ptr<Variable> BasicVariable::GetDefaultVariable() {
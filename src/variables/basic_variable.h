@@ -22,6 +22,9 @@
 
 #include <variable.h>
 #include <assignment_type.h>
+#include <lexical_address.h>
+
+class Value;
 
 class BasicVariable: public Variable {
 public:
@@ -106,7 +109,17 @@ protected:
 			const_shared_ptr<Function> value) const;
 
 private:
+	const ErrorListRef SetValue(const shared_ptr<ExecutionContext> context,
+			const_shared_ptr<TypeSpecifier> type, const Value& value) const;
+
 	const NamespaceQualifierListRef m_space;
+
+	/**
+	 * Where this variable was last found. Blocks assign declarations to slots
+	 * when they are preprocessed, and runtime copies of a block keep those
+	 * slots, so the address stays valid across evaluations.
+	 */
+	mutable LexicalAddress m_address;
 };
 
 #endif /* VARIABLES_BASIC_VARIABLE_H_ */
@@ -27,11 +27,13 @@
 #include <nested_type_specifier.h>
 #include <sum_type.h>
 #include <unit_type.h>
+#include <basic_variable.h>
 
 MemberVariable::MemberVariable(const_shared_ptr<Variable> container,
 		const_shared_ptr<Variable> member_variable) :
 		Variable(container->GetName(), container->GetLocation()), m_container(
-				container), m_member_variable(member_variable) {
+				container), m_member_variable(member_variable), m_member_slot(
+				SymbolMap::NO_SLOT) {
 }
 
 MemberVariable::~MemberVariable() {
@@ -133,6 +135,29 @@ const_shared_ptr<Result> MemberVariable::Evaluate(
 		const shared_ptr<ExecutionContext> context) const {
 	ErrorListRef errors(ErrorList::GetTerminator());
 
+	if (m_member_slot != SymbolMap::NO_SLOT) {
+		// the container is known to be a record; read the member by slot
+		const_shared_ptr<Result> container_result = m_container->Evaluate(
+				context);
+
+		errors = container_result->GetErrors();
+		if (ErrorList::IsTerminator(errors)) {
+			auto definition =
+					container_result->GetData<Record>()->GetDefinition();
+			auto symbol = definition->GetSymbol(m_member_slot,
+					*m_member_variable->GetName());
+			if (symbol) {
+				return make_shared<Result>(symbol->GetTaggedValue(), errors);
+			}
+
+			// the instance was not built from its type's layout
+			auto new_context = context->WithContents(definition);
+			return m_member_variable->Evaluate(new_context);
+		}
+
+		return make_shared<Result>(const_shared_ptr<void>(nullptr), errors);
+	}
+
 	auto container_type_specifier_result = m_container->GetTypeSpecifier(
 			context);
 
@@ -204,7 +229,7 @@ const ErrorListRef MemberVariable::SetSymbol(
 				auto instance = container_result->GetData<Record>();
 				const std::string member_name = *(m_member_variable->GetName());
 				set_result = instance->GetDefinition()->SetSymbol(member_name,
-						value, context->GetTypeTable());
+						value, *context->GetTypeTable());
 			} else {
 				set_result = INCOMPATIBLE_TYPE;
 			}
@@ -247,7 +272,7 @@ const ErrorListRef MemberVariable::SetSymbol(
 				auto instance = container_result->GetData<Record>();
 				const std::string member_name = *(m_member_variable->GetName());
 				set_result = instance->GetDefinition()->SetSymbol(member_name,
-						value, context->GetTypeTable());
+						value, *context->GetTypeTable());
 			} else {
 				set_result = INCOMPATIBLE_TYPE;
 			}
@@ -290,7 +315,7 @@ const ErrorListRef MemberVariable::SetSymbol(
 				auto instance = container_result->GetData<Record>();
 				const std::string member_name = *(m_member_variable->GetName());
 				set_result = instance->GetDefinition()->SetSymbol(member_name,
-						value, context->GetTypeTable());
+						value, *context->GetTypeTable());
 			} else {
 				set_result = INCOMPATIBLE_TYPE;
 			}
@@ -333,7 +358,7 @@ const ErrorListRef MemberVariable::SetSymbol(
 				auto instance = container_result->GetData<Record>();
 				const std::string member_name = *(m_member_variable->GetName());
 				set_result = instance->GetDefinition()->SetSymbol(member_name,
-						value, context->GetTypeTable());
+						value, *context->GetTypeTable());
 			} else {
 				set_result = INCOMPATIBLE_TYPE;
 			}
@@ -419,7 +444,7 @@ const ErrorListRef MemberVariable::SetSymbol(
 				auto instance = container_result->GetData<Record>();
 				const std::string member_name = *(m_member_variable->GetName());
 				set_result = instance->GetDefinition()->SetSymbol(member_name,
-						type, value, context->GetTypeTable());
+						type, value, *context->GetTypeTable());
 			} else {
 				set_result = INCOMPATIBLE_TYPE;
 			}
@@ -463,7 +488,7 @@ const ErrorListRef MemberVariable::SetSymbol(
 				auto instance = container_result->GetData<Record>();
 				const std::string member_name = *(m_member_variable->GetName());
 				set_result = instance->GetDefinition()->SetSymbol(member_name,
-						value, context->GetTypeTable());
+						value, *context->GetTypeTable());
 			} else {
 				set_result = INCOMPATIBLE_TYPE;
 			}
@@ -505,7 +530,7 @@ const ErrorListRef MemberVariable::Validate(
 					container_type_specifier_result.GetData();
 
 			auto container_type_result = container_type_specifier->GetType(
-					context->GetTypeTable(), RESOLVE);
+					*context->GetTypeTable(), RESOLVE);
 
 			errors = container_type_result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
@@ -524,6 +549,15 @@ const ErrorListRef MemberVariable::Validate(
 										*m_member_variable->ToString(context),
 										container_type_specifier->ToString()),
 								errors);
+					} else {
+						auto as_record = dynamic_pointer_cast<
+								const RecordType>(type);
+						if (as_record
+								&& dynamic_pointer_cast<const BasicVariable>(
+										m_member_variable)) {
+							m_member_slot = as_record->GetSlot(
+									*m_member_variable->GetName());
+						}
 					}
 				} else {
 					errors = ErrorList::From(
@@ -22,6 +22,7 @@
 
 #include <variable.h>
 #include <assignment_type.h>
+#include <symbol_map.h>
 
 class MemberVariable: public Variable {
 public:
@@ -85,6 +86,12 @@ protected:
 private:
 	const_shared_ptr<Variable> m_container;
 	const_shared_ptr<Variable> m_member_variable;
+
+	/**
+	 * The member's slot in the container's record layout, resolved during
+	 * validation. NO_SLOT if the container is not a record.
+	 */
+	mutable size_t m_member_slot;
 };
 
 #endif /* MEMBER_VARIABLE_H_ */
@@ -0,0 +1,332 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <virtual_machine.h>
+#include <execution_context.h>
+#include <primitive_type_specifier.h>
+#include <expression.h>
+#include <print_statement.h>
+
+ExecutionEngine EXECUTION_ENGINE = TREE_WALKER;
+
+const bool VirtualMachine::CanExecute(const Bytecode& bytecode,
+		const shared_ptr<ExecutionContext> context) {
+	for (auto & binding : bytecode.GetBindings()) {
+		auto symbol = context->GetSymbol(binding.name, DEEP);
+		if (!symbol || symbol == Symbol::GetDefaultSymbol()) {
+			return false;
+		}
+
+		auto type_specifier = dynamic_pointer_cast<
+				const PrimitiveTypeSpecifier>(symbol->GetTypeSpecifier());
+		if (!type_specifier || type_specifier->GetBasicType() != binding.type) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const ExecutionResult VirtualMachine::Execute(const Bytecode& bytecode,
+		const shared_ptr<ExecutionContext> context) {
+	vector<Register> registers(bytecode.GetRegisterCount());
+	Register* r = registers.data();
+	const Register* constants = bytecode.GetConstants().data();
+	const Instruction* code = bytecode.GetInstructions().data();
+
+	auto & bindings = bytecode.GetBindings();
+	for (auto & binding : bindings) {
+		auto value = context->GetSymbol(binding.name, DEEP)->GetTaggedValue();
+		switch (binding.type) {
+		case BOOLEAN:
+			r[binding.target].as_bool = value.As<bool>();
+			break;
+		case INT:
+			r[binding.target].as_int = value.As<int>();
+			break;
+		case DOUBLE:
+			r[binding.target].as_double = value.As<double>();
+			break;
+		default:
+			assert(false);
+		}
+	}
+
+	auto errors = ErrorList::GetTerminator();
+	size_t pc = 0;
+	const Instruction* i;
+
+	// GCC and clang support labels as values: each handler jumps straight to
+	// the next one through a table, rather than back to a shared switch.
+#if defined(__GNUC__)
+	static const void* const dispatch_table[] = {
+			&&LOAD_CONSTANT_TARGET,
+			&&MOVE_TARGET,
+			&&BOOL_TO_INT_TARGET,
+			&&BOOL_TO_DOUBLE_TARGET,
+			&&INT_TO_BOOL_TARGET,
+			&&INT_TO_DOUBLE_TARGET,
+			&&DOUBLE_TO_BOOL_TARGET,
+			&&INT_ADD_TARGET,
+			&&INT_SUBTRACT_TARGET,
+			&&INT_MULTIPLY_TARGET,
+			&&INT_DIVIDE_TARGET,
+			&&INT_MOD_TARGET,
+			&&INT_NEGATE_TARGET,
+			&&DOUBLE_ADD_TARGET,
+			&&DOUBLE_SUBTRACT_TARGET,
+			&&DOUBLE_MULTIPLY_TARGET,
+			&&DOUBLE_DIVIDE_TARGET,
+			&&DOUBLE_NEGATE_TARGET,
+			&&BOOL_EQUAL_TARGET,
+			&&BOOL_NOT_EQUAL_TARGET,
+			&&BOOL_AND_TARGET,
+			&&BOOL_OR_TARGET,
+			&&BOOL_NOT_TARGET,
+			&&INT_EQUAL_TARGET,
+			&&INT_NOT_EQUAL_TARGET,
+			&&INT_LESS_THAN_TARGET,
+			&&INT_LESS_THAN_EQUAL_TARGET,
+			&&INT_GREATER_THAN_TARGET,
+			&&INT_GREATER_THAN_EQUAL_TARGET,
+			&&DOUBLE_EQUAL_TARGET,
+			&&DOUBLE_NOT_EQUAL_TARGET,
+			&&DOUBLE_LESS_THAN_TARGET,
+			&&DOUBLE_LESS_THAN_EQUAL_TARGET,
+			&&DOUBLE_GREATER_THAN_TARGET,
+			&&DOUBLE_GREATER_THAN_EQUAL_TARGET,
+			&&JUMP_TARGET,
+			&&JUMP_IF_FALSE_TARGET,
+			&&JUMP_IF_TRUE_TARGET,
+			&&PRINT_BOOL_TARGET,
+			&&PRINT_INT_TARGET,
+			&&PRINT_DOUBLE_TARGET,
+			&&PRINT_STRING_TARGET,
+			&&HALT_TARGET };
+	static_assert(
+			sizeof(dispatch_table) / sizeof(dispatch_table[0]) == HALT + 1,
+			"the dispatch table must have one entry per opcode");
+
+#define TARGET(op) op##_TARGET: case op
+#define DISPATCH() { i = &code[pc++]; goto *dispatch_table[i->op]; }
+#else
+#define TARGET(op) case op
+#define DISPATCH() continue
+#endif
+
+	for (;;) {
+		i = &code[pc++];
+		switch (i->op) {
+		TARGET(LOAD_CONSTANT):
+			r[i->a] = constants[i->b];
+			DISPATCH();
+		TARGET(MOVE):
+			r[i->a] = r[i->b];
+			DISPATCH();
+
+		TARGET(BOOL_TO_INT):
+			r[i->a].as_int = r[i->b].as_bool;
+			DISPATCH();
+		TARGET(BOOL_TO_DOUBLE):
+			r[i->a].as_double = r[i->b].as_bool;
+			DISPATCH();
+		TARGET(INT_TO_BOOL):
+			r[i->a].as_bool = r[i->b].as_int;
+			DISPATCH();
+		TARGET(INT_TO_DOUBLE):
+			r[i->a].as_double = r[i->b].as_int;
+			DISPATCH();
+		TARGET(DOUBLE_TO_BOOL):
+			r[i->a].as_bool = r[i->b].as_double;
+			DISPATCH();
+
+		TARGET(INT_ADD):
+			r[i->a].as_int = r[i->b].as_int + r[i->c].as_int;
+			DISPATCH();
+		TARGET(INT_SUBTRACT):
+			r[i->a].as_int = r[i->b].as_int - r[i->c].as_int;
+			DISPATCH();
+		TARGET(INT_MULTIPLY):
+			r[i->a].as_int = r[i->b].as_int * r[i->c].as_int;
+			DISPATCH();
+		TARGET(INT_DIVIDE):
+			if (r[i->c].as_int == 0) {
+				goto division_by_zero;
+			}
+			r[i->a].as_int = r[i->b].as_int / r[i->c].as_int;
+			DISPATCH();
+		TARGET(INT_MOD):
+			if (r[i->c].as_int == 0) {
+				goto division_by_zero;
+			}
+			r[i->a].as_int = r[i->b].as_int % r[i->c].as_int;
+			DISPATCH();
+		TARGET(INT_NEGATE):
+			r[i->a].as_int = -r[i->b].as_int;
+			DISPATCH();
+		TARGET(DOUBLE_ADD):
+			r[i->a].as_double = r[i->b].as_double + r[i->c].as_double;
+			DISPATCH();
+		TARGET(DOUBLE_SUBTRACT):
+			r[i->a].as_double = r[i->b].as_double - r[i->c].as_double;
+			DISPATCH();
+		TARGET(DOUBLE_MULTIPLY):
+			r[i->a].as_double = r[i->b].as_double * r[i->c].as_double;
+			DISPATCH();
+		TARGET(DOUBLE_DIVIDE):
+			if (r[i->c].as_double == 0.0) {
+				goto division_by_zero;
+			}
+			r[i->a].as_double = r[i->b].as_double / r[i->c].as_double;
+			DISPATCH();
+		TARGET(DOUBLE_NEGATE):
+			r[i->a].as_double = -r[i->b].as_double;
+			DISPATCH();
+
+		TARGET(BOOL_EQUAL):
+			r[i->a].as_bool = r[i->b].as_bool == r[i->c].as_bool;
+			DISPATCH();
+		TARGET(BOOL_NOT_EQUAL):
+			r[i->a].as_bool = r[i->b].as_bool != r[i->c].as_bool;
+			DISPATCH();
+		TARGET(BOOL_AND):
+			r[i->a].as_bool = r[i->b].as_bool && r[i->c].as_bool;
+			DISPATCH();
+		TARGET(BOOL_OR):
+			r[i->a].as_bool = r[i->b].as_bool || r[i->c].as_bool;
+			DISPATCH();
+		TARGET(BOOL_NOT):
+			r[i->a].as_bool = !r[i->b].as_bool;
+			DISPATCH();
+		TARGET(INT_EQUAL):
+			r[i->a].as_bool = r[i->b].as_int == r[i->c].as_int;
+			DISPATCH();
+		TARGET(INT_NOT_EQUAL):
+			r[i->a].as_bool = r[i->b].as_int != r[i->c].as_int;
+			DISPATCH();
+		TARGET(INT_LESS_THAN):
+			r[i->a].as_bool = r[i->b].as_int < r[i->c].as_int;
+			DISPATCH();
+		TARGET(INT_LESS_THAN_EQUAL):
+			r[i->a].as_bool = r[i->b].as_int <= r[i->c].as_int;
+			DISPATCH();
+		TARGET(INT_GREATER_THAN):
+			r[i->a].as_bool = r[i->b].as_int > r[i->c].as_int;
+			DISPATCH();
+		TARGET(INT_GREATER_THAN_EQUAL):
+			r[i->a].as_bool = r[i->b].as_int >= r[i->c].as_int;
+			DISPATCH();
+		TARGET(DOUBLE_EQUAL):
+			r[i->a].as_bool = r[i->b].as_double == r[i->c].as_double;
+			DISPATCH();
+		TARGET(DOUBLE_NOT_EQUAL):
+			r[i->a].as_bool = r[i->b].as_double != r[i->c].as_double;
+			DISPATCH();
+		TARGET(DOUBLE_LESS_THAN):
+			r[i->a].as_bool = r[i->b].as_double < r[i->c].as_double;
+			DISPATCH();
+		TARGET(DOUBLE_LESS_THAN_EQUAL):
+			r[i->a].as_bool = r[i->b].as_double <= r[i->c].as_double;
+			DISPATCH();
+		TARGET(DOUBLE_GREATER_THAN):
+			r[i->a].as_bool = r[i->b].as_double > r[i->c].as_double;
+			DISPATCH();
+		TARGET(DOUBLE_GREATER_THAN_EQUAL):
+			r[i->a].as_bool = r[i->b].as_double >= r[i->c].as_double;
+			DISPATCH();
+
+		TARGET(JUMP):
+			pc = i->a;
+			DISPATCH();
+		TARGET(JUMP_IF_FALSE):
+			if (!r[i->a].as_bool) {
+				pc = i->b;
+			}
+			DISPATCH();
+		TARGET(JUMP_IF_TRUE):
+			if (r[i->a].as_bool) {
+				pc = i->b;
+			}
+			DISPATCH();
+
+		TARGET(PRINT_BOOL):
+			PrintStatement::Print(
+					Expression::ToString(BOOLEAN, Value(r[i->a].as_bool)));
+			DISPATCH();
+		TARGET(PRINT_INT):
+			PrintStatement::Print(
+					Expression::ToString(INT, Value(r[i->a].as_int)));
+			DISPATCH();
+		TARGET(PRINT_DOUBLE):
+			PrintStatement::Print(
+					Expression::ToString(DOUBLE, Value(r[i->a].as_double)));
+			DISPATCH();
+		TARGET(PRINT_STRING):
+			PrintStatement::Print(bytecode.GetStrings()[i->a]);
+			DISPATCH();
+
+		TARGET(HALT):
+			goto halt;
+		}
+
+		// a handler failed a division by zero check
+		division_by_zero: {
+			auto site = bytecode.GetErrorSite(pc - 1);
+			if (site.handler < 0) {
+				errors = ErrorList::From(
+						make_shared<Error>(Error::SEMANTIC, site.code,
+								site.position), errors);
+				goto halt;
+			}
+			pc = site.handler;
+		}
+	}
+
+halt:
+#undef TARGET
+#undef DISPATCH
+
+	auto type_table = context->GetTypeTable();
+	for (auto & binding : bindings) {
+		if (!binding.written) {
+			continue;
+		}
+
+		switch (binding.type) {
+		case BOOLEAN:
+			context->SetSymbol(binding.name,
+					PrimitiveTypeSpecifier::GetBoolean(),
+					Value(r[binding.target].as_bool), *type_table);
+			break;
+		case INT:
+			context->SetSymbol(binding.name, PrimitiveTypeSpecifier::GetInt(),
+					Value(r[binding.target].as_int), *type_table);
+			break;
+		case DOUBLE:
+			context->SetSymbol(binding.name,
+					PrimitiveTypeSpecifier::GetDouble(),
+					Value(r[binding.target].as_double), *type_table);
+			break;
+		default:
+			assert(false);
+		}
+	}
+
+	return ExecutionResult(errors);
+}
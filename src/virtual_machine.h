@@ -0,0 +1,54 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIRTUAL_MACHINE_H_
+#define VIRTUAL_MACHINE_H_
+
+#include <bytecode.h>
+#include <result.h>
+
+class ExecutionContext;
+
+enum ExecutionEngine {
+	TREE_WALKER, VIRTUAL_MACHINE
+};
+
+extern ExecutionEngine EXECUTION_ENGINE;
+
+class VirtualMachine {
+public:
+	/**
+	 * Execute compiled bytecode. Bound variables are read from the given context
+	 * before execution begins, and any that were assigned are written back
+	 * before returning, whether or not execution completed successfully.
+	 */
+	static const ExecutionResult Execute(const Bytecode& bytecode,
+			const shared_ptr<ExecutionContext> context);
+
+	/**
+	 * True if every variable bound by the bytecode resolves in the given
+	 * context to a symbol of the type it was compiled against. Bytecode is
+	 * compiled for the first context its statement runs in, so it must be
+	 * checked before it is reused in another.
+	 */
+	static const bool CanExecute(const Bytecode& bytecode,
+			const shared_ptr<ExecutionContext> context);
+};
+
+#endif /* VIRTUAL_MACHINE_H_ */
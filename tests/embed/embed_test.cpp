@@ -0,0 +1,215 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Exercises the embedding API: compile a script once, execute it repeatedly
+ * with different bindings, and check the errors reported for bad bindings,
+ * bad scripts and bad lookups, and the entries written to an import cache.
+ * Prints each failed check and exits with a non-zero status if there were any.
+ */
+
+#include <interpreter.h>
+#include <iostream>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace {
+int failures = 0;
+
+void Check(const bool condition, const string& description) {
+	if (!condition) {
+		std::cerr << "FAILED: " << description << std::endl;
+		failures++;
+	}
+}
+
+const bool HasError(ErrorListRef errors, const Error::ErrorClass error_class,
+		const Error::ErrorCode code) {
+	while (!ErrorList::IsTerminator(errors)) {
+		auto error = errors->GetData();
+		if (error->GetErrorClass() == error_class && error->GetCode() == code) {
+			return true;
+		}
+		errors = errors->GetNext();
+	}
+
+	return false;
+}
+
+const string SOURCE = "total:= 0\n"
+		"for (i:= 1; i <= n; i += 1) {\n"
+		"	total += i\n"
+		"}\n"
+		"scaled:= total * scale\n"
+		"greeting:= label + \"!\"\n"
+		"negated:= !flag\n";
+}
+
+int main() {
+	auto include_paths = make_shared<string_list>();
+	auto interpreter_result = Interpreter::Create(include_paths);
+	Check(ErrorList::IsTerminator(interpreter_result.GetErrors()),
+			"interpreter bootstraps without errors");
+	auto interpreter = interpreter_result.GetData();
+
+	Bindings declarations;
+	declarations.Set("n", 0);
+	declarations.Set("scale", 1.0);
+	declarations.Set("label", "");
+	declarations.Set("flag", false);
+
+	auto compile_result = interpreter->CompileString(SOURCE, declarations);
+	Check(ErrorList::IsTerminator(compile_result.GetErrors()),
+			"script compiles without errors");
+	auto program = compile_result.GetData();
+	if (!program) {
+		return EXIT_FAILURE;
+	}
+
+	// the declared values are used when nothing is bound
+	auto defaults = program->Execute();
+	Check(ErrorList::IsTerminator(defaults->GetErrors()),
+			"default execution succeeds");
+	Check(defaults->GetInt("total") && *defaults->GetInt("total") == 0,
+			"default total is 0");
+	Check(defaults->GetString("greeting")
+			&& *defaults->GetString("greeting") == "!",
+			"default greeting is \"!\"");
+
+	// executions are independent of one another
+	for (int n = 1; n <= 3; n++) {
+		Bindings inputs;
+		inputs.Set("n", n * 10);
+		inputs.Set("scale", 0.5 * n);
+		inputs.Set("label", "run " + std::to_string(n));
+		inputs.Set("flag", n % 2 == 0);
+
+		auto execution = program->Execute(inputs);
+		auto expected_total = n * 10 * (n * 10 + 1) / 2;
+		auto run = " (run " + std::to_string(n) + ")";
+		Check(ErrorList::IsTerminator(execution->GetErrors()),
+				"execution succeeds" + run);
+		Check(!execution->GetExitCode(), "execution does not exit" + run);
+		Check(execution->GetInt("total")
+				&& *execution->GetInt("total") == expected_total,
+				"total is the sum of 1..n" + run);
+		Check(execution->GetDouble("scaled")
+				&& *execution->GetDouble("scaled")
+						== expected_total * 0.5 * n,
+				"scaled is total * scale" + run);
+		Check(execution->GetString("greeting")
+				&& *execution->GetString("greeting")
+						== "run " + std::to_string(n) + "!",
+				"greeting appends to the label" + run);
+		Check(execution->GetBoolean("negated")
+				&& *execution->GetBoolean("negated") == (n % 2 != 0),
+				"negated inverts the flag" + run);
+	}
+
+	// lookups of missing names, or with the wrong type, find nothing
+	Check(!defaults->GetInt("missing"), "missing names are not found");
+	Check(!defaults->GetInt("scaled"), "values are only read as their type");
+
+	// binding errors are reported, and the script does not run
+	Bindings undeclared;
+	undeclared.Set("m", 1);
+	auto undeclared_execution = program->Execute(undeclared);
+	Check(HasError(undeclared_execution->GetErrors(), Error::SEMANTIC,
+			Error::UNDECLARED_VARIABLE),
+			"binding an undeclared name is an error");
+	Check(!undeclared_execution->GetInt("total")
+			|| *undeclared_execution->GetInt("total") == 0,
+			"a failed binding does not run the script");
+
+	Bindings mistyped;
+	mistyped.Set("n", "ten");
+	auto mistyped_execution = program->Execute(mistyped);
+	Check(HasError(mistyped_execution->GetErrors(), Error::SEMANTIC,
+			Error::ASSIGNMENT_TYPE_ERROR),
+			"binding a value of the wrong type is an error");
+
+	// compilation errors
+	auto parse_result = interpreter->CompileString("total:= \n");
+	Check(!parse_result.GetData()
+			&& HasError(parse_result.GetErrors(), Error::PARSE,
+					Error::PARSE_ERROR), "parse errors are reported");
+
+	auto semantic_result = interpreter->CompileString("total:int = \"a\"\n");
+	Check(!semantic_result.GetData()
+			&& HasError(semantic_result.GetErrors(), Error::SEMANTIC,
+					Error::INVALID_INITIALIZER_TYPE),
+			"semantic errors are reported");
+
+	// exit codes
+	auto exit_program = interpreter->CompileString("exit(3)\n").GetData();
+	Check((bool) exit_program, "exit script compiles");
+	if (exit_program) {
+		auto exit_execution = exit_program->Execute();
+		Check(exit_execution->GetExitCode()
+				&& *exit_execution->GetExitCode() == 3,
+				"exit codes are reported");
+	}
+
+	// imports are stored in the cache, and replayed by later compilations
+	char cache_template[] = "/tmp/newt_import_cache_XXXXXX";
+	auto cache_directory = mkdtemp(cache_template);
+	Check(cache_directory != nullptr, "cache directory is created");
+	if (cache_directory) {
+		auto cache = make_shared<ImportCache>(cache_directory);
+		auto import_paths = make_shared<string_list>();
+		import_paths->push_back(make_shared<const string>("../tests/includes"));
+		auto caching_interpreter = Interpreter::Create(import_paths, NO_TRACE,
+				cache).GetData();
+
+		for (int compilation = 1; compilation <= 2; compilation++) {
+			auto importer = caching_interpreter->CompileString(
+					"import nested\nresult:= g() + i\n").GetData();
+			auto run = " (compilation " + std::to_string(compilation) + ")";
+			Check((bool) importer, "importing script compiles" + run);
+			if (importer) {
+				auto execution = importer->Execute();
+				Check(execution->GetInt("result")
+						&& *execution->GetInt("result") == 18,
+						"imported declarations are used" + run);
+			}
+		}
+
+		// nested imports get entries of their own
+		for (auto source : { "nested.nwt", "trivial.nwt" }) {
+			auto path = "../tests/includes/" + string(source);
+			auto handle = fopen(path.c_str(), "r");
+			Check(handle != nullptr, "import source " + path + " is found");
+			if (handle) {
+				auto entry_path = cache->GetEntryPath(handle);
+				fclose(handle);
+				Check(remove(entry_path.c_str()) == 0,
+						"an entry is stored for " + path);
+			}
+		}
+		rmdir(cache_directory);
+	}
+
+	if (failures > 0) {
+		std::cerr << failures << " check(s) failed." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "All embedding checks passed." << std::endl;
+	return EXIT_SUCCESS;
+}